@@ -32,6 +32,7 @@
 #include <Cajita_MpiTraits.hpp>
 #include <Cajita_Parallel.hpp>
 #include <Cajita_ParticleGridDistributor.hpp>
+#include <Cajita_ParticleGridHalo.hpp>
 #include <Cajita_ParticleInit.hpp>
 #include <Cajita_ParticleList.hpp>
 #include <Cajita_Partitioner.hpp>
@@ -55,6 +56,7 @@
 
 #ifdef Cabana_ENABLE_HEFFTE
 #include <Cajita_FastFourierTransform.hpp>
+#include <Cajita_P3MSolver.hpp>
 #endif
 
 #ifdef Cabana_ENABLE_SILO
@@ -418,76 +418,122 @@ clone( const Array<Scalar, EntityType, MeshType, Params...>& array )
 //---------------------------------------------------------------------------//
 /*!
   \brief Assign a scalar value to every element of an array.
+  \param exec_space The execution space to use.
   \param array The array to assign the value to.
   \param alpha The value to assign to the array.
   \param tag The tag for the decomposition over which to perform the operation.
 */
-template <class Array_t, class DecompositionTag>
-void assign( Array_t& array, const typename Array_t::value_type alpha,
-             DecompositionTag tag )
+template <class ExecutionSpace, class Array_t, class DecompositionTag>
+void assign( const ExecutionSpace& exec_space, Array_t& array,
+             const typename Array_t::value_type alpha, DecompositionTag tag )
 {
     static_assert( is_array<Array_t>::value, "Cajita::Array required" );
     auto subview = createSubview( array.view(),
                                   array.layout()->indexSpace( tag, Local() ) );
-    Kokkos::deep_copy( subview, alpha );
+    Kokkos::deep_copy( exec_space, subview, alpha );
+}
+
+/*!
+  \brief Assign a scalar value to every element of an array.
+  \param array The array to assign the value to.
+  \param alpha The value to assign to the array.
+  \param tag The tag for the decomposition over which to perform the operation.
+*/
+template <class Array_t, class DecompositionTag>
+void assign( Array_t& array, const typename Array_t::value_type alpha,
+             DecompositionTag tag )
+{
+    assign( typename Array_t::execution_space(), array, alpha, tag );
 }
 
 //---------------------------------------------------------------------------//
 /*!
   \brief Scale every element of an array by a scalar value. 3D specialization.
+  \param exec_space The execution space to use.
   \param array The array to scale.
   \param alpha The value to scale the array by.
   \param tag The tag for the decomposition over which to perform the operation.
 */
-template <class Array_t, class DecompositionTag>
+template <class ExecutionSpace, class Array_t, class DecompositionTag>
 std::enable_if_t<3 == Array_t::num_space_dim, void>
-scale( Array_t& array, const typename Array_t::value_type alpha,
-       DecompositionTag tag )
+scale( const ExecutionSpace& exec_space, Array_t& array,
+       const typename Array_t::value_type alpha, DecompositionTag tag )
 {
     static_assert( is_array<Array_t>::value, "Cajita::Array required" );
     auto view = array.view();
     Kokkos::parallel_for(
         "ArrayOp::scale",
         createExecutionPolicy( array.layout()->indexSpace( tag, Local() ),
-                               typename Array_t::execution_space() ),
+                               exec_space ),
         KOKKOS_LAMBDA( const int i, const int j, const int k, const int l ) {
             view( i, j, k, l ) *= alpha;
         } );
 }
 
 /*!
-  \brief Scale every element of an array by a scalar value. 2D specialization.
+  \brief Scale every element of an array by a scalar value. 3D specialization.
   \param array The array to scale.
   \param alpha The value to scale the array by.
   \param tag The tag for the decomposition over which to perform the operation.
 */
 template <class Array_t, class DecompositionTag>
-std::enable_if_t<2 == Array_t::num_space_dim, void>
+std::enable_if_t<3 == Array_t::num_space_dim, void>
 scale( Array_t& array, const typename Array_t::value_type alpha,
        DecompositionTag tag )
+{
+    scale( typename Array_t::execution_space(), array, alpha, tag );
+}
+
+/*!
+  \brief Scale every element of an array by a scalar value. 2D specialization.
+  \param exec_space The execution space to use.
+  \param array The array to scale.
+  \param alpha The value to scale the array by.
+  \param tag The tag for the decomposition over which to perform the operation.
+*/
+template <class ExecutionSpace, class Array_t, class DecompositionTag>
+std::enable_if_t<2 == Array_t::num_space_dim, void>
+scale( const ExecutionSpace& exec_space, Array_t& array,
+       const typename Array_t::value_type alpha, DecompositionTag tag )
 {
     static_assert( is_array<Array_t>::value, "Cajita::Array required" );
     auto view = array.view();
     Kokkos::parallel_for(
         "ArrayOp::scale",
         createExecutionPolicy( array.layout()->indexSpace( tag, Local() ),
-                               typename Array_t::execution_space() ),
+                               exec_space ),
         KOKKOS_LAMBDA( const int i, const int j, const int l ) {
             view( i, j, l ) *= alpha;
         } );
 }
 
+/*!
+  \brief Scale every element of an array by a scalar value. 2D specialization.
+  \param array The array to scale.
+  \param alpha The value to scale the array by.
+  \param tag The tag for the decomposition over which to perform the operation.
+*/
+template <class Array_t, class DecompositionTag>
+std::enable_if_t<2 == Array_t::num_space_dim, void>
+scale( Array_t& array, const typename Array_t::value_type alpha,
+       DecompositionTag tag )
+{
+    scale( typename Array_t::execution_space(), array, alpha, tag );
+}
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Scale every element of an array by a scalar. 3D specialization.
+  \param exec_space The execution space to use.
   \param array The array to scale.
   \param alpha The values to scale the array by. A value must be provided for
   each entity degree-of-freedom in the array.
   \param tag The tag for the decomposition over which to perform the operation.
 */
-template <class Array_t, class DecompositionTag>
+template <class ExecutionSpace, class Array_t, class DecompositionTag>
 std::enable_if_t<3 == Array_t::num_space_dim, void>
-scale( Array_t& array, const std::vector<typename Array_t::value_type>& alpha,
+scale( const ExecutionSpace& exec_space, Array_t& array,
+       const std::vector<typename Array_t::value_type>& alpha,
        DecompositionTag tag )
 {
     static_assert( is_array<Array_t>::value, "Cajita::Array required" );
@@ -505,23 +551,40 @@ scale( Array_t& array, const std::vector<typename Array_t::value_type>& alpha,
     Kokkos::parallel_for(
         "ArrayOp::scale",
         createExecutionPolicy( array.layout()->indexSpace( tag, Local() ),
-                               typename Array_t::execution_space() ),
+                               exec_space ),
         KOKKOS_LAMBDA( const int i, const int j, const int k, const int l ) {
             array_view( i, j, k, l ) *= alpha_view( l );
         } );
 }
 
 /*!
-  \brief Scale every element of an array by a scalar. 2D specialization.
+  \brief Scale every element of an array by a scalar. 3D specialization.
   \param array The array to scale.
   \param alpha The values to scale the array by. A value must be provided for
   each entity degree-of-freedom in the array.
   \param tag The tag for the decomposition over which to perform the operation.
 */
 template <class Array_t, class DecompositionTag>
-std::enable_if_t<2 == Array_t::num_space_dim, void>
+std::enable_if_t<3 == Array_t::num_space_dim, void>
 scale( Array_t& array, const std::vector<typename Array_t::value_type>& alpha,
        DecompositionTag tag )
+{
+    scale( typename Array_t::execution_space(), array, alpha, tag );
+}
+
+/*!
+  \brief Scale every element of an array by a scalar. 2D specialization.
+  \param exec_space The execution space to use.
+  \param array The array to scale.
+  \param alpha The values to scale the array by. A value must be provided for
+  each entity degree-of-freedom in the array.
+  \param tag The tag for the decomposition over which to perform the operation.
+*/
+template <class ExecutionSpace, class Array_t, class DecompositionTag>
+std::enable_if_t<2 == Array_t::num_space_dim, void>
+scale( const ExecutionSpace& exec_space, Array_t& array,
+       const std::vector<typename Array_t::value_type>& alpha,
+       DecompositionTag tag )
 {
     static_assert( is_array<Array_t>::value, "Cajita::Array required" );
     if ( alpha.size() !=
@@ -538,21 +601,38 @@ scale( Array_t& array, const std::vector<typename Array_t::value_type>& alpha,
     Kokkos::parallel_for(
         "ArrayOp::scale",
         createExecutionPolicy( array.layout()->indexSpace( tag, Local() ),
-                               typename Array_t::execution_space() ),
+                               exec_space ),
         KOKKOS_LAMBDA( const int i, const int j, const int l ) {
             array_view( i, j, l ) *= alpha_view( l );
         } );
 }
 
+/*!
+  \brief Scale every element of an array by a scalar. 2D specialization.
+  \param array The array to scale.
+  \param alpha The values to scale the array by. A value must be provided for
+  each entity degree-of-freedom in the array.
+  \param tag The tag for the decomposition over which to perform the operation.
+*/
+template <class Array_t, class DecompositionTag>
+std::enable_if_t<2 == Array_t::num_space_dim, void>
+scale( Array_t& array, const std::vector<typename Array_t::value_type>& alpha,
+       DecompositionTag tag )
+{
+    scale( typename Array_t::execution_space(), array, alpha, tag );
+}
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Copy one array into another over the designated decomposition. A <- B
+  \param exec_space The execution space to use.
   \param a The array to which the data will be copied.
   \param b The array from which the data will be copied.
   \param tag The tag for the decomposition over which to perform the operation.
 */
-template <class Array_t, class DecompositionTag>
-void copy( Array_t& a, const Array_t& b, DecompositionTag tag )
+template <class ExecutionSpace, class Array_t, class DecompositionTag>
+void copy( const ExecutionSpace& exec_space, Array_t& a, const Array_t& b,
+           DecompositionTag tag )
 {
     static_assert( is_array<Array_t>::value, "Cajita::Array required" );
     auto a_space = a.layout()->indexSpace( tag, Local() );
@@ -561,7 +641,19 @@ void copy( Array_t& a, const Array_t& b, DecompositionTag tag )
         throw std::logic_error( "Incompatible index spaces" );
     auto subview_a = createSubview( a.view(), a_space );
     auto subview_b = createSubview( b.view(), b_space );
-    Kokkos::deep_copy( subview_a, subview_b );
+    Kokkos::deep_copy( exec_space, subview_a, subview_b );
+}
+
+/*!
+  \brief Copy one array into another over the designated decomposition. A <- B
+  \param a The array to which the data will be copied.
+  \param b The array from which the data will be copied.
+  \param tag The tag for the decomposition over which to perform the operation.
+*/
+template <class Array_t, class DecompositionTag>
+void copy( Array_t& a, const Array_t& b, DecompositionTag tag )
+{
+    copy( typename Array_t::execution_space(), a, b, tag );
 }
 
 //---------------------------------------------------------------------------//
@@ -582,15 +674,17 @@ std::shared_ptr<Array_t> cloneCopy( const Array_t& array, DecompositionTag tag )
 /*!
   \brief Update two vectors such that a = alpha * a + beta * b.
   3D specialization.
+  \param exec_space The execution space to use.
   \param a The array that will be updated.
   \param alpha The value to scale a by.
   \param b The array to add to a.
   \param beta The value to scale b by.
   \param tag The tag for the decomposition over which to perform the operation.
 */
-template <class Array_t, class DecompositionTag>
+template <class ExecutionSpace, class Array_t, class DecompositionTag>
 std::enable_if_t<3 == Array_t::num_space_dim, void>
-update( Array_t& a, const typename Array_t::value_type alpha, const Array_t& b,
+update( const ExecutionSpace& exec_space, Array_t& a,
+        const typename Array_t::value_type alpha, const Array_t& b,
         const typename Array_t::value_type beta, DecompositionTag tag )
 {
     static_assert( is_array<Array_t>::value, "Cajita::Array required" );
@@ -599,7 +693,7 @@ update( Array_t& a, const typename Array_t::value_type alpha, const Array_t& b,
     Kokkos::parallel_for(
         "ArrayOp::update",
         createExecutionPolicy( a.layout()->indexSpace( tag, Local() ),
-                               typename Array_t::execution_space() ),
+                               exec_space ),
         KOKKOS_LAMBDA( const int i, const int j, const int k, const int l ) {
             a_view( i, j, k, l ) =
                 alpha * a_view( i, j, k, l ) + beta * b_view( i, j, k, l );
@@ -608,7 +702,7 @@ update( Array_t& a, const typename Array_t::value_type alpha, const Array_t& b,
 
 /*!
   \brief Update two vectors such that a = alpha * a + beta * b.
-  2D specialization.
+  3D specialization.
   \param a The array that will be updated.
   \param alpha The value to scale a by.
   \param b The array to add to a.
@@ -616,9 +710,28 @@ update( Array_t& a, const typename Array_t::value_type alpha, const Array_t& b,
   \param tag The tag for the decomposition over which to perform the operation.
 */
 template <class Array_t, class DecompositionTag>
-std::enable_if_t<2 == Array_t::num_space_dim, void>
+std::enable_if_t<3 == Array_t::num_space_dim, void>
 update( Array_t& a, const typename Array_t::value_type alpha, const Array_t& b,
         const typename Array_t::value_type beta, DecompositionTag tag )
+{
+    update( typename Array_t::execution_space(), a, alpha, b, beta, tag );
+}
+
+/*!
+  \brief Update two vectors such that a = alpha * a + beta * b.
+  2D specialization.
+  \param exec_space The execution space to use.
+  \param a The array that will be updated.
+  \param alpha The value to scale a by.
+  \param b The array to add to a.
+  \param beta The value to scale b by.
+  \param tag The tag for the decomposition over which to perform the operation.
+*/
+template <class ExecutionSpace, class Array_t, class DecompositionTag>
+std::enable_if_t<2 == Array_t::num_space_dim, void>
+update( const ExecutionSpace& exec_space, Array_t& a,
+        const typename Array_t::value_type alpha, const Array_t& b,
+        const typename Array_t::value_type beta, DecompositionTag tag )
 {
     static_assert( is_array<Array_t>::value, "Cajita::Array required" );
     auto a_view = a.view();
@@ -626,17 +739,35 @@ update( Array_t& a, const typename Array_t::value_type alpha, const Array_t& b,
     Kokkos::parallel_for(
         "ArrayOp::update",
         createExecutionPolicy( a.layout()->indexSpace( tag, Local() ),
-                               typename Array_t::execution_space() ),
+                               exec_space ),
         KOKKOS_LAMBDA( const long i, const long j, const long l ) {
             a_view( i, j, l ) =
                 alpha * a_view( i, j, l ) + beta * b_view( i, j, l );
         } );
 }
 
+/*!
+  \brief Update two vectors such that a = alpha * a + beta * b.
+  2D specialization.
+  \param a The array that will be updated.
+  \param alpha The value to scale a by.
+  \param b The array to add to a.
+  \param beta The value to scale b by.
+  \param tag The tag for the decomposition over which to perform the operation.
+*/
+template <class Array_t, class DecompositionTag>
+std::enable_if_t<2 == Array_t::num_space_dim, void>
+update( Array_t& a, const typename Array_t::value_type alpha, const Array_t& b,
+        const typename Array_t::value_type beta, DecompositionTag tag )
+{
+    update( typename Array_t::execution_space(), a, alpha, b, beta, tag );
+}
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Update three vectors such that a = alpha * a + beta * b + gamma * c.
   3D specialization.
+  \param exec_space The execution space to use.
   \param a The array that will be updated.
   \param alpha The value to scale a by.
   \param b The first array to add to a.
@@ -645,9 +776,10 @@ update( Array_t& a, const typename Array_t::value_type alpha, const Array_t& b,
   \param gamma The value to scale b by.
   \param tag The tag for the decomposition over which to perform the operation.
 */
-template <class Array_t, class DecompositionTag>
+template <class ExecutionSpace, class Array_t, class DecompositionTag>
 std::enable_if_t<3 == Array_t::num_space_dim, void>
-update( Array_t& a, const typename Array_t::value_type alpha, const Array_t& b,
+update( const ExecutionSpace& exec_space, Array_t& a,
+        const typename Array_t::value_type alpha, const Array_t& b,
         const typename Array_t::value_type beta, const Array_t& c,
         const typename Array_t::value_type gamma, DecompositionTag tag )
 {
@@ -658,7 +790,7 @@ update( Array_t& a, const typename Array_t::value_type alpha, const Array_t& b,
     Kokkos::parallel_for(
         "ArrayOp::update",
         createExecutionPolicy( a.layout()->indexSpace( tag, Local() ),
-                               typename Array_t::execution_space() ),
+                               exec_space ),
         KOKKOS_LAMBDA( const int i, const int j, const int k, const int l ) {
             a_view( i, j, k, l ) = alpha * a_view( i, j, k, l ) +
                                    beta * b_view( i, j, k, l ) +
@@ -668,7 +800,7 @@ update( Array_t& a, const typename Array_t::value_type alpha, const Array_t& b,
 
 /*!
   \brief Update three vectors such that a = alpha * a + beta * b + gamma * c.
-  2D specialization.
+  3D specialization.
   \param a The array that will be updated.
   \param alpha The value to scale a by.
   \param b The first array to add to a.
@@ -678,10 +810,33 @@ update( Array_t& a, const typename Array_t::value_type alpha, const Array_t& b,
   \param tag The tag for the decomposition over which to perform the operation.
 */
 template <class Array_t, class DecompositionTag>
-std::enable_if_t<2 == Array_t::num_space_dim, void>
+std::enable_if_t<3 == Array_t::num_space_dim, void>
 update( Array_t& a, const typename Array_t::value_type alpha, const Array_t& b,
         const typename Array_t::value_type beta, const Array_t& c,
         const typename Array_t::value_type gamma, DecompositionTag tag )
+{
+    update( typename Array_t::execution_space(), a, alpha, b, beta, c, gamma,
+            tag );
+}
+
+/*!
+  \brief Update three vectors such that a = alpha * a + beta * b + gamma * c.
+  2D specialization.
+  \param exec_space The execution space to use.
+  \param a The array that will be updated.
+  \param alpha The value to scale a by.
+  \param b The first array to add to a.
+  \param beta The value to scale b by.
+  \param c The second array to add to a.
+  \param gamma The value to scale b by.
+  \param tag The tag for the decomposition over which to perform the operation.
+*/
+template <class ExecutionSpace, class Array_t, class DecompositionTag>
+std::enable_if_t<2 == Array_t::num_space_dim, void>
+update( const ExecutionSpace& exec_space, Array_t& a,
+        const typename Array_t::value_type alpha, const Array_t& b,
+        const typename Array_t::value_type beta, const Array_t& c,
+        const typename Array_t::value_type gamma, DecompositionTag tag )
 {
     static_assert( is_array<Array_t>::value, "Cajita::Array required" );
     auto a_view = a.view();
@@ -690,7 +845,7 @@ update( Array_t& a, const typename Array_t::value_type alpha, const Array_t& b,
     Kokkos::parallel_for(
         "ArrayOp::update",
         createExecutionPolicy( a.layout()->indexSpace( tag, Local() ),
-                               typename Array_t::execution_space() ),
+                               exec_space ),
         KOKKOS_LAMBDA( const int i, const int j, const int l ) {
             a_view( i, j, l ) = alpha * a_view( i, j, l ) +
                                 beta * b_view( i, j, l ) +
@@ -698,6 +853,27 @@ update( Array_t& a, const typename Array_t::value_type alpha, const Array_t& b,
         } );
 }
 
+/*!
+  \brief Update three vectors such that a = alpha * a + beta * b + gamma * c.
+  2D specialization.
+  \param a The array that will be updated.
+  \param alpha The value to scale a by.
+  \param b The first array to add to a.
+  \param beta The value to scale b by.
+  \param c The second array to add to a.
+  \param gamma The value to scale b by.
+  \param tag The tag for the decomposition over which to perform the operation.
+*/
+template <class Array_t, class DecompositionTag>
+std::enable_if_t<2 == Array_t::num_space_dim, void>
+update( Array_t& a, const typename Array_t::value_type alpha, const Array_t& b,
+        const typename Array_t::value_type beta, const Array_t& c,
+        const typename Array_t::value_type gamma, DecompositionTag tag )
+{
+    update( typename Array_t::execution_space(), a, alpha, b, beta, c, gamma,
+            tag );
+}
+
 //---------------------------------------------------------------------------//
 //! Dot product functor
 template <class ViewType, std::size_t NumSpaceDim>
@@ -18,6 +18,7 @@
 
 #include <Cajita_Array.hpp>
 #include <Cajita_IndexSpace.hpp>
+#include <Cajita_Types.hpp>
 
 #include <Cabana_ParameterPack.hpp>
 
@@ -28,7 +29,11 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace Cajita
@@ -63,8 +68,24 @@ class HaloPattern
         return _neighbors;
     }
 
+    //! Assign the halo width in each dimension received from each neighbor,
+    //! in the same order as the neighbors. If no widths are assigned the full
+    //! halo width is exchanged with every neighbor.
+    void setNeighborWidths(
+        const std::vector<std::array<int, num_space_dim>>& widths )
+    {
+        _widths = widths;
+    }
+
+    //! Get the halo width in each dimension received from each neighbor.
+    std::vector<std::array<int, num_space_dim>> getNeighborWidths() const
+    {
+        return _widths;
+    }
+
   private:
     std::vector<std::array<int, num_space_dim>> _neighbors;
+    std::vector<std::array<int, num_space_dim>> _widths;
 };
 
 //! %Halo with node connectivity. I.e. communicate with all neighbor ranks with
@@ -152,6 +173,90 @@ class [[deprecated]] FullHaloPattern : public NodeHaloPattern<3>
 {
 };
 
+/*!
+  \brief %Halo derived from a stencil footprint.
+
+  The stencil is given as the set of offsets read relative to an owned entity.
+  A ghost region toward a neighbor is received if an offset points into it and
+  its width in each dimension is the largest offset pointing into it. Owned
+  data is sent to a neighbor with the widths the neighbor receives from the
+  opposite direction. Only neighbors that send or receive data are in the
+  pattern, so asymmetric (e.g. upwind) stencils exchange only the data they
+  read.
+*/
+template <std::size_t NumSpaceDim>
+class StencilHaloPattern : public HaloPattern<NumSpaceDim>
+{
+  public:
+    //! Spatial dimension.
+    static constexpr std::size_t num_space_dim = NumSpaceDim;
+
+    /*!
+      \brief Constructor.
+      \param offsets The stencil offsets in each dimension.
+    */
+    StencilHaloPattern(
+        const std::vector<std::array<int, num_space_dim>>& offsets )
+        : HaloPattern<num_space_dim>()
+    {
+        // Compute the width received from each of the 3^d - 1 directions.
+        int num_direction = 1;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+            num_direction *= 3;
+        std::vector<std::array<int, num_space_dim>> directions( num_direction );
+        std::vector<std::array<int, num_space_dim>> widths( num_direction );
+        for ( int c = 0; c < num_direction; ++c )
+        {
+            int stride = 1;
+            for ( std::size_t d = 0; d < num_space_dim; ++d )
+            {
+                directions[c][d] = ( c / stride ) % 3 - 1;
+                widths[c][d] = 0;
+                stride *= 3;
+            }
+            for ( const auto& o : offsets )
+            {
+                // The offset points into this direction if it crosses the
+                // boundary in every dimension the direction does.
+                bool in_direction = true;
+                for ( std::size_t d = 0; d < num_space_dim; ++d )
+                    if ( directions[c][d] != 0 &&
+                         o[d] * directions[c][d] <= 0 )
+                        in_direction = false;
+                if ( in_direction )
+                    for ( std::size_t d = 0; d < num_space_dim; ++d )
+                        if ( directions[c][d] != 0 )
+                            widths[c][d] =
+                                std::max( widths[c][d], std::abs( o[d] ) );
+            }
+        }
+
+        // Keep the neighbors we receive from or send to. The opposite
+        // direction of direction c is direction num_direction - 1 - c.
+        auto exchanges = [&]( const int c )
+        {
+            bool active = false;
+            for ( std::size_t d = 0; d < num_space_dim; ++d )
+                active = active || widths[c][d] > 0;
+            return active;
+        };
+        std::vector<std::array<int, num_space_dim>> neighbors;
+        std::vector<std::array<int, num_space_dim>> neighbor_widths;
+        for ( int c = 0; c < num_direction; ++c )
+        {
+            if ( 2 * c + 1 == num_direction )
+                continue;
+            if ( exchanges( c ) || exchanges( num_direction - 1 - c ) )
+            {
+                neighbors.push_back( directions[c] );
+                neighbor_widths.push_back( widths[c] );
+            }
+        }
+        this->setNeighbors( neighbors );
+        this->setNeighborWidths( neighbor_widths );
+    }
+};
+
 //---------------------------------------------------------------------------//
 // Scatter reduction.
 //---------------------------------------------------------------------------//
@@ -185,6 +290,40 @@ struct Replace
 
 } // end namespace ScatterReduce
 
+//---------------------------------------------------------------------------//
+// Physical boundary conditions.
+//---------------------------------------------------------------------------//
+namespace BoundaryCondition
+{
+
+//! Set the ghosts on a physical boundary to a fixed value.
+struct Dirichlet
+{
+    //! Boundary condition kind.
+    static constexpr int kind = 0;
+
+    //! Boundary value.
+    double value = 0.0;
+};
+
+//! Set the ghosts on a physical boundary to their mirror image in the owned
+//! entities (zero normal gradient).
+struct Neumann
+{
+    //! Boundary condition kind.
+    static constexpr int kind = 1;
+};
+
+//! Set the ghosts on a physical boundary to the negated mirror image in the
+//! owned entities (zero value on the boundary).
+struct Reflect
+{
+    //! Boundary condition kind.
+    static constexpr int kind = 2;
+};
+
+} // end namespace BoundaryCondition
+
 //---------------------------------------------------------------------------//
 // Halo
 // ---------------------------------------------------------------------------//
@@ -198,6 +337,9 @@ struct Replace
   communicator and halo size. The arrays must also reside in the same memory
   space. These requirements are checked at construction.
 */
+template <class MemorySpace>
+class HaloGroup;
+
 template <class MemorySpace>
 class Halo
 {
@@ -205,6 +347,10 @@ class Halo
     //! Memory space.
     using memory_space = MemorySpace;
 
+    //! Halo groups aggregate the buffers of their halos.
+    template <class>
+    friend class HaloGroup;
+
     /*!
       \brief Constructor.
       \tparam The arrays types to construct the halo for.
@@ -242,10 +388,25 @@ class Halo
             return flip_ijk;
         };
 
+        // Get the halo widths received from each neighbor, if the pattern
+        // restricts them. The widths sent to a neighbor are the widths
+        // received from the opposite direction. A negative width uses the
+        // full halo width.
+        auto neighbors = pattern.getNeighbors();
+        auto pattern_widths = pattern.getNeighborWidths();
+        auto direction_width = [&]( const std::array<int, num_space_dim>& ijk )
+        {
+            std::array<int, num_space_dim> w;
+            w.fill( pattern_widths.empty() ? -1 : 0 );
+            for ( std::size_t m = 0; m < pattern_widths.size(); ++m )
+                if ( neighbors[m] == ijk )
+                    w = pattern_widths[m];
+            return w;
+        };
+
         // Get the neighbor ranks we will exchange with in the halo and
         // allocate buffers. If any of the exchanges are self sends mark these
         // so we know which send buffers correspond to which receive buffers.
-        auto neighbors = pattern.getNeighbors();
         for ( const auto& n : neighbors )
         {
             // Get the rank of the neighbor.
@@ -266,12 +427,13 @@ class Halo
                 _receive_tags.push_back( neighbor_id( flip_id( n ) ) );
 
                 // Create communication data for owned entities.
-                buildCommData( Own(), width, n, _owned_buffers, _owned_steering,
-                               arrays... );
+                buildCommData( Own(), width, direction_width( flip_id( n ) ),
+                               n, _owned_buffers, _owned_steering, arrays... );
 
                 // Create communication data for ghosted entities.
-                buildCommData( Ghost(), width, n, _ghosted_buffers,
-                               _ghosted_steering, arrays... );
+                buildCommData( Ghost(), width, direction_width( n ), n,
+                               _ghosted_buffers, _ghosted_steering,
+                               arrays... );
             }
         }
     }
@@ -292,10 +454,15 @@ class Halo
     {
         Kokkos::Profiling::pushRegion( "Cajita::gather" );
 
-        // Get the number of neighbors. Return if we have none.
+        // Get the number of neighbors. Apply the boundary conditions and
+        // return if we have none.
         int num_n = _neighbor_ranks.size();
         if ( 0 == num_n )
+        {
+            applyBoundaryConditions( exec_space, arrays... );
+            Kokkos::Profiling::popRegion();
             return;
+        }
 
         // Get the MPI communicator.
         auto comm = getComm( arrays... );
@@ -338,8 +505,10 @@ class Halo
             }
         }
 
-        // Unpack receive buffers.
+        // Unpack receive buffers. The boundary conditions are applied in the
+        // same kernel as the first buffer unpacked.
         bool unpack_complete = false;
+        bool boundary_applied = false;
         while ( !unpack_complete )
         {
             // Get the next buffer to unpack.
@@ -354,6 +523,14 @@ class Halo
             }
 
             // Otherwise unpack the next buffer.
+            else if ( !boundary_applied )
+            {
+                unpackBufferWithBoundary( ScatterReduce::Replace(), exec_space,
+                                          _ghosted_buffers[unpack_index],
+                                          _ghosted_steering[unpack_index],
+                                          arrays.view()... );
+                boundary_applied = true;
+            }
             else
             {
                 unpackBuffer( ScatterReduce::Replace(), exec_space,
@@ -363,6 +540,13 @@ class Halo
             }
         }
 
+        // If nothing was received apply the boundary conditions on their own.
+        // Otherwise fill the boundary ghosts mirroring received ghosts.
+        if ( !boundary_applied )
+            applyBoundaryConditions( exec_space, arrays... );
+        else
+            applyMixedBoundaryConditions( exec_space, arrays... );
+
         // Wait on send requests.
         MPI_Waitall( num_n, requests.data() + num_n, MPI_STATUSES_IGNORE );
         Kokkos::Profiling::popRegion();
@@ -455,6 +639,203 @@ class Halo
         Kokkos::Profiling::popRegion();
     }
 
+    /*!
+      \brief Register a boundary condition for the ghosts of an array on the
+      non-periodic physical boundaries of the domain.
+
+      Ghosts are filled in every direction with an offset dimension on a
+      physical boundary. Where every offset dimension is a physical boundary
+      (faces, and edges and corners where physical boundaries meet) the
+      ghosts only depend on owned data and are never received from a
+      neighbor, so gather fills them in the same kernel launch that unpacks
+      the first received buffer. Edges and corners where a physical boundary
+      meets a periodic or interior dimension are never received either; they
+      are mirrored across the physical dimensions only, onto ghosts received
+      in the other dimensions, and are filled after all buffers are
+      unpacked.
+
+      \param bc The boundary condition, e.g. BoundaryCondition::Dirichlet.
+      \param array_index The index of the array in the arguments of gather.
+      \param array The array. Must have the same layout as the array given to
+      gather at array_index.
+      \param dof The degree of freedom to apply the boundary condition to. By
+      default all degrees of freedom are used.
+    */
+    template <class BoundaryConditionType, class ArrayType>
+    void addBoundaryCondition( const BoundaryConditionType& bc,
+                               const int array_index, const ArrayType& array,
+                               const int dof = -1 )
+    {
+        using entity_type = typename ArrayType::entity_type;
+        constexpr std::size_t num_space_dim = ArrayType::num_space_dim;
+        const int num_column = 4 + 2 * num_space_dim;
+        if ( ( !_bc_host_values.empty() &&
+               num_column != static_cast<int>( _bc_steering.extent( 1 ) ) ) ||
+             ( !_bc_mixed_host_values.empty() &&
+               num_column !=
+                   static_cast<int>( _bc_mixed_steering.extent( 1 ) ) ) )
+            throw std::runtime_error(
+                "Boundary conditions have different spatial dimensions" );
+
+        // Get the degrees of freedom.
+        int num_dof = array.layout()->dofsPerEntity();
+        if ( dof >= num_dof )
+            throw std::runtime_error( "Boundary condition dof out of range" );
+        int dof_min = ( dof < 0 ) ? 0 : dof;
+        int dof_max = ( dof < 0 ) ? num_dof : dof + 1;
+
+        // Ghosts are mirrored across the boundary of the owned entities.
+        // Dimensions in which the entity is a node mirror about the boundary
+        // entity, the others mirror about the boundary face.
+        auto local_grid = array.layout()->localGrid();
+        const auto& global_grid = local_grid->globalGrid();
+        auto owned_space =
+            local_grid->indexSpace( Own(), entity_type(), Local() );
+        std::array<bool, num_space_dim> node_dim;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+            node_dim[d] = isNodeDim( entity_type(), d );
+
+        // Loop over the directions with an offset dimension on a physical
+        // boundary.
+        int num_direction = 1;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+            num_direction *= 3;
+        for ( int c = 0; c < num_direction; ++c )
+        {
+            std::array<int, num_space_dim> nid;
+            std::array<bool, num_space_dim> physical;
+            bool any_physical = false;
+            bool all_physical = true;
+            for ( std::size_t d = 0, stride = 1; d < num_space_dim;
+                  ++d, stride *= 3 )
+            {
+                nid[d] = ( c / stride ) % 3 - 1;
+                physical[d] =
+                    !global_grid.isPeriodic( d ) &&
+                    ( ( nid[d] < 0 && global_grid.onLowBoundary( d ) ) ||
+                      ( nid[d] > 0 && global_grid.onHighBoundary( d ) ) );
+                any_physical = any_physical || physical[d];
+                all_physical = all_physical && ( 0 == nid[d] || physical[d] );
+            }
+            if ( !any_physical )
+                continue;
+
+            // Ghosts of mixed directions mirror received ghosts and are
+            // filled after the unpack.
+            auto& host_steering =
+                all_physical ? _bc_host_steering : _bc_mixed_host_steering;
+            auto& host_values =
+                all_physical ? _bc_host_values : _bc_mixed_host_values;
+
+            // Add a steering entry for each ghost with a mirror image across
+            // the physical boundaries in the owned entities. Dimensions
+            // without a physical boundary are not mirrored.
+            auto ghost_space =
+                local_grid->boundaryIndexSpace( Ghost(), entity_type(), nid );
+            for ( long e = 0; e < ghost_space.size(); ++e )
+            {
+                std::array<int, num_space_dim> ghost;
+                std::array<int, num_space_dim> mirror;
+                bool valid = true;
+                for ( long d = num_space_dim - 1, r = e; d >= 0; --d )
+                {
+                    long extent = ghost_space.extent( d );
+                    ghost[d] = ghost_space.min( d ) + r % extent;
+                    r /= extent;
+                    int lo = owned_space.min( d );
+                    int hi = owned_space.max( d );
+                    if ( !physical[d] )
+                    {
+                        mirror[d] = ghost[d];
+                        continue;
+                    }
+                    if ( nid[d] < 0 )
+                        mirror[d] = ( node_dim[d] ? 2 * lo : 2 * lo - 1 ) -
+                                    ghost[d];
+                    else
+                        mirror[d] = ( node_dim[d] ? 2 * hi - 2 : 2 * hi - 1 ) -
+                                    ghost[d];
+                    valid = valid && mirror[d] >= lo && mirror[d] < hi;
+                }
+                if ( !valid && BoundaryCondition::Dirichlet::kind != bc.kind )
+                    continue;
+                for ( int l = dof_min; l < dof_max; ++l )
+                {
+                    host_steering.push_back( bc.kind );
+                    host_steering.push_back( array_index );
+                    for ( std::size_t d = 0; d < num_space_dim; ++d )
+                        host_steering.push_back( ghost[d] );
+                    host_steering.push_back( l );
+                    for ( std::size_t d = 0; d < num_space_dim; ++d )
+                        host_steering.push_back( valid ? mirror[d]
+                                                       : ghost[d] );
+                    host_steering.push_back( l );
+                    host_values.push_back( boundaryValue( bc ) );
+                }
+            }
+        }
+
+        // Copy the boundary steering vectors to the device.
+        copyBoundarySteering( _bc_host_steering, _bc_host_values, num_column,
+                              _bc_steering, _bc_values );
+        copyBoundarySteering( _bc_mixed_host_steering, _bc_mixed_host_values,
+                              num_column, _bc_mixed_steering,
+                              _bc_mixed_values );
+    }
+
+    //! Get the number of ghost elements filled by boundary conditions.
+    std::size_t numBoundaryElement() const
+    {
+        return _bc_values.extent( 0 ) + _bc_mixed_values.extent( 0 );
+    }
+
+    /*!
+      \brief Apply the registered boundary conditions without communication.
+      \param exec_space The execution space to use.
+      \param arrays The arrays, in the same order as in gather.
+    */
+    template <class ExecutionSpace, class... ArrayTypes>
+    void applyBoundaryConditions( const ExecutionSpace& exec_space,
+                                  const ArrayTypes&... arrays ) const
+    {
+        if ( 0 < _bc_values.extent( 0 ) )
+            unpackBufferWithBoundary( ScatterReduce::Replace(), exec_space,
+                                      Kokkos::View<char*, memory_space>(),
+                                      Kokkos::View<int**, memory_space>(),
+                                      arrays.view()... );
+        applyMixedBoundaryConditions( exec_space, arrays... );
+    }
+
+    /*!
+      \brief Apply the registered boundary conditions to the edge and corner
+      ghosts where a physical boundary meets a periodic or interior
+      dimension. These mirror ghosts received in the other dimensions so they
+      must be applied after the exchange.
+      \param exec_space The execution space to use.
+      \param arrays The arrays, in the same order as in gather.
+    */
+    template <class ExecutionSpace, class... ArrayTypes>
+    void applyMixedBoundaryConditions( const ExecutionSpace& exec_space,
+                                       const ArrayTypes&... arrays ) const
+    {
+        if ( 0 == _bc_mixed_values.extent( 0 ) )
+            return;
+        auto pp = Cabana::makeParameterPack( arrays.view()... );
+        auto bc_steering = _bc_mixed_steering;
+        auto bc_values = _bc_mixed_values;
+        Kokkos::parallel_for(
+            "Cajita::Halo::mixed_boundary",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                                 bc_values.extent( 0 ) ),
+            KOKKOS_LAMBDA( const int i ) {
+                boundaryArray(
+                    bc_steering, bc_values, i,
+                    std::integral_constant<std::size_t,
+                                           sizeof...( ArrayTypes ) - 1>(),
+                    pp );
+            } );
+    }
+
   public:
     //! Get the communicator.
     template <class Array_t>
@@ -505,11 +886,45 @@ class Halo
         return local_grid;
     }
 
+    //! Restrict a shared index space to the given width in each dimension
+    //! in which the neighbor is offset. Owned spaces keep the entities nearest
+    //! the boundary with the neighbor, as do ghosted spaces.
+    template <class DecompositionTag, std::size_t N, std::size_t NumSpaceDim>
+    static IndexSpace<N>
+    restrictSharedSpace( DecompositionTag, const IndexSpace<N>& space,
+                         const std::array<int, NumSpaceDim>& nid,
+                         const std::array<int, NumSpaceDim>& dir_width )
+    {
+        std::array<long, N> min;
+        std::array<long, N> max;
+        for ( std::size_t d = 0; d < N; ++d )
+        {
+            min[d] = space.min( d );
+            max[d] = space.max( d );
+        }
+        for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+        {
+            if ( 0 == nid[d] || dir_width[d] < 0 )
+                continue;
+            long w = std::min( static_cast<long>( dir_width[d] ),
+                               max[d] - min[d] );
+            bool keep_high = std::is_same<DecompositionTag, Own>::value
+                                 ? ( nid[d] > 0 )
+                                 : ( nid[d] < 0 );
+            if ( keep_high )
+                min[d] = max[d] - w;
+            else
+                max[d] = min[d] + w;
+        }
+        return IndexSpace<N>( min, max );
+    }
+
     //! Build communication data.
     template <class DecompositionTag, std::size_t NumSpaceDim,
               class... ArrayTypes>
     void
     buildCommData( DecompositionTag decomposition_tag, const int width,
+                   const std::array<int, NumSpaceDim>& dir_width,
                    const std::array<int, NumSpaceDim>& nid,
                    std::vector<Kokkos::View<char*, memory_space>>& buffers,
                    std::vector<Kokkos::View<int**, memory_space>>& steering,
@@ -523,10 +938,14 @@ class Halo
             sizeof( typename ArrayTypes::value_type )... };
 
         // Get the index spaces we share with this neighbor. We
-        // get a shared index space for each array.
+        // get a shared index space for each array, restricted to the widths
+        // of the halo pattern.
         std::array<IndexSpace<NumSpaceDim + 1>, num_array> spaces = {
-            ( arrays.layout()->sharedIndexSpace( decomposition_tag, nid,
-                                                 width ) )... };
+            ( restrictSharedSpace(
+                decomposition_tag,
+                arrays.layout()->sharedIndexSpace( decomposition_tag, nid,
+                                                   width ),
+                nid, dir_width ) )... };
 
         // Compute the buffer size of this neighbor and the
         // number of elements in the buffer.
@@ -907,6 +1326,178 @@ class Halo
             } );
     }
 
+    //! Copy a boundary steering vector to the device.
+    static void
+    copyBoundarySteering( std::vector<int>& host_steering,
+                          std::vector<double>& host_values,
+                          const int num_column,
+                          Kokkos::View<int**, memory_space>& steering,
+                          Kokkos::View<double*, memory_space>& values )
+    {
+        int num_element = host_values.size();
+        Kokkos::View<int**, Kokkos::LayoutRight, Kokkos::HostSpace,
+                     Kokkos::MemoryUnmanaged>
+            host_steering_view( host_steering.data(), num_element,
+                                num_column );
+        Kokkos::View<double*, Kokkos::HostSpace, Kokkos::MemoryUnmanaged>
+            host_values_view( host_values.data(), num_element );
+        steering = Kokkos::View<int**, memory_space>( "boundary_steering",
+                                                      num_element, num_column );
+        values = Kokkos::View<double*, memory_space>( "boundary_values",
+                                                      num_element );
+        auto steering_mirror = Kokkos::create_mirror_view( steering );
+        Kokkos::deep_copy( steering_mirror, host_steering_view );
+        Kokkos::deep_copy( steering, steering_mirror );
+        Kokkos::deep_copy( values, host_values_view );
+    }
+
+    //! Boundary value of a Dirichlet condition.
+    static double boundaryValue( const BoundaryCondition::Dirichlet& bc )
+    {
+        return bc.value;
+    }
+
+    //! Boundary value of other conditions.
+    template <class BoundaryConditionType>
+    static double boundaryValue( const BoundaryConditionType& )
+    {
+        return 0.0;
+    }
+
+    //! Check if an entity is located on the nodes in a given dimension.
+    template <class EntityType>
+    static bool isNodeDim( EntityType, const std::size_t d )
+    {
+        if constexpr ( isNode<EntityType>::value )
+            return true;
+        else if constexpr ( isFace<EntityType>::value )
+            return static_cast<int>( d ) == EntityType::dim;
+        else if constexpr ( isEdge<EntityType>::value )
+            return static_cast<int>( d ) != EntityType::dim;
+        else
+            return false;
+    }
+
+    //! Apply a boundary condition to a ghost element.
+    template <class T>
+    KOKKOS_INLINE_FUNCTION static void boundaryOp( const int kind,
+                                                   const double value,
+                                                   const T& mirror_val,
+                                                   T& ghost_val )
+    {
+        if ( BoundaryCondition::Dirichlet::kind == kind )
+            ghost_val = static_cast<T>( value );
+        else if ( BoundaryCondition::Neumann::kind == kind )
+            ghost_val = mirror_val;
+        else
+            ghost_val = -mirror_val;
+    }
+
+    //! Apply a boundary condition to an element.
+    template <class ArrayView>
+    KOKKOS_INLINE_FUNCTION static std::enable_if_t<4 == ArrayView::rank, void>
+    boundaryElement( const Kokkos::View<int**, memory_space>& bc_steering,
+                     const Kokkos::View<double*, memory_space>& bc_values,
+                     const int element_idx, const ArrayView& array_view )
+    {
+        boundaryOp(
+            bc_steering( element_idx, 0 ), bc_values( element_idx ),
+            array_view( bc_steering( element_idx, 6 ),
+                        bc_steering( element_idx, 7 ),
+                        bc_steering( element_idx, 8 ),
+                        bc_steering( element_idx, 9 ) ),
+            array_view( bc_steering( element_idx, 2 ),
+                        bc_steering( element_idx, 3 ),
+                        bc_steering( element_idx, 4 ),
+                        bc_steering( element_idx, 5 ) ) );
+    }
+
+    //! Apply a boundary condition to an element.
+    template <class ArrayView>
+    KOKKOS_INLINE_FUNCTION static std::enable_if_t<3 == ArrayView::rank, void>
+    boundaryElement( const Kokkos::View<int**, memory_space>& bc_steering,
+                     const Kokkos::View<double*, memory_space>& bc_values,
+                     const int element_idx, const ArrayView& array_view )
+    {
+        boundaryOp( bc_steering( element_idx, 0 ), bc_values( element_idx ),
+                    array_view( bc_steering( element_idx, 5 ),
+                                bc_steering( element_idx, 6 ),
+                                bc_steering( element_idx, 7 ) ),
+                    array_view( bc_steering( element_idx, 2 ),
+                                bc_steering( element_idx, 3 ),
+                                bc_steering( element_idx, 4 ) ) );
+    }
+
+    //! Apply a boundary condition to an array.
+    template <class... ArrayViews>
+    KOKKOS_INLINE_FUNCTION static void
+    boundaryArray( const Kokkos::View<int**, memory_space>& bc_steering,
+                   const Kokkos::View<double*, memory_space>& bc_values,
+                   const int element_idx,
+                   const std::integral_constant<std::size_t, 0>,
+                   const Cabana::ParameterPack<ArrayViews...>& array_views )
+    {
+        if ( 0 == bc_steering( element_idx, 1 ) )
+            boundaryElement( bc_steering, bc_values, element_idx,
+                             Cabana::get<0>( array_views ) );
+    }
+
+    //! Apply a boundary condition to an array.
+    template <std::size_t N, class... ArrayViews>
+    KOKKOS_INLINE_FUNCTION static void
+    boundaryArray( const Kokkos::View<int**, memory_space>& bc_steering,
+                   const Kokkos::View<double*, memory_space>& bc_values,
+                   const int element_idx,
+                   const std::integral_constant<std::size_t, N>,
+                   const Cabana::ParameterPack<ArrayViews...>& array_views )
+    {
+        if ( N == bc_steering( element_idx, 1 ) )
+        {
+            boundaryElement( bc_steering, bc_values, element_idx,
+                             Cabana::get<N>( array_views ) );
+            return;
+        }
+
+        // Recurse.
+        boundaryArray( bc_steering, bc_values, element_idx,
+                       std::integral_constant<std::size_t, N - 1>(),
+                       array_views );
+    }
+
+    //! Unpack arrays from a buffer and apply the boundary conditions in the
+    //! same kernel.
+    template <class ExecutionSpace, class ReduceOp, class... ArrayViews>
+    void
+    unpackBufferWithBoundary( const ReduceOp& reduce_op,
+                              const ExecutionSpace& exec_space,
+                              const Kokkos::View<char*, memory_space>& buffer,
+                              const Kokkos::View<int**, memory_space>& steering,
+                              ArrayViews... array_views ) const
+    {
+        auto pp = Cabana::makeParameterPack( array_views... );
+        auto bc_steering = _bc_steering;
+        auto bc_values = _bc_values;
+        const int num_unpack = steering.extent( 0 );
+        Kokkos::parallel_for(
+            "Cajita::Halo::unpack_buffer_boundary",
+            Kokkos::RangePolicy<ExecutionSpace>(
+                exec_space, 0, num_unpack + bc_values.extent( 0 ) ),
+            KOKKOS_LAMBDA( const int i ) {
+                if ( i < num_unpack )
+                    unpackArray(
+                        reduce_op, buffer, steering, i,
+                        std::integral_constant<std::size_t,
+                                               sizeof...( ArrayViews ) - 1>(),
+                        pp );
+                else
+                    boundaryArray(
+                        bc_steering, bc_values, i - num_unpack,
+                        std::integral_constant<std::size_t,
+                                               sizeof...( ArrayViews ) - 1>(),
+                        pp );
+            } );
+    }
+
   private:
     // The ranks we will send/receive from.
     std::vector<int> _neighbor_ranks;
@@ -928,6 +1519,20 @@ class Halo
 
     // For each neighbor, steering vector for the ghosted buffer.
     std::vector<Kokkos::View<int**, memory_space>> _ghosted_steering;
+
+    // Boundary condition steering vector. Each row holds the kind, the array,
+    // and the ghost and mirror indices of an element.
+    std::vector<int> _bc_host_steering;
+    std::vector<double> _bc_host_values;
+    Kokkos::View<int**, memory_space> _bc_steering;
+    Kokkos::View<double*, memory_space> _bc_values;
+
+    // Boundary condition steering vector of the directions mixing physical
+    // and non-physical dimensions, applied after the unpack.
+    std::vector<int> _bc_mixed_host_steering;
+    std::vector<double> _bc_mixed_host_values;
+    Kokkos::View<int**, memory_space> _bc_mixed_steering;
+    Kokkos::View<double*, memory_space> _bc_mixed_values;
 };
 
 //---------------------------------------------------------------------------//
@@ -1026,6 +1631,312 @@ createHalo( const Array<Scalar, EntityType, MeshType, Params...>& array,
         adapter{ *array.layout() };
     return createHalo( pattern, width, adapter );
 }
+//---------------------------------------------------------------------------//
+// Halo group.
+//---------------------------------------------------------------------------//
+/*!
+  \brief Group of halos exchanged together.
+
+  The buffers of all halos in the group that communicate with the same
+  neighbor in the same direction are aggregated into a single message, so
+  arrays that need different halos (e.g. different patterns or widths for
+  cell and node fields) are exchanged with one message per neighbor. All
+  ranks must create the group with the halos in the same order.
+*/
+template <class MemorySpace>
+class HaloGroup
+{
+  public:
+    //! Memory space.
+    using memory_space = MemorySpace;
+
+    //! Halo type.
+    using halo_type = Halo<MemorySpace>;
+
+    /*!
+      \brief Constructor.
+      \param halos The halos in the group.
+    */
+    HaloGroup( const std::vector<std::shared_ptr<halo_type>>& halos )
+        : _halos( halos )
+    {
+        for ( std::size_t h = 0; h < _halos.size(); ++h )
+        {
+            const auto& halo = *_halos[h];
+            for ( std::size_t n = 0; n < halo._neighbor_ranks.size(); ++n )
+            {
+                // Find the message to this neighbor in this direction.
+                std::size_t m = 0;
+                while ( m < _neighbor_ranks.size() &&
+                        !( _neighbor_ranks[m] == halo._neighbor_ranks[n] &&
+                           _send_tags[m] == halo._send_tags[n] ) )
+                    ++m;
+                if ( m == _neighbor_ranks.size() )
+                {
+                    _neighbor_ranks.push_back( halo._neighbor_ranks[n] );
+                    _send_tags.push_back( halo._send_tags[n] );
+                    _receive_tags.push_back( halo._receive_tags[n] );
+                    _owned_bytes.push_back( 0 );
+                    _ghosted_bytes.push_back( 0 );
+                    _segments.emplace_back();
+                }
+
+                // Append the halo buffers to the message.
+                _segments[m].push_back(
+                    { h, n, _owned_bytes[m], _ghosted_bytes[m] } );
+                _owned_bytes[m] += halo._owned_buffers[n].size();
+                _ghosted_bytes[m] += halo._ghosted_buffers[n].size();
+            }
+        }
+
+        // Allocate the message buffers.
+        for ( std::size_t m = 0; m < _neighbor_ranks.size(); ++m )
+        {
+            _owned_buffers.push_back( Kokkos::View<char*, memory_space>(
+                "halo_group_owned_buffer", _owned_bytes[m] ) );
+            _ghosted_buffers.push_back( Kokkos::View<char*, memory_space>(
+                "halo_group_ghosted_buffer", _ghosted_bytes[m] ) );
+        }
+    }
+
+    //! Get the number of halos in the group.
+    std::size_t numHalo() const { return _halos.size(); }
+
+    //! Get the number of messages sent in an exchange.
+    std::size_t numMessage() const { return _neighbor_ranks.size(); }
+
+    /*!
+      \brief Gather data into our ghosts from their owners.
+      \param exec_space The execution space to use for pack/unpack.
+      \param arrays For each halo in the group, in order, a tuple of the
+      arrays to gather with that halo, e.g. std::tie( *a, *b ). The arrays of
+      each halo must be given in the same order as in its constructor.
+    */
+    template <class ExecutionSpace, class... ArrayTuples>
+    void gather( const ExecutionSpace& exec_space,
+                 const ArrayTuples&... arrays ) const
+    {
+        Kokkos::Profiling::pushRegion( "Cajita::HaloGroup::gather" );
+        exchange( exec_space, ScatterReduce::Replace(), true, 4567,
+                  std::index_sequence_for<ArrayTuples...>(), arrays... );
+        applyBoundaryConditions( exec_space,
+                                 std::index_sequence_for<ArrayTuples...>(),
+                                 arrays... );
+        Kokkos::Profiling::popRegion();
+    }
+
+    /*!
+      \brief Scatter data from our ghosts to their owners using the given type
+      of reduce operation.
+      \param exec_space The execution space to use for pack/unpack.
+      \param reduce_op The functor used to reduce the results.
+      \param arrays For each halo in the group, in order, a tuple of the
+      arrays to scatter with that halo.
+    */
+    template <class ExecutionSpace, class ReduceOp, class... ArrayTuples>
+    void scatter( const ExecutionSpace& exec_space, const ReduceOp& reduce_op,
+                  const ArrayTuples&... arrays ) const
+    {
+        Kokkos::Profiling::pushRegion( "Cajita::HaloGroup::scatter" );
+        exchange( exec_space, reduce_op, false, 5678,
+                  std::index_sequence_for<ArrayTuples...>(), arrays... );
+        Kokkos::Profiling::popRegion();
+    }
+
+  private:
+    // Location of the buffers of one halo neighbor in a message.
+    struct Segment
+    {
+        std::size_t halo;
+        std::size_t neighbor;
+        std::size_t owned_offset;
+        std::size_t ghosted_offset;
+    };
+
+    // Exchange the messages. A gather sends owned data and receives ghosted
+    // data, a scatter does the reverse.
+    template <class ExecutionSpace, class ReduceOp, std::size_t... Is,
+              class... ArrayTuples>
+    void exchange( const ExecutionSpace& exec_space, const ReduceOp& reduce_op,
+                   const bool is_gather, const int mpi_tag,
+                   std::index_sequence<Is...>,
+                   const ArrayTuples&... arrays ) const
+    {
+        if ( sizeof...( ArrayTuples ) != _halos.size() )
+            throw std::runtime_error(
+                "Number of array tuples does not match number of halos" );
+
+        // Get the number of messages. Return if we have none.
+        int num_n = _neighbor_ranks.size();
+        if ( 0 == num_n )
+            return;
+
+        // Get the MPI communicator.
+        auto comm = _halos[0]->getComm( std::get<0>( std::get<0>(
+            std::forward_as_tuple( arrays... ) ) ) );
+
+        const auto& send_buffers =
+            is_gather ? _owned_buffers : _ghosted_buffers;
+        const auto& receive_buffers =
+            is_gather ? _ghosted_buffers : _owned_buffers;
+
+        // Post receives.
+        std::vector<MPI_Request> requests( 2 * num_n, MPI_REQUEST_NULL );
+        for ( int m = 0; m < num_n; ++m )
+            if ( 0 < receive_buffers[m].size() )
+                MPI_Irecv( receive_buffers[m].data(),
+                           receive_buffers[m].size(), MPI_BYTE,
+                           _neighbor_ranks[m], mpi_tag + _receive_tags[m],
+                           comm, &requests[m] );
+
+        // Pack the halo buffers of each message and post sends.
+        for ( int m = 0; m < num_n; ++m )
+        {
+            if ( 0 < send_buffers[m].size() )
+            {
+                for ( const auto& segment : _segments[m] )
+                    ( packSegment<Is>( exec_space, is_gather, m, segment,
+                                       arrays ),
+                      ... );
+                MPI_Isend( send_buffers[m].data(), send_buffers[m].size(),
+                           MPI_BYTE, _neighbor_ranks[m],
+                           mpi_tag + _send_tags[m], comm,
+                           &requests[num_n + m] );
+            }
+        }
+
+        // Unpack messages as they arrive.
+        bool unpack_complete = false;
+        while ( !unpack_complete )
+        {
+            int unpack_index = MPI_UNDEFINED;
+            MPI_Waitany( num_n, requests.data(), &unpack_index,
+                         MPI_STATUS_IGNORE );
+            if ( MPI_UNDEFINED == unpack_index )
+            {
+                unpack_complete = true;
+            }
+            else
+            {
+                for ( const auto& segment : _segments[unpack_index] )
+                    ( unpackSegment<Is>( exec_space, reduce_op, is_gather,
+                                         unpack_index, segment, arrays ),
+                      ... );
+            }
+        }
+
+        // Wait on send requests.
+        MPI_Waitall( num_n, requests.data() + num_n, MPI_STATUSES_IGNORE );
+    }
+
+    // Apply the boundary conditions registered with each halo.
+    template <class ExecutionSpace, std::size_t... Is, class... ArrayTuples>
+    void applyBoundaryConditions( const ExecutionSpace& exec_space,
+                                  std::index_sequence<Is...>,
+                                  const ArrayTuples&... arrays ) const
+    {
+        ( std::apply( [&]( const auto&... a )
+                      { _halos[Is]->applyBoundaryConditions( exec_space,
+                                                             a... ); },
+                      arrays ),
+          ... );
+    }
+
+    // Get a view of the part of a message belonging to a halo neighbor.
+    Kokkos::View<char*, memory_space> segmentBuffer( const bool owned,
+                                                     const int m,
+                                                     const Segment& segment,
+                                                     const std::size_t size )
+        const
+    {
+        return owned ? Kokkos::View<char*, memory_space>(
+                           _owned_buffers[m].data() + segment.owned_offset,
+                           size )
+                     : Kokkos::View<char*, memory_space>(
+                           _ghosted_buffers[m].data() + segment.ghosted_offset,
+                           size );
+    }
+
+    // Pack the send buffer of a halo neighbor if it belongs to halo I.
+    template <std::size_t I, class ExecutionSpace, class ArrayTuple>
+    void packSegment( const ExecutionSpace& exec_space, const bool is_gather,
+                      const int m, const Segment& segment,
+                      const ArrayTuple& arrays ) const
+    {
+        if ( I != segment.halo )
+            return;
+        const auto& halo = *_halos[I];
+        const auto& steering = is_gather
+                                   ? halo._owned_steering[segment.neighbor]
+                                   : halo._ghosted_steering[segment.neighbor];
+        if ( 0 == steering.extent( 0 ) )
+            return;
+        std::size_t size =
+            is_gather ? halo._owned_buffers[segment.neighbor].size()
+                      : halo._ghosted_buffers[segment.neighbor].size();
+        auto buffer = segmentBuffer( is_gather, m, segment, size );
+        std::apply( [&]( const auto&... a )
+                    { halo.packBuffer( exec_space, buffer, steering,
+                                       a.view()... ); },
+                    arrays );
+    }
+
+    // Unpack the receive buffer of a halo neighbor if it belongs to halo I.
+    template <std::size_t I, class ExecutionSpace, class ReduceOp,
+              class ArrayTuple>
+    void unpackSegment( const ExecutionSpace& exec_space,
+                        const ReduceOp& reduce_op, const bool is_gather,
+                        const int m, const Segment& segment,
+                        const ArrayTuple& arrays ) const
+    {
+        if ( I != segment.halo )
+            return;
+        const auto& halo = *_halos[I];
+        const auto& steering = is_gather
+                                   ? halo._ghosted_steering[segment.neighbor]
+                                   : halo._owned_steering[segment.neighbor];
+        if ( 0 == steering.extent( 0 ) )
+            return;
+        std::size_t size =
+            is_gather ? halo._ghosted_buffers[segment.neighbor].size()
+                      : halo._owned_buffers[segment.neighbor].size();
+        auto buffer = segmentBuffer( !is_gather, m, segment, size );
+        std::apply( [&]( const auto&... a )
+                    { halo.unpackBuffer( reduce_op, exec_space, buffer,
+                                         steering, a.view()... ); },
+                    arrays );
+    }
+
+    std::vector<std::shared_ptr<halo_type>> _halos;
+
+    // The ranks, send tags, and receive tags of each message.
+    std::vector<int> _neighbor_ranks;
+    std::vector<int> _send_tags;
+    std::vector<int> _receive_tags;
+
+    // The halo neighbor buffers aggregated in each message.
+    std::vector<std::vector<Segment>> _segments;
+
+    // Message sizes and buffers.
+    std::vector<std::size_t> _owned_bytes;
+    std::vector<std::size_t> _ghosted_bytes;
+    std::vector<Kokkos::View<char*, memory_space>> _owned_buffers;
+    std::vector<Kokkos::View<char*, memory_space>> _ghosted_buffers;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Halo group creation function.
+  \param halos The halos to exchange together.
+  \return Shared pointer to a HaloGroup.
+*/
+template <class MemorySpace>
+auto createHaloGroup(
+    const std::vector<std::shared_ptr<Halo<MemorySpace>>>& halos )
+{
+    return std::make_shared<HaloGroup<MemorySpace>>( halos );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Cajita
@@ -16,6 +16,10 @@
 #ifndef CAJITA_INTERPOLATION_HPP
 #define CAJITA_INTERPOLATION_HPP
 
+#include <Cabana_ExecutionPolicy.hpp>
+#include <Cabana_Parallel.hpp>
+#include <Cabana_Slice.hpp>
+
 #include <Cajita_Array.hpp>
 #include <Cajita_Halo.hpp>
 #include <Cajita_LocalMesh.hpp>
@@ -811,6 +815,8 @@ KOKKOS_INLINE_FUNCTION
   \tparam MemorySpace The memory space to use for interplation
   \tparam ArrayParams Parameters for the array type.
 
+  \param exec_space The execution space instance to use. Interpolation and
+  halo kernels are enqueued on this instance.
   \param array The grid array from which the point data will be interpolated.
   \param halo The halo associated with the grid array. This hallo will be used
   to gather the array data before interpolation.
@@ -830,7 +836,7 @@ template <class ExecutionSpace, class PointEvalFunctor, class PointCoordinates,
           int SplineOrder, std::size_t NumSpaceDim, class MemorySpace,
           class... ArrayParams>
 void g2p(
-    ExecutionSpace,
+    const ExecutionSpace& exec_space,
     const Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
                 ArrayParams...>& array,
     const Halo<MemorySpace>& halo, const PointCoordinates& points,
@@ -849,14 +855,14 @@ void g2p(
         createLocalMesh<MemorySpace>( *( array.layout()->localGrid() ) );
 
     // Gather data into the halo before interpolating.
-    halo.gather( ExecutionSpace(), array );
+    halo.gather( exec_space, array );
 
     // Get a view of the array data.
     auto array_view = array.view();
 
     // Loop over points and interpolate from the grid.
     Kokkos::parallel_for(
-        "g2p", Kokkos::RangePolicy<ExecutionSpace>( 0, num_point ),
+        "g2p", Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_point ),
         KOKKOS_LAMBDA( const int p ) {
             // Get the point coordinates.
             MeshScalar px[NumSpaceDim];
@@ -922,6 +928,137 @@ void g2p(
          functor );
 }
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Global Grid-to-Point interpolation with batched spline evaluation.
+
+  The spline data of the particles is first evaluated one AoSoA struct at a
+  time with evaluateSplineBatch(), which vectorizes over the lanes of each
+  struct, into batches holding the weights in structure-of-arrays layout.
+  The functor is then applied to every particle in a simd_parallel_for()
+  loading its spline data from the lane of its batch. The results match
+  g2p() with the same functor.
+
+  \tparam ExecutionSpace Kokkos execution space.
+  \tparam PointEvalFunctor Functor type used to evaluate the interpolated data
+  for a given point at a given entity.
+  \tparam PositionSliceType Cabana slice type of the particle positions.
+  \tparam ArrayScalar The scalar type used for the interpolated data.
+  \tparam MeshScalar The scalar type used for the geometry/interpolation data.
+  \tparam NumSpaceDim The spatial dimension of the mesh.
+  \tparam EntityType The entitytype to which the points will interpolate.
+  \tparam SplineOrder The order of spline interpolation to use.
+  \tparam MemorySpace The memory space to use for interplation
+  \tparam ArrayParams Parameters for the array type.
+
+  \param exec_space The execution space instance to use. Interpolation and
+  halo kernels are enqueued on this instance.
+  \param array The grid array from which the point data will be interpolated.
+  \param halo The halo associated with the grid array. This hallo will be used
+  to gather the array data before interpolation.
+  \param positions The particle positions. The subset of indices in each
+  point's interpolation stencil must be contained within the local grid that
+  will be used for the interpolation.
+  \param functor A functor that interpolates from a given entity to a given
+  point. It is called with the particle index in the slice.
+*/
+template <class ExecutionSpace, class PointEvalFunctor, class PositionSliceType,
+          class ArrayScalar, class MeshScalar, class EntityType,
+          int SplineOrder, std::size_t NumSpaceDim, class MemorySpace,
+          class... ArrayParams>
+void g2pBatch(
+    const ExecutionSpace& exec_space,
+    const Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+                ArrayParams...>& array,
+    const Halo<MemorySpace>& halo, const PositionSliceType& positions,
+    Spline<SplineOrder>, const PointEvalFunctor& functor )
+{
+    using array_type =
+        Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+              ArrayParams...>;
+    static_assert(
+        std::is_same<MemorySpace, typename array_type::memory_space>::value,
+        "Mismatching points/array memory space." );
+    static_assert( Cabana::is_slice<PositionSliceType>::value,
+                   "Positions must be a slice" );
+
+    // Create the local mesh.
+    auto local_mesh =
+        createLocalMesh<MemorySpace>( *( array.layout()->localGrid() ) );
+
+    // Gather data into the halo before interpolating.
+    halo.gather( exec_space, array );
+
+    // Get a view of the array data.
+    auto array_view = array.view();
+
+    // Evaluate the spline data of every particle struct.
+    constexpr int vector_length = PositionSliceType::vector_length;
+    using batch_type = SplineBatchData<MeshScalar, SplineOrder, NumSpaceDim,
+                                       vector_length, EntityType>;
+    Kokkos::View<batch_type*, MemorySpace> batches(
+        Kokkos::ViewAllocateWithoutInitializing( "spline_batches" ),
+        positions.numSoA() );
+    Kokkos::parallel_for(
+        "g2p_batch_splines",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                             positions.numSoA() ),
+        KOKKOS_LAMBDA( const int s ) {
+            evaluateSplineBatch( local_mesh, positions, s, batches( s ) );
+        } );
+
+    // Loop over points and interpolate from the grid.
+    Cabana::SimdPolicy<vector_length, ExecutionSpace> simd_policy(
+        exec_space, 0, positions.size() );
+    Cabana::simd_parallel_for(
+        simd_policy,
+        KOKKOS_LAMBDA( const int s, const int a ) {
+            // Get the point coordinates.
+            MeshScalar px[NumSpaceDim];
+            for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+            {
+                px[d] = positions.access( s, a, d );
+            }
+
+            // Load the local spline data.
+            using sd_type =
+                SplineData<MeshScalar, SplineOrder, NumSpaceDim, EntityType>;
+            sd_type sd;
+            loadSplineData( batches( s ), a, px, sd );
+
+            // Evaluate the functor.
+            functor( sd, s * vector_length + a, array_view );
+        },
+        "g2p_batch" );
+    exec_space.fence();
+}
+
+/*!
+  \brief Global Grid-to-Point interpolation with batched spline evaluation.
+
+  \param array The grid array from which the point data will be interpolated.
+  \param halo The halo associated with the grid array. This hallo will be used
+  to gather the array data before interpolation.
+  \param positions The particle positions.
+  \param functor A functor that interpolates from a given entity to a given
+  point.
+*/
+template <class PointEvalFunctor, class PositionSliceType, class ArrayScalar,
+          class MeshScalar, class EntityType, int SplineOrder,
+          std::size_t NumSpaceDim, class MemorySpace, class... ArrayParams>
+void g2pBatch(
+    const Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+                ArrayParams...>& array,
+    const Halo<MemorySpace>& halo, const PositionSliceType& positions,
+    Spline<SplineOrder>, const PointEvalFunctor& functor )
+{
+    using exec_space = typename Array<ArrayScalar, EntityType,
+                                      UniformMesh<MeshScalar, NumSpaceDim>,
+                                      ArrayParams...>::execution_space;
+    g2pBatch( exec_space{}, array, halo, positions, Spline<SplineOrder>{},
+              functor );
+}
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Grid-to-point scalar value functor.
@@ -1196,6 +1333,8 @@ createVectorDivergenceG2P( const ViewType& x,
   \tparam MemorySpace The memory space to use for interplation
   \tparam ArrayParams Parameters for the array type.
 
+  \param exec_space The execution space instance to use. Interpolation and
+  halo kernels are enqueued on this instance.
   \param functor A functor that interpolates from a given point to a given
   entity.
   \param points The points over which to perform the interpolation. Will be
@@ -1214,7 +1353,7 @@ template <class ExecutionSpace, class PointEvalFunctor, class PointCoordinates,
           class ArrayScalar, class MeshScalar, std::size_t NumSpaceDim,
           class EntityType, int SplineOrder, class MemorySpace,
           class... ArrayParams>
-void p2g( ExecutionSpace, const PointEvalFunctor& functor,
+void p2g( const ExecutionSpace& exec_space, const PointEvalFunctor& functor,
           const PointCoordinates& points, const std::size_t num_point,
           Spline<SplineOrder>, const Halo<MemorySpace>& halo,
           Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
@@ -1237,7 +1376,7 @@ void p2g( ExecutionSpace, const PointEvalFunctor& functor,
 
     // Loop over points and interpolate to the grid.
     Kokkos::parallel_for(
-        "p2g", Kokkos::RangePolicy<ExecutionSpace>( 0, num_point ),
+        "p2g", Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_point ),
         KOKKOS_LAMBDA( const int p ) {
             // Get the point coordinates.
             MeshScalar px[NumSpaceDim];
@@ -1255,11 +1394,11 @@ void p2g( ExecutionSpace, const PointEvalFunctor& functor,
             // Evaluate the functor.
             functor( sd, p, array_sv );
         } );
-    Kokkos::Experimental::contribute( array_view, array_sv );
+    Kokkos::Experimental::contribute( exec_space, array_view, array_sv );
 
     // Scatter interpolation contributions in the halo back to their owning
     // ranks.
-    halo.scatter( ExecutionSpace(), ScatterReduce::Sum(), array );
+    halo.scatter( exec_space, ScatterReduce::Sum(), array );
 }
 
 /*!
@@ -1307,6 +1446,143 @@ void p2g( const PointEvalFunctor& functor, const PointCoordinates& points,
          array );
 }
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Global Point-to-Grid interpolation with batched spline evaluation.
+
+  The spline data of the particles is first evaluated one AoSoA struct at a
+  time with evaluateSplineBatch(), which vectorizes over the lanes of each
+  struct, into batches holding the weights in structure-of-arrays layout.
+  The functor is then applied to every particle in a simd_parallel_for()
+  loading its spline data from the lane of its batch. The lanes of a struct
+  may contribute to the same entities so contributions are atomic. The
+  results match p2g() with the same functor up to the order of summation.
+
+  \tparam ExecutionSpace Kokkos execution space.
+  \tparam PointEvalFunctor Functor type used to evaluate the interpolated data
+  for a given point at a given entity.
+  \tparam PositionSliceType Cabana slice type of the particle positions.
+  \tparam ArrayScalar The scalar type used for the interpolated data.
+  \tparam MeshScalar The scalar type used for the geometry/interpolation data.
+  \tparam NumSpaceDim The spatial dimension of the mesh.
+  \tparam EntityType The entitytype to which the points will interpolate.
+  \tparam SplineOrder The order of spline interpolation to use.
+  \tparam MemorySpace The memory space to use for interplation
+  \tparam ArrayParams Parameters for the array type.
+
+  \param exec_space The execution space instance to use. Interpolation and
+  halo kernels are enqueued on this instance.
+  \param functor A functor that interpolates from a given point to a given
+  entity. It is called with the particle index in the slice.
+  \param positions The particle positions. The subset of indices in each
+  point's interpolation stencil must be contained within the local grid that
+  will be used for the interpolation.
+  \param halo The halo associated with the grid array. This hallo will be used
+  to scatter the interpolated data.
+  \param array The grid array to which the point data will be interpolated.
+*/
+template <class ExecutionSpace, class PointEvalFunctor, class PositionSliceType,
+          class ArrayScalar, class MeshScalar, std::size_t NumSpaceDim,
+          class EntityType, int SplineOrder, class MemorySpace,
+          class... ArrayParams>
+void p2gBatch(
+    const ExecutionSpace& exec_space, const PointEvalFunctor& functor,
+    const PositionSliceType& positions, Spline<SplineOrder>,
+    const Halo<MemorySpace>& halo,
+    Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+          ArrayParams...>& array )
+{
+    using array_type =
+        Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+              ArrayParams...>;
+    static_assert(
+        std::is_same<MemorySpace, typename array_type::memory_space>::value,
+        "Mismatching points/array memory space." );
+    static_assert( Cabana::is_slice<PositionSliceType>::value,
+                   "Positions must be a slice" );
+
+    // Create the local mesh.
+    auto local_mesh =
+        createLocalMesh<MemorySpace>( *( array.layout()->localGrid() ) );
+
+    // Create an atomic scatter view of the array.
+    auto array_view = array.view();
+    auto array_sv = Kokkos::Experimental::create_scatter_view<
+        Kokkos::Experimental::ScatterSum,
+        Kokkos::Experimental::ScatterNonDuplicated,
+        Kokkos::Experimental::ScatterAtomic>( array_view );
+
+    // Evaluate the spline data of every particle struct.
+    constexpr int vector_length = PositionSliceType::vector_length;
+    using batch_type = SplineBatchData<MeshScalar, SplineOrder, NumSpaceDim,
+                                       vector_length, EntityType>;
+    Kokkos::View<batch_type*, MemorySpace> batches(
+        Kokkos::ViewAllocateWithoutInitializing( "spline_batches" ),
+        positions.numSoA() );
+    Kokkos::parallel_for(
+        "p2g_batch_splines",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                             positions.numSoA() ),
+        KOKKOS_LAMBDA( const int s ) {
+            evaluateSplineBatch( local_mesh, positions, s, batches( s ) );
+        } );
+
+    // Loop over points and interpolate to the grid.
+    Cabana::SimdPolicy<vector_length, ExecutionSpace> simd_policy(
+        exec_space, 0, positions.size() );
+    Cabana::simd_parallel_for(
+        simd_policy,
+        KOKKOS_LAMBDA( const int s, const int a ) {
+            // Get the point coordinates.
+            MeshScalar px[NumSpaceDim];
+            for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+            {
+                px[d] = positions.access( s, a, d );
+            }
+
+            // Load the local spline data.
+            using sd_type =
+                SplineData<MeshScalar, SplineOrder, NumSpaceDim, EntityType>;
+            sd_type sd;
+            loadSplineData( batches( s ), a, px, sd );
+
+            // Evaluate the functor.
+            functor( sd, s * vector_length + a, array_sv );
+        },
+        "p2g_batch" );
+    Kokkos::Experimental::contribute( exec_space, array_view, array_sv );
+
+    // Scatter interpolation contributions in the halo back to their owning
+    // ranks.
+    halo.scatter( exec_space, ScatterReduce::Sum(), array );
+}
+
+/*!
+  \brief Global Point-to-Grid interpolation with batched spline evaluation.
+
+  \param functor A functor that interpolates from a given point to a given
+  entity.
+  \param positions The particle positions.
+  \param halo The halo associated with the grid array. This hallo will be used
+  to scatter the interpolated data.
+  \param array The grid array to which the point data will be interpolated.
+*/
+template <class PointEvalFunctor, class PositionSliceType, class ArrayScalar,
+          class MeshScalar, std::size_t NumSpaceDim, class EntityType,
+          int SplineOrder, class MemorySpace, class... ArrayParams>
+void p2gBatch(
+    const PointEvalFunctor& functor, const PositionSliceType& positions,
+    Spline<SplineOrder>, const Halo<MemorySpace>& halo,
+    Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+          ArrayParams...>& array )
+{
+    using exec_space = typename Array<ArrayScalar, EntityType,
+                                      UniformMesh<MeshScalar, NumSpaceDim>,
+                                      ArrayParams...>::execution_space;
+    p2gBatch( exec_space{}, functor, positions, Spline<SplineOrder>{}, halo,
+              array );
+}
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Point-to-grid scalar value functor.
@@ -323,9 +323,17 @@ class LocalMesh<MemorySpace, NonUniformMesh<Scalar, NumSpaceDim>>
     //! Default execution space.
     using execution_space = typename memory_space::execution_space;
 
-    //! Constructor.
+    /*!
+      \brief Constructor.
+      \param local_grid The local grid.
+      \param cache_metrics If true, precompute the cell widths, inverse cell
+      widths, and cell centers in each dimension such that metric queries in
+      kernels are single loads rather than computed from the edges.
+    */
     LocalMesh(
-        const LocalGrid<NonUniformMesh<Scalar, num_space_dim>>& local_grid )
+        const LocalGrid<NonUniformMesh<Scalar, num_space_dim>>& local_grid,
+        const bool cache_metrics = false )
+        : _cache_metrics( cache_metrics )
     {
         const auto& global_grid = local_grid.globalGrid();
         const auto& global_mesh = global_grid.globalMesh();
@@ -516,6 +524,38 @@ class LocalMesh<MemorySpace, NonUniformMesh<Scalar, NumSpaceDim>>
 
             // Copy edges to the device.
             Kokkos::deep_copy( _local_edges[d], edge_mirror );
+
+            // Compute the cell metrics of this dimension from the edges.
+            if ( _cache_metrics )
+            {
+                _cell_widths[d] = Kokkos::View<Scalar*, MemorySpace>(
+                    Kokkos::ViewAllocateWithoutInitializing( "cell_widths" ),
+                    nedge - 1 );
+                _inv_cell_widths[d] = Kokkos::View<Scalar*, MemorySpace>(
+                    Kokkos::ViewAllocateWithoutInitializing(
+                        "inv_cell_widths" ),
+                    nedge - 1 );
+                _cell_centers[d] = Kokkos::View<Scalar*, MemorySpace>(
+                    Kokkos::ViewAllocateWithoutInitializing( "cell_centers" ),
+                    nedge - 1 );
+                auto width_mirror = Kokkos::create_mirror_view(
+                    Kokkos::HostSpace(), _cell_widths[d] );
+                auto inv_width_mirror = Kokkos::create_mirror_view(
+                    Kokkos::HostSpace(), _inv_cell_widths[d] );
+                auto center_mirror = Kokkos::create_mirror_view(
+                    Kokkos::HostSpace(), _cell_centers[d] );
+                for ( int n = 0; n < nedge - 1; ++n )
+                {
+                    width_mirror( n ) = edge_mirror( n + 1 ) - edge_mirror( n );
+                    inv_width_mirror( n ) = Scalar( 1.0 ) / width_mirror( n );
+                    center_mirror( n ) =
+                        ( edge_mirror( n + 1 ) + edge_mirror( n ) ) /
+                        Scalar( 2.0 );
+                }
+                Kokkos::deep_copy( _cell_widths[d], width_mirror );
+                Kokkos::deep_copy( _inv_cell_widths[d], inv_width_mirror );
+                Kokkos::deep_copy( _cell_centers[d], center_mirror );
+            }
         }
 
         // Periodicity
@@ -535,6 +575,54 @@ class LocalMesh<MemorySpace, NonUniformMesh<Scalar, NumSpaceDim>>
     KOKKOS_INLINE_FUNCTION
     bool isPeriodic( const int dim ) const { return _periodic[dim]; }
 
+    //! Determine if the cell metrics have been precomputed.
+    KOKKOS_INLINE_FUNCTION
+    bool hasMetricCache() const { return _cache_metrics; }
+
+    /*!
+      \brief Get the width of a cell in a given dimension.
+      \param dim Spatial dimension.
+      \param index Local cell index in that dimension relative to the ghosted
+      decomposition of the mesh block.
+    */
+    KOKKOS_INLINE_FUNCTION
+    Scalar cellWidth( const int dim, const int index ) const
+    {
+        return _cache_metrics ? _cell_widths[dim]( index )
+                              : _local_edges[dim]( index + 1 ) -
+                                    _local_edges[dim]( index );
+    }
+
+    /*!
+      \brief Get the inverse width of a cell in a given dimension.
+      \param dim Spatial dimension.
+      \param index Local cell index in that dimension relative to the ghosted
+      decomposition of the mesh block.
+    */
+    KOKKOS_INLINE_FUNCTION
+    Scalar inverseCellWidth( const int dim, const int index ) const
+    {
+        return _cache_metrics
+                   ? _inv_cell_widths[dim]( index )
+                   : Scalar( 1.0 ) / ( _local_edges[dim]( index + 1 ) -
+                                       _local_edges[dim]( index ) );
+    }
+
+    /*!
+      \brief Get the center coordinate of a cell in a given dimension.
+      \param dim Spatial dimension.
+      \param index Local cell index in that dimension relative to the ghosted
+      decomposition of the mesh block.
+    */
+    KOKKOS_INLINE_FUNCTION
+    Scalar cellCenter( const int dim, const int index ) const
+    {
+        return _cache_metrics ? _cell_centers[dim]( index )
+                              : ( _local_edges[dim]( index + 1 ) +
+                                  _local_edges[dim]( index ) ) /
+                                    Scalar( 2.0 );
+    }
+
     //! Determine if this block is on a low boundary in the given dimension.
     //! \param dim Spatial dimension.
     KOKKOS_INLINE_FUNCTION
@@ -601,9 +689,7 @@ class LocalMesh<MemorySpace, NonUniformMesh<Scalar, NumSpaceDim>>
                                              Scalar x[num_space_dim] ) const
     {
         for ( std::size_t d = 0; d < num_space_dim; ++d )
-            x[d] = ( _local_edges[d]( index[d] + 1 ) +
-                     _local_edges[d]( index[d] ) ) /
-                   Scalar( 2.0 );
+            x[d] = cellCenter( d, index[d] );
     }
 
     /*!
@@ -638,9 +724,7 @@ class LocalMesh<MemorySpace, NonUniformMesh<Scalar, NumSpaceDim>>
             if ( Dir == d )
                 x[d] = _local_edges[d]( index[d] );
             else
-                x[d] = ( _local_edges[d]( index[d] + 1 ) +
-                         _local_edges[d]( index[d] ) ) /
-                       Scalar( 2.0 );
+                x[d] = cellCenter( d, index[d] );
     }
 
     /*!
@@ -655,9 +739,7 @@ class LocalMesh<MemorySpace, NonUniformMesh<Scalar, NumSpaceDim>>
     {
         for ( std::size_t d = 0; d < 3; ++d )
             if ( Dir == d )
-                x[d] = ( _local_edges[d]( index[d] + 1 ) +
-                         _local_edges[d]( index[d] ) ) /
-                       Scalar( 2.0 );
+                x[d] = cellCenter( d, index[d] );
             else
                 x[d] = _local_edges[d]( index[d] );
     }
@@ -681,8 +763,7 @@ class LocalMesh<MemorySpace, NonUniformMesh<Scalar, NumSpaceDim>>
     KOKKOS_INLINE_FUNCTION std::enable_if_t<3 == NSD, Scalar>
     measure( Edge<Dir>, const Integer index[3] ) const
     {
-        return _local_edges[Dir][index[Dir] + 1] -
-               _local_edges[Dir][index[Dir]];
+        return cellWidth( Dir, index[Dir] );
     }
 
     /*!
@@ -733,8 +814,7 @@ class LocalMesh<MemorySpace, NonUniformMesh<Scalar, NumSpaceDim>>
     KOKKOS_INLINE_FUNCTION std::enable_if_t<2 == NSD, Scalar>
     measure( Face<Dim::I>, const Integer index[2] ) const
     {
-        return _local_edges[Dim::J][index[Dim::J] + 1] -
-               _local_edges[Dim::J][index[Dim::J]];
+        return cellWidth( Dim::J, index[Dim::J] );
     }
 
     /*!
@@ -746,8 +826,7 @@ class LocalMesh<MemorySpace, NonUniformMesh<Scalar, NumSpaceDim>>
     KOKKOS_INLINE_FUNCTION std::enable_if_t<2 == NSD, Scalar>
     measure( Face<Dim::J>, const Integer index[2] ) const
     {
-        return _local_edges[Dim::I][index[Dim::I] + 1] -
-               _local_edges[Dim::I][index[Dim::I]];
+        return cellWidth( Dim::I, index[Dim::I] );
     }
 
     /*!
@@ -761,7 +840,7 @@ class LocalMesh<MemorySpace, NonUniformMesh<Scalar, NumSpaceDim>>
     {
         Scalar m = 1.0;
         for ( std::size_t d = 0; d < num_space_dim; ++d )
-            m *= _local_edges[d][index[d] + 1] - _local_edges[d][index[d]];
+            m *= cellWidth( d, index[d] );
         return m;
     }
 
@@ -772,6 +851,13 @@ class LocalMesh<MemorySpace, NonUniformMesh<Scalar, NumSpaceDim>>
     Kokkos::Array<Scalar, num_space_dim> _ghost_high_corner;
     Kokkos::Array<Kokkos::View<Scalar*, MemorySpace>, num_space_dim>
         _local_edges;
+    bool _cache_metrics;
+    Kokkos::Array<Kokkos::View<Scalar*, MemorySpace>, num_space_dim>
+        _cell_widths;
+    Kokkos::Array<Kokkos::View<Scalar*, MemorySpace>, num_space_dim>
+        _inv_cell_widths;
+    Kokkos::Array<Kokkos::View<Scalar*, MemorySpace>, num_space_dim>
+        _cell_centers;
     Kokkos::Array<bool, num_space_dim> _periodic;
     Kokkos::Array<bool, num_space_dim> _boundary_lo;
     Kokkos::Array<bool, num_space_dim> _boundary_hi;
@@ -789,6 +875,23 @@ createLocalMesh( const LocalGrid<MeshType>& local_grid )
     return LocalMesh<MemorySpace, MeshType>( local_grid );
 }
 
+/*!
+  \brief Creation function for non-uniform local mesh with optionally
+  precomputed cell metrics.
+  \param local_grid The local grid.
+  \param cache_metrics If true, precompute the cell widths, inverse cell
+  widths, and cell centers.
+  \return LocalMesh
+*/
+template <class MemorySpace, class Scalar, std::size_t NumSpaceDim>
+LocalMesh<MemorySpace, NonUniformMesh<Scalar, NumSpaceDim>> createLocalMesh(
+    const LocalGrid<NonUniformMesh<Scalar, NumSpaceDim>>& local_grid,
+    const bool cache_metrics )
+{
+    return LocalMesh<MemorySpace, NonUniformMesh<Scalar, NumSpaceDim>>(
+        local_grid, cache_metrics );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Cajita
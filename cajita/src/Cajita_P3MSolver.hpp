@@ -0,0 +1,682 @@
+/****************************************************************************
+ * Copyright (c) 2018-2023 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cajita_P3MSolver.hpp
+  \brief Particle-particle particle-mesh (P3M) electrostatics
+*/
+#ifndef CAJITA_P3MSOLVER_HPP
+#define CAJITA_P3MSOLVER_HPP
+
+#include <Cajita_Array.hpp>
+#include <Cajita_FastFourierTransform.hpp>
+#include <Cajita_Halo.hpp>
+#include <Cajita_Interpolation.hpp>
+#include <Cajita_LocalGrid.hpp>
+#include <Cajita_Splines.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Cabana_NeighborList.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace Cajita
+{
+namespace Experimental
+{
+//---------------------------------------------------------------------------//
+// Differentiation tags.
+//---------------------------------------------------------------------------//
+/*!
+  \brief Compute the mesh field with ik differentiation in Fourier space.
+  Requires three reverse transforms per solve.
+*/
+struct P3MIkDifferentiation
+{
+};
+
+/*!
+  \brief Compute the mesh field by analytically differentiating the
+  interpolation spline of the mesh potential. Requires one reverse transform
+  per solve.
+*/
+struct P3MAnalyticalDifferentiation
+{
+};
+
+//---------------------------------------------------------------------------//
+namespace Impl
+{
+//! \cond Impl
+// Assign particle charge density to the mesh.
+template <class ChargeType>
+struct P3MChargeP2G
+{
+    ChargeType _q;
+    double _inv_volume;
+
+    template <class SplineDataType, class GridViewType>
+    KOKKOS_INLINE_FUNCTION void operator()( const SplineDataType& sd,
+                                            const int p,
+                                            const GridViewType& view ) const
+    {
+        double rho = _q( p ) * _inv_volume;
+        P2G::value( rho, sd, view );
+    }
+};
+
+// Interpolate the mesh field to the particles and add the force.
+template <class ChargeType, class ForceType>
+struct P3MFieldG2P
+{
+    ChargeType _q;
+    ForceType _f;
+
+    template <class SplineDataType, class GridViewType>
+    KOKKOS_INLINE_FUNCTION void operator()( const SplineDataType& sd,
+                                            const int p,
+                                            const GridViewType& view ) const
+    {
+        double e[3];
+        G2P::value( view, sd, e );
+        for ( int d = 0; d < 3; ++d )
+            _f( p, d ) += _q( p ) * e[d];
+    }
+};
+
+// Interpolate the mesh potential gradient to the particles and add the force.
+template <class ChargeType, class ForceType>
+struct P3MPotentialGradientG2P
+{
+    ChargeType _q;
+    ForceType _f;
+
+    template <class SplineDataType, class GridViewType>
+    KOKKOS_INLINE_FUNCTION void operator()( const SplineDataType& sd,
+                                            const int p,
+                                            const GridViewType& view ) const
+    {
+        double grad[3];
+        G2P::gradient( view, sd, grad );
+        for ( int d = 0; d < 3; ++d )
+            _f( p, d ) -= _q( p ) * grad[d];
+    }
+};
+
+// Fourier transform of the charge assignment function of a spline.
+template <int SplineOrder>
+KOKKOS_INLINE_FUNCTION double p3mAssignmentTransform( const double k,
+                                                      const double h )
+{
+    double x = 0.5 * k * h;
+    double sinc = ( x == 0.0 ) ? 1.0 : Kokkos::sin( x ) / x;
+    double u = 1.0;
+    for ( int n = 0; n < SplineOrder + 1; ++n )
+        u *= sinc;
+    return u;
+}
+//! \endcond
+} // namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Particle-particle particle-mesh (P3M) solver for the electrostatic
+  interactions of point charges in a fully periodic 3D domain.
+
+  The Coulomb interaction q_i q_j / r is split with an Ewald splitting
+  parameter alpha. The short-range part is summed directly over a Cabana
+  neighbor list. The long-range part is computed on the distributed Cajita
+  grid: charges are assigned to the cells with a B-spline of the given order,
+  the density is transformed with heFFTe, multiplied by the Hockney-Eastwood
+  optimal influence function for the given assignment order and
+  differentiation scheme, and the resulting field is interpolated back to the
+  particles with the same spline.
+
+  All energies and forces are in Gaussian units (the Coulomb constant is 1).
+
+  \tparam MemorySpace Kokkos memory space of the particle and grid data.
+  \tparam SplineOrder Charge assignment spline order.
+  \tparam DifferentiationType Either P3MIkDifferentiation or
+  P3MAnalyticalDifferentiation.
+*/
+template <class MemorySpace, int SplineOrder,
+          class DifferentiationType = P3MIkDifferentiation>
+class P3MSolver
+{
+  public:
+    //! Kokkos memory space.
+    using memory_space = MemorySpace;
+    static_assert( Kokkos::is_memory_space<MemorySpace>(),
+                   "P3MSolver requires a Kokkos memory space" );
+    //! Kokkos execution space.
+    using execution_space = typename memory_space::execution_space;
+    //! Mesh type.
+    using mesh_type = UniformMesh<double, 3>;
+    //! Charge assignment spline.
+    using spline_type = Spline<SplineOrder>;
+    //! Differentiation scheme.
+    using differentiation_type = DifferentiationType;
+
+    static_assert(
+        std::is_same<DifferentiationType, P3MIkDifferentiation>::value ||
+            std::is_same<DifferentiationType,
+                         P3MAnalyticalDifferentiation>::value,
+        "Unknown P3M differentiation type" );
+    static_assert( SplineOrder > 0 ||
+                       std::is_same<DifferentiationType,
+                                    P3MIkDifferentiation>::value,
+                   "Analytical differentiation requires a spline order > 0" );
+
+    /*!
+      \brief Constructor.
+      \param local_grid The local grid. The grid must be periodic in every
+      dimension and have a halo wide enough for the assignment spline.
+      \param alpha The Ewald splitting parameter.
+      \param r_cut The cutoff of the short-range interactions.
+    */
+    P3MSolver( const std::shared_ptr<LocalGrid<mesh_type>>& local_grid,
+               const double alpha, const double r_cut )
+        : _local_grid( local_grid )
+        , _alpha( alpha )
+        , _r_cut( r_cut )
+    {
+        const auto& global_grid = _local_grid->globalGrid();
+        for ( int d = 0; d < 3; ++d )
+            if ( !global_grid.isPeriodic( d ) )
+                throw std::runtime_error(
+                    "P3MSolver requires a periodic grid in every dimension" );
+        if ( _local_grid->haloCellWidth() < haloWidth() )
+            throw std::runtime_error(
+                "P3MSolver grid halo is too narrow for the spline order" );
+
+        // Create the mesh arrays.
+        auto scalar_layout = createArrayLayout( _local_grid, 1, Cell() );
+        auto complex_layout = createArrayLayout( _local_grid, 2, Cell() );
+        auto vector_layout = createArrayLayout( _local_grid, 3, Cell() );
+        _rho = createArray<double, memory_space>( "p3m_rho", scalar_layout );
+        _phi = createArray<double, memory_space>( "p3m_phi", scalar_layout );
+        _rho_hat = createArray<double, memory_space>( "p3m_rho_hat",
+                                                      complex_layout );
+        _work =
+            createArray<double, memory_space>( "p3m_work", complex_layout );
+        _field =
+            createArray<double, memory_space>( "p3m_field", vector_layout );
+        _influence = createArray<double, memory_space>( "p3m_influence",
+                                                        scalar_layout );
+        _derivative = createArray<double, memory_space>( "p3m_derivative",
+                                                         vector_layout );
+
+        // Create the halos.
+        _scalar_halo = createHalo( NodeHaloPattern<3>(), haloWidth(), *_rho );
+        _vector_halo =
+            createHalo( NodeHaloPattern<3>(), haloWidth(), *_field );
+
+        // Create the transform.
+        _fft = createHeffteFastFourierTransform<double, memory_space>(
+            *complex_layout );
+
+        computeInfluenceFunction();
+    }
+
+    //! Get the Ewald splitting parameter.
+    double alpha() const { return _alpha; }
+
+    //! Get the short-range cutoff.
+    double cutoff() const { return _r_cut; }
+
+    //! Get the grid halo width required by the assignment spline.
+    static constexpr int haloWidth() { return ( SplineOrder + 2 ) / 2; }
+
+    /*!
+      \brief Compute the long-range (mesh) energy and forces.
+
+      The long-range forces are added to the given forces. The returned energy
+      is the global long-range energy including the self-energy and neutralizing
+      background corrections.
+
+      The mesh kernels run on the given instance. The FFTs run on the default
+      instance of the execution space and are ordered against the given
+      instance with fences.
+
+      \param exec_space The execution space instance.
+      \param positions Particle positions. Every particle must be in the owned
+      domain of the local grid.
+      \param charges Particle charges.
+      \param forces Particle forces.
+      \param num_particle The number of particles.
+      \return The global long-range energy.
+    */
+    template <class ExecutionSpace, class PositionSliceType,
+              class ChargeSliceType, class ForceSliceType>
+    double computeLongRange( const ExecutionSpace& exec_space,
+                             const PositionSliceType& positions,
+                             const ChargeSliceType& charges,
+                             const ForceSliceType& forces,
+                             const std::size_t num_particle )
+    {
+        Kokkos::Profiling::pushRegion( "Cajita::P3MSolver::computeLongRange" );
+
+        const auto& global_grid = _local_grid->globalGrid();
+        const auto& global_mesh = global_grid.globalMesh();
+        double cell_volume = 1.0;
+        for ( int d = 0; d < 3; ++d )
+            cell_volume *= global_mesh.cellSize( d );
+
+        // Assign the charge density to the mesh.
+        ArrayOp::assign( exec_space, *_rho, 0.0, Ghost() );
+        Impl::P3MChargeP2G<ChargeSliceType> charge_p2g{ charges,
+                                                       1.0 / cell_volume };
+        p2g( exec_space, charge_p2g, positions, num_particle, spline_type(),
+             *_scalar_halo, *_rho );
+
+        // Transform the density.
+        auto own_space = _local_grid->indexSpace( Own(), Cell(), Local() );
+        auto rho = _rho->view();
+        auto rho_hat = _rho_hat->view();
+        Kokkos::parallel_for(
+            "Cajita::P3MSolver::copyDensity",
+            createExecutionPolicy( own_space, exec_space ),
+            KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+                rho_hat( i, j, k, 0 ) = rho( i, j, k, 0 );
+                rho_hat( i, j, k, 1 ) = 0.0;
+            } );
+        exec_space.fence();
+        _fft->forward( *_rho_hat, FFTScaleNone() );
+        execution_space().fence();
+
+        // Compute the reciprocal space energy.
+        auto influence = _influence->view();
+        double energy = 0.0;
+        Kokkos::parallel_reduce(
+            "Cajita::P3MSolver::energy",
+            createExecutionPolicy( own_space, exec_space ),
+            KOKKOS_LAMBDA( const int i, const int j, const int k,
+                           double& result ) {
+                result += influence( i, j, k, 0 ) *
+                          ( rho_hat( i, j, k, 0 ) * rho_hat( i, j, k, 0 ) +
+                            rho_hat( i, j, k, 1 ) * rho_hat( i, j, k, 1 ) );
+            },
+            energy );
+
+        // Compute the total charge and the sum of squared charges.
+        double q_sum = 0.0;
+        Kokkos::parallel_reduce(
+            "Cajita::P3MSolver::chargeSum",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_particle ),
+            KOKKOS_LAMBDA( const int p, double& result ) {
+                result += charges( p );
+            },
+            q_sum );
+        double q2_sum = 0.0;
+        Kokkos::parallel_reduce(
+            "Cajita::P3MSolver::chargeSquaredSum",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_particle ),
+            KOKKOS_LAMBDA( const int p, double& result ) {
+                result += charges( p ) * charges( p );
+            },
+            q2_sum );
+
+        // Reduce the energy and charges.
+        double local_sums[3] = { energy, q_sum, q2_sum };
+        double global_sums[3];
+        MPI_Allreduce( local_sums, global_sums, 3, MPI_DOUBLE, MPI_SUM,
+                       global_grid.comm() );
+        double num_cell = 1.0;
+        double volume = 1.0;
+        for ( int d = 0; d < 3; ++d )
+        {
+            num_cell *= global_grid.globalNumEntity( Cell(), d );
+            volume *= global_mesh.extent( d );
+        }
+        energy = 0.5 * cell_volume * global_sums[0] / num_cell -
+                 _alpha * global_sums[2] / std::sqrt( M_PI ) -
+                 0.5 * M_PI * global_sums[1] * global_sums[1] /
+                     ( volume * _alpha * _alpha );
+
+        // Compute the forces.
+        interpolateForces( exec_space, positions, charges, forces,
+                           num_particle, differentiation_type() );
+
+        Kokkos::Profiling::popRegion();
+        return energy;
+    }
+
+    /*!
+      \brief Compute the long-range (mesh) energy and forces on the default
+      execution space instance.
+
+      \param positions Particle positions. Every particle must be in the owned
+      domain of the local grid.
+      \param charges Particle charges.
+      \param forces Particle forces.
+      \param num_particle The number of particles.
+      \return The global long-range energy.
+    */
+    template <class PositionSliceType, class ChargeSliceType,
+              class ForceSliceType>
+    double computeLongRange( const PositionSliceType& positions,
+                             const ChargeSliceType& charges,
+                             const ForceSliceType& forces,
+                             const std::size_t num_particle )
+    {
+        return computeLongRange( execution_space(), positions, charges, forces,
+                                 num_particle );
+    }
+
+    /*!
+      \brief Compute the short-range (real space) energy and forces.
+
+      The short-range forces of the first num_particle particles are added to
+      the given forces. The neighbor list must be a full list built over the
+      local particles and their ghosts (e.g. gathered with a
+      ParticleGridHalo) with a cutoff of at least the solver cutoff.
+
+      \param exec_space The execution space instance.
+      \param neighbors The full neighbor list.
+      \param positions Particle positions, including ghosts.
+      \param charges Particle charges, including ghosts.
+      \param forces Particle forces.
+      \param num_particle The number of local particles.
+      \return The global short-range energy.
+    */
+    template <class ExecutionSpace, class NeighborListType,
+              class PositionSliceType, class ChargeSliceType,
+              class ForceSliceType>
+    double computeShortRange( const ExecutionSpace& exec_space,
+                              const NeighborListType& neighbors,
+                              const PositionSliceType& positions,
+                              const ChargeSliceType& charges,
+                              const ForceSliceType& forces,
+                              const std::size_t num_particle ) const
+    {
+        Kokkos::Profiling::pushRegion(
+            "Cajita::P3MSolver::computeShortRange" );
+
+        using list_traits = Cabana::NeighborList<NeighborListType>;
+        double alpha = _alpha;
+        double rc2 = _r_cut * _r_cut;
+        double two_alpha_over_sqrt_pi = 2.0 * _alpha / std::sqrt( M_PI );
+        double energy = 0.0;
+        Kokkos::parallel_reduce(
+            "Cajita::P3MSolver::shortRange",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_particle ),
+            KOKKOS_LAMBDA( const int i, double& result ) {
+                double f_i[3] = { 0.0, 0.0, 0.0 };
+                int num_n = list_traits::numNeighbor( neighbors, i );
+                for ( int n = 0; n < num_n; ++n )
+                {
+                    int j = list_traits::getNeighbor( neighbors, i, n );
+                    double dx[3];
+                    double r2 = 0.0;
+                    for ( int d = 0; d < 3; ++d )
+                    {
+                        dx[d] = positions( i, d ) - positions( j, d );
+                        r2 += dx[d] * dx[d];
+                    }
+                    if ( r2 < rc2 && r2 > 0.0 )
+                    {
+                        double r = Kokkos::sqrt( r2 );
+                        double qq = charges( i ) * charges( j );
+                        double e = qq * Kokkos::erfc( alpha * r ) / r;
+                        result += 0.5 * e;
+                        double f_over_r =
+                            ( e + qq * two_alpha_over_sqrt_pi *
+                                      Kokkos::exp( -alpha * alpha * r2 ) ) /
+                            r2;
+                        for ( int d = 0; d < 3; ++d )
+                            f_i[d] += f_over_r * dx[d];
+                    }
+                }
+                for ( int d = 0; d < 3; ++d )
+                    forces( i, d ) += f_i[d];
+            },
+            energy );
+
+        double global_energy;
+        MPI_Allreduce( &energy, &global_energy, 1, MPI_DOUBLE, MPI_SUM,
+                       _local_grid->globalGrid().comm() );
+
+        Kokkos::Profiling::popRegion();
+        return global_energy;
+    }
+
+  private:
+    // Compute the optimal influence function and the Fourier space derivative
+    // operator.
+    void computeInfluenceFunction()
+    {
+        const auto& global_grid = _local_grid->globalGrid();
+        const auto& global_mesh = global_grid.globalMesh();
+        auto own_space = _local_grid->indexSpace( Own(), Cell(), Local() );
+
+        Kokkos::Array<int, 3> num_cell;
+        Kokkos::Array<int, 3> offset;
+        Kokkos::Array<double, 3> length;
+        Kokkos::Array<double, 3> h;
+        for ( int d = 0; d < 3; ++d )
+        {
+            num_cell[d] = global_grid.globalNumEntity( Cell(), d );
+            offset[d] = global_grid.globalOffset( d ) - own_space.min( d );
+            length[d] = global_mesh.extent( d );
+            h[d] = global_mesh.cellSize( d );
+        }
+
+        constexpr bool use_ik =
+            std::is_same<DifferentiationType, P3MIkDifferentiation>::value;
+        double alpha = _alpha;
+        auto influence = _influence->view();
+        auto derivative = _derivative->view();
+        Kokkos::parallel_for(
+            "Cajita::P3MSolver::influenceFunction",
+            createExecutionPolicy( own_space, execution_space() ),
+            KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+                const double two_pi = 2.0 * M_PI;
+                int idx[3] = { i, j, k };
+
+                // Wave vector and derivative operator of this mode. The
+                // derivative of the Nyquist mode is zero.
+                double kv[3];
+                double dv[3];
+                double d2 = 0.0;
+                for ( int d = 0; d < 3; ++d )
+                {
+                    int g = idx[d] + offset[d];
+                    int m = ( 2 * g < num_cell[d] ) ? g : g - num_cell[d];
+                    kv[d] = two_pi * m / length[d];
+                    dv[d] = ( 2 * g == num_cell[d] ) ? 0.0 : kv[d];
+                    derivative( i, j, k, d ) = dv[d];
+                    d2 += dv[d] * dv[d];
+                }
+
+                // Sum the aliased reference interaction.
+                double numerator = 0.0;
+                double u2_sum = 0.0;
+                for ( int mx = -2; mx <= 2; ++mx )
+                    for ( int my = -2; my <= 2; ++my )
+                        for ( int mz = -2; mz <= 2; ++mz )
+                        {
+                            int mv[3] = { mx, my, mz };
+                            double km[3];
+                            double km2 = 0.0;
+                            double dot = 0.0;
+                            double u = 1.0;
+                            for ( int d = 0; d < 3; ++d )
+                            {
+                                km[d] = kv[d] + two_pi * mv[d] / h[d];
+                                km2 += km[d] * km[d];
+                                dot += dv[d] * km[d];
+                                u *= Impl::p3mAssignmentTransform<SplineOrder>(
+                                    km[d], h[d] );
+                            }
+                            double u2 = u * u;
+                            u2_sum += u2;
+                            if ( km2 > 0.0 )
+                            {
+                                double ref = 4.0 * M_PI *
+                                             Kokkos::exp( -0.25 * km2 /
+                                                          ( alpha * alpha ) ) /
+                                             km2;
+                                numerator += use_ik ? u2 * dot * ref : u2 * ref;
+                            }
+                        }
+
+                // Optimal influence function.
+                double denominator = u2_sum * u2_sum;
+                if ( use_ik )
+                    denominator *= d2;
+                influence( i, j, k, 0 ) =
+                    ( denominator > 0.0 ) ? numerator / denominator : 0.0;
+            } );
+    }
+
+    // Compute the mesh field with ik differentiation and interpolate it to
+    // the particles.
+    template <class ExecutionSpace, class PositionSliceType,
+              class ChargeSliceType, class ForceSliceType>
+    void interpolateForces( const ExecutionSpace& exec_space,
+                            const PositionSliceType& positions,
+                            const ChargeSliceType& charges,
+                            const ForceSliceType& forces,
+                            const std::size_t num_particle,
+                            P3MIkDifferentiation )
+    {
+        auto own_space = _local_grid->indexSpace( Own(), Cell(), Local() );
+        auto rho_hat = _rho_hat->view();
+        auto work = _work->view();
+        auto field = _field->view();
+        auto influence = _influence->view();
+        auto derivative = _derivative->view();
+
+        // E(k) = -i D(k) G(k) rho(k) for each component.
+        for ( int d = 0; d < 3; ++d )
+        {
+            Kokkos::parallel_for(
+                "Cajita::P3MSolver::ikField",
+                createExecutionPolicy( own_space, exec_space ),
+                KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+                    double s =
+                        derivative( i, j, k, d ) * influence( i, j, k, 0 );
+                    work( i, j, k, 0 ) = s * rho_hat( i, j, k, 1 );
+                    work( i, j, k, 1 ) = -s * rho_hat( i, j, k, 0 );
+                } );
+            exec_space.fence();
+            _fft->reverse( *_work, FFTScaleFull() );
+            execution_space().fence();
+            Kokkos::parallel_for(
+                "Cajita::P3MSolver::copyField",
+                createExecutionPolicy( own_space, exec_space ),
+                KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+                    field( i, j, k, d ) = work( i, j, k, 0 );
+                } );
+        }
+
+        Impl::P3MFieldG2P<ChargeSliceType, ForceSliceType> field_g2p{ charges,
+                                                                      forces };
+        g2p( exec_space, *_field, *_vector_halo, positions, num_particle,
+             spline_type(), field_g2p );
+    }
+
+    // Compute the mesh potential and interpolate its analytical gradient to
+    // the particles.
+    template <class ExecutionSpace, class PositionSliceType,
+              class ChargeSliceType, class ForceSliceType>
+    void interpolateForces( const ExecutionSpace& exec_space,
+                            const PositionSliceType& positions,
+                            const ChargeSliceType& charges,
+                            const ForceSliceType& forces,
+                            const std::size_t num_particle,
+                            P3MAnalyticalDifferentiation )
+    {
+        auto own_space = _local_grid->indexSpace( Own(), Cell(), Local() );
+        auto rho_hat = _rho_hat->view();
+        auto work = _work->view();
+        auto phi = _phi->view();
+        auto influence = _influence->view();
+
+        // phi(k) = G(k) rho(k).
+        Kokkos::parallel_for(
+            "Cajita::P3MSolver::potential",
+            createExecutionPolicy( own_space, exec_space ),
+            KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+                work( i, j, k, 0 ) =
+                    influence( i, j, k, 0 ) * rho_hat( i, j, k, 0 );
+                work( i, j, k, 1 ) =
+                    influence( i, j, k, 0 ) * rho_hat( i, j, k, 1 );
+            } );
+        exec_space.fence();
+        _fft->reverse( *_work, FFTScaleFull() );
+        execution_space().fence();
+        Kokkos::parallel_for(
+            "Cajita::P3MSolver::copyPotential",
+            createExecutionPolicy( own_space, exec_space ),
+            KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+                phi( i, j, k, 0 ) = work( i, j, k, 0 );
+            } );
+
+        Impl::P3MPotentialGradientG2P<ChargeSliceType, ForceSliceType>
+            gradient_g2p{ charges, forces };
+        g2p( exec_space, *_phi, *_scalar_halo, positions, num_particle,
+             spline_type(), gradient_g2p );
+    }
+
+  private:
+    using array_type = Array<double, Cell, mesh_type, memory_space>;
+    using fft_type =
+        HeffteFastFourierTransform<Cell, mesh_type, double, memory_space,
+                                   execution_space, Impl::FFTBackendDefault>;
+
+    std::shared_ptr<LocalGrid<mesh_type>> _local_grid;
+    double _alpha;
+    double _r_cut;
+    std::shared_ptr<array_type> _rho;
+    std::shared_ptr<array_type> _phi;
+    std::shared_ptr<array_type> _rho_hat;
+    std::shared_ptr<array_type> _work;
+    std::shared_ptr<array_type> _field;
+    std::shared_ptr<array_type> _influence;
+    std::shared_ptr<array_type> _derivative;
+    std::shared_ptr<Halo<memory_space>> _scalar_halo;
+    std::shared_ptr<Halo<memory_space>> _vector_halo;
+    std::shared_ptr<fft_type> _fft;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a P3M solver.
+  \param local_grid The periodic local grid.
+  \param alpha The Ewald splitting parameter.
+  \param r_cut The cutoff of the short-range interactions.
+  \return Shared pointer to a P3MSolver.
+*/
+template <class MemorySpace, int SplineOrder,
+          class DifferentiationType = P3MIkDifferentiation>
+auto createP3MSolver(
+    const std::shared_ptr<LocalGrid<UniformMesh<double, 3>>>& local_grid,
+    const double alpha, const double r_cut )
+{
+    return std::make_shared<
+        P3MSolver<MemorySpace, SplineOrder, DifferentiationType>>(
+        local_grid, alpha, r_cut );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Experimental
+} // end namespace Cajita
+
+#endif // end CAJITA_P3MSOLVER_HPP
@@ -26,6 +26,9 @@
 
 #include <Kokkos_Core.hpp>
 
+#include <algorithm>
+#include <array>
+#include <tuple>
 #include <vector>
 
 namespace Cajita
@@ -35,6 +38,34 @@ namespace Cajita
 // Particle Grid Distributor
 //---------------------------------------------------------------------------//
 
+//! Migration tag: particles only move to one of the nearest neighbor ranks.
+struct NeighborMigrateTag
+{
+};
+
+//! Migration tag: particles may move to any rank in the global grid.
+struct GlobalMigrateTag
+{
+};
+
+//! Boundary tag: particles outside a non-periodic global boundary are
+//! removed during migration.
+struct AbsorbBoundaryTag
+{
+};
+
+//! Boundary tag: particles outside a non-periodic global boundary are
+//! reflected back into the domain about the boundary.
+struct ReflectBoundaryTag
+{
+};
+
+//! Boundary tag: particles outside a non-periodic global boundary are
+//! injected back into the domain on the boundary they crossed.
+struct InjectBoundaryTag
+{
+};
+
 /*!
   \brief Build neighbor topology of 27 nearest 3D neighbors. Some of the ranks
   in this list may be invalid.
@@ -76,16 +107,51 @@ namespace Impl
 {
 //! \cond Impl
 
+// Apply the boundary policy to a particle coordinate in a non-periodic
+// dimension. Return false if the particle is outside the global domain and
+// should be removed.
+KOKKOS_INLINE_FUNCTION
+bool applyParticleBoundary( AbsorbBoundaryTag, double& x, const double low,
+                            const double high )
+{
+    return ( x >= low && x <= high );
+}
+
+KOKKOS_INLINE_FUNCTION
+bool applyParticleBoundary( ReflectBoundaryTag, double& x, const double low,
+                            const double high )
+{
+    if ( x < low )
+        x = 2.0 * low - x;
+    else if ( x > high )
+        x = 2.0 * high - x;
+
+    // Particles that moved farther than the global extent are left on the
+    // opposite boundary.
+    x = Kokkos::fmin( Kokkos::fmax( x, low ), high );
+    return true;
+}
+
+KOKKOS_INLINE_FUNCTION
+bool applyParticleBoundary( InjectBoundaryTag, double& x, const double low,
+                            const double high )
+{
+    x = Kokkos::fmin( Kokkos::fmax( x, low ), high );
+    return true;
+}
+
 // Locate the particles in the local grid and get their destination rank.
 // Particles are assumed to only migrate to a location in the nearest
 // neighbor halo or stay on this rank. If the particle crosses a global
-// periodic boundary, wrap it's coordinates back into the domain.
+// periodic boundary, wrap it's coordinates back into the domain. If the
+// particle crosses a non-periodic boundary, apply the boundary policy first;
+// removed particles get a destination of -1.
 template <class LocalGridType, class PositionSliceType, class NeighborRankView,
-          class DestinationRankView>
+          class DestinationRankView, class BoundaryTag>
 void getMigrateDestinations( const LocalGridType& local_grid,
                              const NeighborRankView& neighbor_ranks,
                              DestinationRankView& destinations,
-                             PositionSliceType& positions )
+                             PositionSliceType& positions, BoundaryTag )
 {
     static constexpr std::size_t num_space_dim = LocalGridType::num_space_dim;
     using execution_space = typename PositionSliceType::execution_space;
@@ -119,6 +185,21 @@ void getMigrateDestinations( const LocalGridType& local_grid,
         "Cajita::ParticleGridMigrate::get_destinations",
         Kokkos::RangePolicy<execution_space>( 0, positions.size() ),
         KOKKOS_LAMBDA( const int p ) {
+            // Apply the boundary policy in non-periodic dimensions.
+            bool inside = true;
+            for ( std::size_t d = 0; d < num_space_dim; ++d )
+            {
+                if ( !periodic[d] )
+                {
+                    double x = positions( p, d );
+                    inside = Impl::applyParticleBoundary(
+                                 BoundaryTag(), x, global_low[d],
+                                 global_high[d] ) &&
+                             inside;
+                    positions( p, d ) = x;
+                }
+            }
+
             // Compute the logical index of the neighbor we are sending to.
             int nid[num_space_dim];
             for ( std::size_t d = 0; d < num_space_dim; ++d )
@@ -139,7 +220,8 @@ void getMigrateDestinations( const LocalGridType& local_grid,
                     npower *= 3;
                 neighbor_index += npower * nid[d];
             }
-            destinations( p ) = neighbor_ranks( neighbor_index );
+            destinations( p ) = ( inside ) ? neighbor_ranks( neighbor_index )
+                                           : -1;
 
             // Shift particles through periodic boundaries.
             for ( std::size_t d = 0; d < num_space_dim; ++d )
@@ -154,6 +236,138 @@ void getMigrateDestinations( const LocalGridType& local_grid,
             }
         } );
 }
+
+// Locate the particles in the global grid partition and get their
+// destination rank. Particles may move to any rank. If the particle is outside
+// a global periodic boundary, wrap its coordinates back into the domain. If
+// the particle is outside a non-periodic boundary, apply the boundary policy;
+// removed particles get a destination of -1.
+template <class LocalGridType, class PositionSliceType,
+          class DestinationRankView, class BoundaryTag>
+void getGlobalMigrateDestinations( const LocalGridType& local_grid,
+                                   DestinationRankView& destinations,
+                                   PositionSliceType& positions, BoundaryTag )
+{
+    static constexpr std::size_t num_space_dim = LocalGridType::num_space_dim;
+    using execution_space = typename PositionSliceType::execution_space;
+    using memory_space = typename PositionSliceType::memory_space;
+
+    const auto& global_grid = local_grid.globalGrid();
+    const auto& global_mesh = global_grid.globalMesh();
+    const auto& local_mesh =
+        Cajita::createLocalMesh<Kokkos::HostSpace>( local_grid );
+
+    Kokkos::Array<bool, num_space_dim> periodic{};
+    Kokkos::Array<double, num_space_dim> global_low{};
+    Kokkos::Array<double, num_space_dim> global_high{};
+    Kokkos::Array<double, num_space_dim> global_extent{};
+    Kokkos::Array<int, num_space_dim> num_block{};
+    std::array<double, num_space_dim> block_low;
+    std::array<int, num_space_dim> block_id;
+    int max_num_block = 0;
+    for ( std::size_t d = 0; d < num_space_dim; ++d )
+    {
+        periodic[d] = global_grid.isPeriodic( d );
+        global_low[d] = global_mesh.lowCorner( d );
+        global_high[d] = global_mesh.highCorner( d );
+        global_extent[d] = global_mesh.extent( d );
+        num_block[d] = global_grid.dimNumBlock( d );
+        block_low[d] = local_mesh.lowCorner( Cajita::Own(), d );
+        block_id[d] = global_grid.dimBlockId( d );
+        max_num_block = std::max( max_num_block, num_block[d] );
+    }
+
+    // Gather the low corner of every block to get the partition boundaries in
+    // each dimension. The last boundary is the global high corner.
+    int comm_size = -1;
+    MPI_Comm_size( global_grid.comm(), &comm_size );
+    std::vector<double> all_block_low( comm_size * num_space_dim );
+    std::vector<int> all_block_id( comm_size * num_space_dim );
+    MPI_Allgather( block_low.data(), num_space_dim, MPI_DOUBLE,
+                   all_block_low.data(), num_space_dim, MPI_DOUBLE,
+                   global_grid.comm() );
+    MPI_Allgather( block_id.data(), num_space_dim, MPI_INT,
+                   all_block_id.data(), num_space_dim, MPI_INT,
+                   global_grid.comm() );
+    Kokkos::View<double**, Kokkos::HostSpace> boundaries_host(
+        "partition_boundaries", num_space_dim, max_num_block + 1 );
+    for ( int r = 0; r < comm_size; ++r )
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+            boundaries_host( d, all_block_id[r * num_space_dim + d] ) =
+                all_block_low[r * num_space_dim + d];
+    for ( std::size_t d = 0; d < num_space_dim; ++d )
+        boundaries_host( d, num_block[d] ) = global_mesh.highCorner( d );
+    auto boundaries =
+        Kokkos::create_mirror_view_and_copy( memory_space(), boundaries_host );
+
+    // Get the rank of every block [bi + nbi*(bj + nbj*bk) in 3d].
+    Kokkos::View<int*, Kokkos::HostSpace> block_ranks_host(
+        "block_ranks", global_grid.totalNumBlock() );
+    for ( int b = 0; b < global_grid.totalNumBlock(); ++b )
+    {
+        std::array<int, num_space_dim> ijk;
+        int stride = 1;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+        {
+            ijk[d] = ( b / stride ) % num_block[d];
+            stride *= num_block[d];
+        }
+        block_ranks_host( b ) = global_grid.blockRank( ijk );
+    }
+    auto block_ranks =
+        Kokkos::create_mirror_view_and_copy( memory_space(), block_ranks_host );
+
+    Kokkos::parallel_for(
+        "Cajita::ParticleGridMigrate::get_global_destinations",
+        Kokkos::RangePolicy<execution_space>( 0, positions.size() ),
+        KOKKOS_LAMBDA( const int p ) {
+            bool outside = false;
+            int block_index = 0;
+            int stride = 1;
+            for ( std::size_t d = 0; d < num_space_dim; ++d )
+            {
+                // Shift particles through periodic boundaries, including
+                // particles that moved farther than the global extent.
+                // Apply the boundary policy otherwise.
+                if ( periodic[d] )
+                {
+                    positions( p, d ) -=
+                        global_extent[d] *
+                        Kokkos::floor( ( positions( p, d ) - global_low[d] ) /
+                                       global_extent[d] );
+                }
+                else
+                {
+                    double x = positions( p, d );
+                    if ( !Impl::applyParticleBoundary( BoundaryTag(), x,
+                                                       global_low[d],
+                                                       global_high[d] ) )
+                        outside = true;
+                    positions( p, d ) = x;
+                }
+                auto x = positions( p, d );
+                if ( x < boundaries( d, 0 ) ||
+                     x > boundaries( d, num_block[d] ) )
+                    outside = true;
+
+                // Binary search for the last block boundary below the
+                // particle.
+                int low = 0;
+                int high = num_block[d] - 1;
+                while ( low < high )
+                {
+                    int mid = ( low + high + 1 ) / 2;
+                    if ( boundaries( d, mid ) <= x )
+                        low = mid;
+                    else
+                        high = mid - 1;
+                }
+                block_index += stride * low;
+                stride *= num_block[d];
+            }
+            destinations( p ) = ( outside ) ? -1 : block_ranks( block_index );
+        } );
+}
 //! \endcond
 } // namespace Impl
 
@@ -233,14 +447,21 @@ int migrateCount( const LocalGridType& local_grid,
   \param local_grid The local grid containing periodicity and system bound
   information.
   \param positions The particle positions.
+  \param tag Particles only move to the nearest neighbor ranks.
+  \param boundary_tag Policy for particles outside non-periodic boundaries:
+  AbsorbBoundaryTag, ReflectBoundaryTag, or InjectBoundaryTag.
 
   \return Distributor for later migration.
 */
-template <class LocalGridType, class PositionSliceType>
+template <class LocalGridType, class PositionSliceType, class BoundaryTag>
 Cabana::Distributor<typename PositionSliceType::memory_space>
 createParticleGridDistributor( const LocalGridType& local_grid,
-                               PositionSliceType& positions )
+                               PositionSliceType& positions,
+                               NeighborMigrateTag tag,
+                               BoundaryTag boundary_tag )
 {
+    std::ignore = tag;
+
     using memory_space = typename PositionSliceType::memory_space;
 
     // Get all 26 neighbor ranks.
@@ -254,10 +475,10 @@ createParticleGridDistributor( const LocalGridType& local_grid,
         Kokkos::ViewAllocateWithoutInitializing( "destinations" ),
         positions.size() );
 
-    // Determine destination ranks for all particles and wrap positions across
-    // periodic boundaries.
+    // Determine destination ranks for all particles, wrap positions across
+    // periodic boundaries, and apply the non-periodic boundary policy.
     Impl::getMigrateDestinations( local_grid, topology_mirror, destinations,
-                                  positions );
+                                  positions, boundary_tag );
 
     // Create the Cabana distributor.
     Cabana::Distributor<memory_space> distributor(
@@ -265,6 +486,102 @@ createParticleGridDistributor( const LocalGridType& local_grid,
     return distributor;
 }
 
+/*!
+  \brief Determine which data should be migrated from one uniquely-owned
+  decomposition to another uniquely-owned decomposition, using the partition
+  of a Cajita global grid and taking periodic boundaries into account.
+  Particles may move to any rank, e.g. after a large step, a change in the
+  partition, or an initial scatter.
+
+  \tparam LocalGridType Cajita LocalGrid type.
+  \tparam PositionSliceType Position type.
+
+  \param local_grid The local grid containing periodicity and system bound
+  information.
+  \param positions The particle positions.
+  \param tag Particles may move to any rank.
+  \param boundary_tag Policy for particles outside non-periodic boundaries:
+  AbsorbBoundaryTag, ReflectBoundaryTag, or InjectBoundaryTag.
+
+  \return Distributor for later migration.
+*/
+template <class LocalGridType, class PositionSliceType, class BoundaryTag>
+Cabana::Distributor<typename PositionSliceType::memory_space>
+createParticleGridDistributor( const LocalGridType& local_grid,
+                               PositionSliceType& positions,
+                               GlobalMigrateTag tag, BoundaryTag boundary_tag )
+{
+    std::ignore = tag;
+    using memory_space = typename PositionSliceType::memory_space;
+
+    Kokkos::View<int*, memory_space> destinations(
+        Kokkos::ViewAllocateWithoutInitializing( "destinations" ),
+        positions.size() );
+
+    // Determine destination ranks for all particles, wrap positions across
+    // periodic boundaries, and apply the non-periodic boundary policy.
+    Impl::getGlobalMigrateDestinations( local_grid, destinations, positions,
+                                        boundary_tag );
+
+    // Create the Cabana distributor. The communication topology is not known
+    // in advance.
+    Cabana::Distributor<memory_space> distributor(
+        local_grid.globalGrid().comm(), destinations );
+    return distributor;
+}
+
+/*!
+  \brief Determine which data should be migrated from one uniquely-owned
+  decomposition to another uniquely-owned decomposition, using bounds of a
+  Cajita grid and taking periodic boundaries into account. Particles outside
+  non-periodic boundaries are removed.
+
+  \tparam LocalGridType Cajita LocalGrid type.
+  \tparam PositionSliceType Position type.
+  \tparam MigrateTag Migration tag: NeighborMigrateTag or GlobalMigrateTag.
+
+  \param local_grid The local grid containing periodicity and system bound
+  information.
+  \param positions The particle positions.
+  \param tag Whether particles may move to any rank or only to the nearest
+  neighbor ranks.
+
+  \return Distributor for later migration.
+*/
+template <class LocalGridType, class PositionSliceType, class MigrateTag>
+Cabana::Distributor<typename PositionSliceType::memory_space>
+createParticleGridDistributor( const LocalGridType& local_grid,
+                               PositionSliceType& positions, MigrateTag tag )
+{
+    return createParticleGridDistributor( local_grid, positions, tag,
+                                          AbsorbBoundaryTag() );
+}
+
+/*!
+  \brief Determine which data should be migrated from one uniquely-owned
+  decomposition to another uniquely-owned decomposition, using bounds of a
+  Cajita grid and taking periodic boundaries into account. Particles only move
+  to the nearest neighbor ranks. Particles outside non-periodic boundaries are
+  removed.
+
+  \tparam LocalGridType Cajita LocalGrid type.
+  \tparam PositionSliceType Position type.
+
+  \param local_grid The local grid containing periodicity and system bound
+  information.
+  \param positions The particle positions.
+
+  \return Distributor for later migration.
+*/
+template <class LocalGridType, class PositionSliceType>
+Cabana::Distributor<typename PositionSliceType::memory_space>
+createParticleGridDistributor( const LocalGridType& local_grid,
+                               PositionSliceType& positions )
+{
+    return createParticleGridDistributor( local_grid, positions,
+                                          NeighborMigrateTag() );
+}
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Migrate data from one uniquely-owned decomposition to another
@@ -274,6 +591,7 @@ createParticleGridDistributor( const LocalGridType& local_grid,
   \tparam LocalGridType Cajita LocalGrid type.
   \tparam ParticlePositions Particle position type.
   \tparam PositionContainer AoSoA type.
+  \tparam MigrateTag Migration tag: NeighborMigrateTag or GlobalMigrateTag.
 
   \param local_grid The local grid containing periodicity and system bounds.
   \param positions Particle positions.
@@ -282,14 +600,20 @@ createParticleGridDistributor( const LocalGridType& local_grid,
   migrating.
   \param force_migrate Migrate particles outside the local domain regardless of
   ghosted halo.
+  \param tag Whether particles may move to any rank or only to the nearest
+  neighbor ranks.
+  \param boundary_tag Policy for particles outside non-periodic boundaries:
+  AbsorbBoundaryTag, ReflectBoundaryTag, or InjectBoundaryTag. Absorbed
+  particles are removed as part of the migration.
   \return Whether any particle migration occured.
 */
-template <class LocalGridType, class ParticlePositions, class ParticleContainer>
+template <class LocalGridType, class ParticlePositions, class ParticleContainer,
+          class MigrateTag, class BoundaryTag>
 bool particleGridMigrate( const LocalGridType& local_grid,
                           const ParticlePositions& positions,
                           ParticleContainer& particles,
-                          const int min_halo_width,
-                          const bool force_migrate = false )
+                          const int min_halo_width, const bool force_migrate,
+                          MigrateTag tag, BoundaryTag boundary_tag )
 {
     // When false, this option checks that any particles are nearly outside the
     // ghosted halo region (outside the min_halo_width) before initiating
@@ -305,13 +629,82 @@ bool particleGridMigrate( const LocalGridType& local_grid,
             return false;
     }
 
-    auto distributor = createParticleGridDistributor( local_grid, positions );
+    auto distributor = createParticleGridDistributor( local_grid, positions,
+                                                      tag, boundary_tag );
 
     // Redistribute the particles.
     migrate( distributor, particles );
     return true;
 }
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Migrate data from one uniquely-owned decomposition to another
+  uniquely-owned decomposition, using the bounds and periodic boundaries of a
+  Cajita grid to determine which particles should be moved. In-place variant.
+  Particles outside non-periodic boundaries are removed.
+
+  \tparam LocalGridType Cajita LocalGrid type.
+  \tparam ParticlePositions Particle position type.
+  \tparam PositionContainer AoSoA type.
+  \tparam MigrateTag Migration tag: NeighborMigrateTag or GlobalMigrateTag.
+
+  \param local_grid The local grid containing periodicity and system bounds.
+  \param positions Particle positions.
+  \param particles The particle AoSoA.
+  \param min_halo_width Number of halo mesh widths to allow particles before
+  migrating.
+  \param force_migrate Migrate particles outside the local domain regardless of
+  ghosted halo.
+  \param tag Whether particles may move to any rank or only to the nearest
+  neighbor ranks.
+  \return Whether any particle migration occured.
+*/
+template <class LocalGridType, class ParticlePositions, class ParticleContainer,
+          class MigrateTag>
+bool particleGridMigrate( const LocalGridType& local_grid,
+                          const ParticlePositions& positions,
+                          ParticleContainer& particles,
+                          const int min_halo_width, const bool force_migrate,
+                          MigrateTag tag )
+{
+    return particleGridMigrate( local_grid, positions, particles,
+                                min_halo_width, force_migrate, tag,
+                                AbsorbBoundaryTag() );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Migrate data from one uniquely-owned decomposition to another
+  uniquely-owned decomposition, using the bounds and periodic boundaries of a
+  Cajita grid to determine which particles should be moved. In-place variant.
+  Particles only move to the nearest neighbor ranks.
+
+  \tparam LocalGridType Cajita LocalGrid type.
+  \tparam ParticlePositions Particle position type.
+  \tparam PositionContainer AoSoA type.
+
+  \param local_grid The local grid containing periodicity and system bounds.
+  \param positions Particle positions.
+  \param particles The particle AoSoA.
+  \param min_halo_width Number of halo mesh widths to allow particles before
+  migrating.
+  \param force_migrate Migrate particles outside the local domain regardless of
+  ghosted halo.
+  \return Whether any particle migration occured.
+*/
+template <class LocalGridType, class ParticlePositions, class ParticleContainer>
+bool particleGridMigrate( const LocalGridType& local_grid,
+                          const ParticlePositions& positions,
+                          ParticleContainer& particles,
+                          const int min_halo_width,
+                          const bool force_migrate = false )
+{
+    return particleGridMigrate( local_grid, positions, particles,
+                                min_halo_width, force_migrate,
+                                NeighborMigrateTag() );
+}
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Migrate data from one uniquely-owned decomposition to another
@@ -322,6 +715,7 @@ bool particleGridMigrate( const LocalGridType& local_grid,
   \tparam LocalGridType Cajita LocalGrid type.
   \tparam ParticlePositions Particle position type.
   \tparam ParticleContainer AoSoA type.
+  \tparam MigrateTag Migration tag: NeighborMigrateTag or GlobalMigrateTag.
 
   \param local_grid The local grid containing periodicity and system bounds.
   \param positions Particle positions.
@@ -331,15 +725,21 @@ bool particleGridMigrate( const LocalGridType& local_grid,
   migrating.
   \param force_migrate Migrate particles outside the local domain regardless of
   ghosted halo.
+  \param tag Whether particles may move to any rank or only to the nearest
+  neighbor ranks.
+  \param boundary_tag Policy for particles outside non-periodic boundaries:
+  AbsorbBoundaryTag, ReflectBoundaryTag, or InjectBoundaryTag. Absorbed
+  particles are removed as part of the migration.
   \return Whether any particle migration occured.
 */
-template <class LocalGridType, class ParticlePositions, class ParticleContainer>
+template <class LocalGridType, class ParticlePositions, class ParticleContainer,
+          class MigrateTag, class BoundaryTag>
 bool particleGridMigrate( const LocalGridType& local_grid,
                           const ParticlePositions& positions,
                           const ParticleContainer& src_particles,
                           ParticleContainer& dst_particles,
-                          const int min_halo_width,
-                          const bool force_migrate = false )
+                          const int min_halo_width, const bool force_migrate,
+                          MigrateTag tag, BoundaryTag boundary_tag )
 {
     // When false, this option checks that any particles are nearly outside the
     // ghosted halo region (outside the  min_halo_width) before initiating
@@ -358,7 +758,8 @@ bool particleGridMigrate( const LocalGridType& local_grid,
         }
     }
 
-    auto distributor = createParticleGridDistributor( local_grid, positions );
+    auto distributor = createParticleGridDistributor( local_grid, positions,
+                                                      tag, boundary_tag );
 
     // Resize as needed.
     dst_particles.resize( distributor.totalNumImport() );
@@ -368,6 +769,78 @@ bool particleGridMigrate( const LocalGridType& local_grid,
     return true;
 }
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Migrate data from one uniquely-owned decomposition to another
+  uniquely-owned decomposition, using the bounds and periodic boundaries of a
+  Cajita grid to determine which particles should be moved. Separate AoSoA
+  variant. Particles outside non-periodic boundaries are removed.
+
+  \tparam LocalGridType Cajita LocalGrid type.
+  \tparam ParticlePositions Particle position type.
+  \tparam ParticleContainer AoSoA type.
+  \tparam MigrateTag Migration tag: NeighborMigrateTag or GlobalMigrateTag.
+
+  \param local_grid The local grid containing periodicity and system bounds.
+  \param positions Particle positions.
+  \param src_particles The source particle AoSoA.
+  \param dst_particles The destination particle AoSoA.
+  \param min_halo_width Number of halo mesh widths to allow particles before
+  migrating.
+  \param force_migrate Migrate particles outside the local domain regardless of
+  ghosted halo.
+  \param tag Whether particles may move to any rank or only to the nearest
+  neighbor ranks.
+  \return Whether any particle migration occured.
+*/
+template <class LocalGridType, class ParticlePositions, class ParticleContainer,
+          class MigrateTag>
+bool particleGridMigrate( const LocalGridType& local_grid,
+                          const ParticlePositions& positions,
+                          const ParticleContainer& src_particles,
+                          ParticleContainer& dst_particles,
+                          const int min_halo_width, const bool force_migrate,
+                          MigrateTag tag )
+{
+    return particleGridMigrate( local_grid, positions, src_particles,
+                                dst_particles, min_halo_width, force_migrate,
+                                tag, AbsorbBoundaryTag() );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Migrate data from one uniquely-owned decomposition to another
+  uniquely-owned decomposition, using the bounds and periodic boundaries of a
+  Cajita grid to determine which particles should be moved. Separate AoSoA
+  variant. Particles only move to the nearest neighbor ranks.
+
+  \tparam LocalGridType Cajita LocalGrid type.
+  \tparam ParticlePositions Particle position type.
+  \tparam ParticleContainer AoSoA type.
+
+  \param local_grid The local grid containing periodicity and system bounds.
+  \param positions Particle positions.
+  \param src_particles The source particle AoSoA.
+  \param dst_particles The destination particle AoSoA.
+  \param min_halo_width Number of halo mesh widths to allow particles before
+  migrating.
+  \param force_migrate Migrate particles outside the local domain regardless of
+  ghosted halo.
+  \return Whether any particle migration occured.
+*/
+template <class LocalGridType, class ParticlePositions, class ParticleContainer>
+bool particleGridMigrate( const LocalGridType& local_grid,
+                          const ParticlePositions& positions,
+                          const ParticleContainer& src_particles,
+                          ParticleContainer& dst_particles,
+                          const int min_halo_width,
+                          const bool force_migrate = false )
+{
+    return particleGridMigrate( local_grid, positions, src_particles,
+                                dst_particles, min_halo_width, force_migrate,
+                                NeighborMigrateTag() );
+}
+
 } // namespace Cajita
 
 #endif // end CABANA_PARTICLEGRIDDISTRIBUTOR_HPP
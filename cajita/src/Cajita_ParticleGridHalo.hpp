@@ -0,0 +1,568 @@
+/****************************************************************************
+ * Copyright (c) 2018-2023 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cajita_ParticleGridHalo.hpp
+  \brief Multi-node particle ghosting using the grid decomposition.
+*/
+#ifndef CAJITA_PARTICLEGRIDHALO_HPP
+#define CAJITA_PARTICLEGRIDHALO_HPP
+
+#include <Cabana_Halo.hpp>
+
+#include <Cajita_GlobalGrid.hpp>
+#include <Cajita_GlobalMesh.hpp>
+#include <Cajita_LocalGrid.hpp>
+#include <Cajita_LocalMesh.hpp>
+#include <Cajita_ParticleGridDistributor.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <exception>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace Cajita
+{
+namespace Impl
+{
+//! \cond Impl
+// Determine if a particle is in the ghost region exported to the neighbor
+// with the given index [ni + 3*(nj + 3*nk) in 3d] given whether it is within
+// the ghost width of the low and high boundaries of each dimension.
+template <std::size_t NumSpaceDim>
+KOKKOS_INLINE_FUNCTION bool
+inNeighborGhostRegion( const int neighbor_index, const bool near_low[],
+                       const bool near_high[] )
+{
+    bool is_self = true;
+    bool in_region = true;
+    int stride = 1;
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+    {
+        int offset = ( neighbor_index / stride ) % 3 - 1;
+        stride *= 3;
+        if ( -1 == offset )
+            in_region = in_region && near_low[d];
+        else if ( 1 == offset )
+            in_region = in_region && near_high[d];
+        is_self = is_self && ( 0 == offset );
+    }
+    return in_region && !is_self;
+}
+//! \endcond
+} // namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Particle ghosting plan built from the decomposition of a Cajita
+  local grid.
+
+  \tparam MemorySpace Kokkos memory space in which the plan is allocated.
+  \tparam MeshType Cajita mesh type. Only uniform meshes are supported.
+
+  Locally owned particles within a given number of cells of the boundary of
+  the owned domain are exported as ghosts to every neighbor rank sharing that
+  face, edge, or corner. Ghosts sent through a periodic boundary are shifted
+  by the global domain extent so they appear adjacent to the owned domain of
+  the receiving rank.
+
+  The export lists are built in a single kernel. The underlying Cabana::Halo
+  is valid as long as every locally owned particle stays in the cell it
+  occupied when the plan was built - use updateRequired() to check if the
+  plan can be reused and build() to recompute it.
+*/
+template <class MemorySpace, class MeshType>
+class ParticleGridHalo
+{
+  public:
+    //! Memory space.
+    using memory_space = MemorySpace;
+    //! Default execution space.
+    using execution_space = typename memory_space::execution_space;
+    //! Mesh type.
+    using mesh_type = MeshType;
+    //! Scalar type for geometric operations.
+    using scalar_type = typename mesh_type::scalar_type;
+    //! Spatial dimension.
+    static constexpr std::size_t num_space_dim = mesh_type::num_space_dim;
+    //! Cabana halo type.
+    using halo_type = Cabana::Halo<memory_space>;
+
+    static_assert(
+        std::is_same<mesh_type, UniformMesh<scalar_type, num_space_dim>>::value,
+        "ParticleGridHalo requires a uniform mesh." );
+
+    //! Number of neighbor directions, including this rank.
+    static constexpr int num_neighbor = ( 3 == num_space_dim ) ? 27 : 9;
+
+    /*!
+      \brief Constructor.
+
+      \param exec_space Kokkos execution space.
+      \param local_grid The local grid defining the decomposition.
+      \param positions Locally owned particle positions.
+      \param ghost_width Number of cells from the owned domain boundary in
+      which particles are ghosted. Must be less than or equal to the number of
+      owned cells in every dimension.
+    */
+    template <class ExecutionSpace, class PositionSliceType>
+    ParticleGridHalo( ExecutionSpace exec_space,
+                      const LocalGrid<MeshType>& local_grid,
+                      const PositionSliceType& positions,
+                      const int ghost_width )
+        : _comm( local_grid.globalGrid().comm() )
+        , _ghost_width( ghost_width )
+        , _num_local( 0 )
+        , _num_export( 0 )
+    {
+        const auto& global_grid = local_grid.globalGrid();
+        const auto& global_mesh = global_grid.globalMesh();
+        const auto local_mesh =
+            createLocalMesh<Kokkos::HostSpace>( local_grid );
+        auto owned_cells = local_grid.indexSpace( Own(), Cell(), Local() );
+
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+        {
+            _local_low[d] = local_mesh.lowCorner( Own(), d );
+            _inv_cell_size[d] = 1.0 / global_mesh.cellSize( d );
+            _num_cell[d] = owned_cells.extent( d );
+            if ( ghost_width > _num_cell[d] )
+                throw std::runtime_error(
+                    "Particle ghost width larger than owned domain" );
+        }
+
+        // Get the rank and periodic shift for every neighbor direction. A
+        // shift is only needed when the neighbor is reached across a global
+        // periodic boundary.
+        _topology = getTopology( local_grid );
+        auto neighbor_ranks_host = Kokkos::View<int*, Kokkos::HostSpace>(
+            "neighbor_ranks", num_neighbor );
+        auto neighbor_shifts_host =
+            Kokkos::View<scalar_type* [num_space_dim], Kokkos::HostSpace>(
+                "neighbor_shifts", num_neighbor );
+        for ( int n = 0; n < num_neighbor; ++n )
+        {
+            neighbor_ranks_host( n ) = _topology[n];
+            int stride = 1;
+            for ( std::size_t d = 0; d < num_space_dim; ++d )
+            {
+                int offset = ( n / stride ) % 3 - 1;
+                stride *= 3;
+                neighbor_shifts_host( n, d ) = 0.0;
+                if ( global_grid.isPeriodic( d ) )
+                {
+                    if ( -1 == offset && global_grid.onLowBoundary( d ) )
+                        neighbor_shifts_host( n, d ) = global_mesh.extent( d );
+                    else if ( 1 == offset && global_grid.onHighBoundary( d ) )
+                        neighbor_shifts_host( n, d ) = -global_mesh.extent( d );
+                }
+            }
+        }
+        _neighbor_ranks = Kokkos::create_mirror_view_and_copy(
+            memory_space(), neighbor_ranks_host );
+        _neighbor_shifts = Kokkos::create_mirror_view_and_copy(
+            memory_space(), neighbor_shifts_host );
+
+        build( exec_space, positions );
+    }
+
+    /*!
+      \brief Build the ghosting plan.
+
+      \param exec_space Kokkos execution space.
+      \param positions Locally owned particle positions. Any ghosts from a
+      previous gather must be removed first.
+
+      \note This function performs collective MPI communication.
+    */
+    template <class ExecutionSpace, class PositionSliceType>
+    void build( ExecutionSpace exec_space, const PositionSliceType& positions )
+    {
+        Kokkos::Profiling::pushRegion( "Cajita::ParticleGridHalo::build" );
+
+        _num_local = positions.size();
+        Kokkos::realloc( _cells, _num_local );
+        Kokkos::realloc( _export_offsets, _num_local );
+        Kokkos::realloc( _export_counts, _num_local );
+
+        // Local copies for lambdas.
+        auto local_low = _local_low;
+        auto inv_cell_size = _inv_cell_size;
+        auto num_cell = _num_cell;
+        auto ghost_width = _ghost_width;
+        auto neighbor_ranks = _neighbor_ranks;
+        auto neighbor_shifts = _neighbor_shifts;
+        auto cells = _cells;
+        auto export_offsets = _export_offsets;
+        auto export_counts = _export_counts;
+
+        // Locate each particle and write its exports contiguously. If the
+        // export lists are not large enough, resize and locate again.
+        Kokkos::View<std::size_t, memory_space> export_count( "export_count" );
+        bool built = false;
+        while ( !built )
+        {
+            Kokkos::deep_copy( exec_space, export_count, 0 );
+            auto capacity = _export_ids.extent( 0 );
+            auto export_ids = _export_ids;
+            auto export_ranks = _export_ranks;
+            auto export_shifts = _export_shifts;
+            Kokkos::parallel_for(
+                "Cajita::ParticleGridHalo::build_exports",
+                Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                                     _num_local ),
+                KOKKOS_LAMBDA( const int p ) {
+                    bool near_low[num_space_dim];
+                    bool near_high[num_space_dim];
+                    for ( std::size_t d = 0; d < num_space_dim; ++d )
+                    {
+                        cells( p, d ) = static_cast<int>( Kokkos::floor(
+                            ( positions( p, d ) - local_low[d] ) *
+                            inv_cell_size[d] ) );
+                        near_low[d] = cells( p, d ) < ghost_width;
+                        near_high[d] =
+                            cells( p, d ) >= num_cell[d] - ghost_width;
+                    }
+
+                    int count = 0;
+                    for ( int n = 0; n < num_neighbor; ++n )
+                        if ( neighbor_ranks( n ) >= 0 &&
+                             Impl::inNeighborGhostRegion<num_space_dim>(
+                                 n, near_low, near_high ) )
+                            ++count;
+
+                    auto offset = Kokkos::atomic_fetch_add(
+                        &export_count(), static_cast<std::size_t>( count ) );
+                    export_offsets( p ) = offset;
+                    export_counts( p ) = count;
+
+                    for ( int n = 0; n < num_neighbor; ++n )
+                        if ( neighbor_ranks( n ) >= 0 &&
+                             Impl::inNeighborGhostRegion<num_space_dim>(
+                                 n, near_low, near_high ) )
+                        {
+                            if ( offset < capacity )
+                            {
+                                export_ids( offset ) = p;
+                                export_ranks( offset ) = neighbor_ranks( n );
+                                for ( std::size_t d = 0; d < num_space_dim;
+                                      ++d )
+                                    export_shifts( offset, d ) =
+                                        neighbor_shifts( n, d );
+                            }
+                            ++offset;
+                        }
+                } );
+            Kokkos::deep_copy( _num_export, export_count );
+
+            if ( _num_export > capacity )
+            {
+                Kokkos::realloc( _export_ids, _num_export );
+                Kokkos::realloc( _export_ranks, _num_export );
+                Kokkos::realloc( _export_shifts, _num_export );
+            }
+            else
+            {
+                built = true;
+            }
+        }
+
+        // Create the particle halo from the exports.
+        auto export_range = Kokkos::make_pair( std::size_t( 0 ), _num_export );
+        _halo = std::make_shared<halo_type>(
+            _comm, _num_local, Kokkos::subview( _export_ids, export_range ),
+            Kokkos::subview( _export_ranks, export_range ), _topology );
+
+        // Communicate the periodic shift of every ghost.
+        buildGhostShifts( exec_space );
+
+        Kokkos::Profiling::popRegion();
+    }
+
+    /*!
+      \brief Check if any locally owned particle changed cells since the plan
+      was built, in which case the plan must be rebuilt.
+
+      \param exec_space Kokkos execution space.
+      \param positions Particle positions. The first numLocal() positions must
+      be the locally owned particles used to build the plan.
+      \return Whether the plan must be rebuilt on any rank.
+
+      \note This function performs collective MPI communication.
+    */
+    template <class ExecutionSpace, class PositionSliceType>
+    bool updateRequired( ExecutionSpace exec_space,
+                         const PositionSliceType& positions ) const
+    {
+        int changed = ( positions.size() < _num_local ) ? 1 : 0;
+        if ( 0 == changed )
+        {
+            auto local_low = _local_low;
+            auto inv_cell_size = _inv_cell_size;
+            auto cells = _cells;
+            Kokkos::parallel_reduce(
+                "Cajita::ParticleGridHalo::update_required",
+                Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                                     _num_local ),
+                KOKKOS_LAMBDA( const int p, int& result ) {
+                    for ( std::size_t d = 0; d < num_space_dim; ++d )
+                        if ( cells( p, d ) !=
+                             static_cast<int>( Kokkos::floor(
+                                 ( positions( p, d ) - local_low[d] ) *
+                                 inv_cell_size[d] ) ) )
+                        {
+                            result += 1;
+                            break;
+                        }
+                },
+                changed );
+        }
+
+        MPI_Allreduce( MPI_IN_PLACE, &changed, 1, MPI_INT, MPI_SUM, _comm );
+        return changed > 0;
+    }
+
+    /*!
+      \brief Gather particle data to the ghosts and shift ghosts received
+      through periodic boundaries.
+
+      \param exec_space Kokkos execution space.
+      \param particles The particle data (AoSoA or slice) to gather. Must be
+      of size numLocal() + numGhost().
+      \param positions The particle positions. Must be of size numLocal() +
+      numGhost() and contained in the gathered particle data.
+    */
+    template <class ExecutionSpace, class ParticleDataType,
+              class PositionSliceType>
+    void gather( ExecutionSpace exec_space, ParticleDataType& particles,
+                 PositionSliceType& positions ) const
+    {
+        auto particle_gather = Cabana::createGather( *_halo, particles );
+        particle_gather.apply( exec_space );
+        shiftGhosts( exec_space, positions );
+    }
+
+    /*!
+      \brief Apply the periodic shifts to the ghosted positions. Use this after
+      a positions-only gather with the underlying Cabana::Halo.
+
+      \param exec_space Kokkos execution space.
+      \param positions The particle positions. Must be of size numLocal() +
+      numGhost().
+    */
+    template <class ExecutionSpace, class PositionSliceType>
+    void shiftGhosts( ExecutionSpace exec_space,
+                      PositionSliceType& positions ) const
+    {
+        if ( positions.size() != numLocal() + numGhost() )
+            throw std::runtime_error(
+                "Positions are the wrong size for ghost shifts!" );
+
+        auto num_local = _num_local;
+        auto ghost_shifts = _ghost_shifts;
+        Kokkos::parallel_for(
+            "Cajita::ParticleGridHalo::shift_ghosts",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, numGhost() ),
+            KOKKOS_LAMBDA( const int g ) {
+                for ( std::size_t d = 0; d < num_space_dim; ++d )
+                    positions( num_local + g, d ) += ghost_shifts( g, d );
+            } );
+        exec_space.fence();
+    }
+
+    //! Get the underlying particle halo.
+    const halo_type& halo() const { return *_halo; }
+
+    //! Get the number of locally owned particles used to build the plan.
+    std::size_t numLocal() const { return _num_local; }
+
+    //! Get the number of ghosted particles on this rank.
+    std::size_t numGhost() const { return _halo->numGhost(); }
+
+    //! Get the number of particle exports (a particle may be exported to
+    //! several neighbors).
+    std::size_t numExport() const { return _num_export; }
+
+  private:
+    // Recover the periodic shift of each send slot in the halo steering
+    // vector and send it to the receiving rank.
+    template <class ExecutionSpace>
+    void buildGhostShifts( ExecutionSpace exec_space )
+    {
+        int num_n = _halo->numNeighbor();
+
+        // Get the send slot range and rank of each halo neighbor.
+        Kokkos::View<std::size_t*, Kokkos::HostSpace> slot_offsets_host(
+            "slot_offsets", num_n + 1 );
+        Kokkos::View<int*, Kokkos::HostSpace> slot_ranks_host( "slot_ranks",
+                                                               num_n );
+        for ( int n = 0; n < num_n; ++n )
+        {
+            slot_offsets_host( n + 1 ) =
+                slot_offsets_host( n ) + _halo->numExport( n );
+            slot_ranks_host( n ) = _halo->neighborRank( n );
+        }
+        auto slot_offsets = Kokkos::create_mirror_view_and_copy(
+            memory_space(), slot_offsets_host );
+        auto slot_ranks = Kokkos::create_mirror_view_and_copy(
+            memory_space(), slot_ranks_host );
+
+        // Each slot holds a particle id. Match it to an export of that
+        // particle with the same destination. A particle may be sent to the
+        // same rank as several periodic images: these copies are
+        // interchangeable so each slot claims any unclaimed matching export.
+        Kokkos::View<scalar_type**, Kokkos::LayoutRight, memory_space>
+            send_shifts( Kokkos::ViewAllocateWithoutInitializing(
+                             "send_shifts" ),
+                         _halo->totalNumExport(), num_space_dim );
+        Kokkos::View<int*, memory_space> claimed( "claimed", _num_export );
+        auto steering = _halo->getExportSteering();
+        auto export_offsets = _export_offsets;
+        auto export_counts = _export_counts;
+        auto export_ranks = _export_ranks;
+        auto export_shifts = _export_shifts;
+        Kokkos::parallel_for(
+            "Cajita::ParticleGridHalo::match_send_shifts",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                                 _halo->totalNumExport() ),
+            KOKKOS_LAMBDA( const std::size_t s ) {
+                int n = 0;
+                while ( s >= slot_offsets( n + 1 ) )
+                    ++n;
+                auto p = steering( s );
+                auto begin = export_offsets( p );
+                auto end = begin + export_counts( p );
+                for ( auto e = begin; e < end; ++e )
+                    if ( export_ranks( e ) == slot_ranks( n ) &&
+                         0 == Kokkos::atomic_compare_exchange( &claimed( e ),
+                                                               0, 1 ) )
+                    {
+                        for ( std::size_t d = 0; d < num_space_dim; ++d )
+                            send_shifts( s, d ) = export_shifts( e, d );
+                        break;
+                    }
+            } );
+        exec_space.fence();
+
+        // Send the shifts to the ghost owners.
+        _ghost_shifts =
+            Kokkos::View<scalar_type**, Kokkos::LayoutRight, memory_space>(
+                Kokkos::ViewAllocateWithoutInitializing( "ghost_shifts" ),
+                _halo->totalNumImport(), num_space_dim );
+
+        const int mpi_tag = 3456;
+
+        std::vector<MPI_Request> requests( num_n );
+        std::pair<std::size_t, std::size_t> recv_range = { 0, 0 };
+        for ( int n = 0; n < num_n; ++n )
+        {
+            recv_range.second = recv_range.first + _halo->numImport( n );
+            auto recv_subview =
+                Kokkos::subview( _ghost_shifts, recv_range, Kokkos::ALL );
+            MPI_Irecv( recv_subview.data(),
+                       recv_subview.size() * sizeof( scalar_type ), MPI_BYTE,
+                       _halo->neighborRank( n ), mpi_tag, _halo->comm(),
+                       &( requests[n] ) );
+            recv_range.first = recv_range.second;
+        }
+
+        std::pair<std::size_t, std::size_t> send_range = { 0, 0 };
+        for ( int n = 0; n < num_n; ++n )
+        {
+            send_range.second = send_range.first + _halo->numExport( n );
+            auto send_subview =
+                Kokkos::subview( send_shifts, send_range, Kokkos::ALL );
+            MPI_Send( send_subview.data(),
+                      send_subview.size() * sizeof( scalar_type ), MPI_BYTE,
+                      _halo->neighborRank( n ), mpi_tag, _halo->comm() );
+            send_range.first = send_range.second;
+        }
+
+        std::vector<MPI_Status> status( num_n );
+        const int ec =
+            MPI_Waitall( requests.size(), requests.data(), status.data() );
+        if ( MPI_SUCCESS != ec )
+            throw std::logic_error( "Failed MPI Communication" );
+    }
+
+  private:
+    MPI_Comm _comm;
+    int _ghost_width;
+    std::size_t _num_local;
+    std::size_t _num_export;
+    std::vector<int> _topology;
+    Kokkos::Array<scalar_type, num_space_dim> _local_low;
+    Kokkos::Array<scalar_type, num_space_dim> _inv_cell_size;
+    Kokkos::Array<int, num_space_dim> _num_cell;
+    Kokkos::View<int*, memory_space> _neighbor_ranks;
+    Kokkos::View<scalar_type* [num_space_dim], memory_space> _neighbor_shifts;
+    Kokkos::View<int* [num_space_dim], memory_space> _cells;
+    Kokkos::View<std::size_t*, memory_space> _export_offsets;
+    Kokkos::View<int*, memory_space> _export_counts;
+    Kokkos::View<int*, memory_space> _export_ids;
+    Kokkos::View<int*, memory_space> _export_ranks;
+    Kokkos::View<scalar_type* [num_space_dim], memory_space> _export_shifts;
+    Kokkos::View<scalar_type**, Kokkos::LayoutRight, memory_space>
+        _ghost_shifts;
+    std::shared_ptr<halo_type> _halo;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a particle ghosting plan from the grid decomposition.
+
+  \param exec_space Kokkos execution space.
+  \param local_grid The local grid defining the decomposition.
+  \param positions Locally owned particle positions.
+  \param ghost_width Number of cells from the owned domain boundary in which
+  particles are ghosted.
+  \return Shared pointer to a ParticleGridHalo.
+*/
+template <class ExecutionSpace, class MeshType, class PositionSliceType>
+auto createParticleGridHalo( ExecutionSpace exec_space,
+                             const LocalGrid<MeshType>& local_grid,
+                             const PositionSliceType& positions,
+                             const int ghost_width )
+{
+    using memory_space = typename PositionSliceType::memory_space;
+    return std::make_shared<ParticleGridHalo<memory_space, MeshType>>(
+        exec_space, local_grid, positions, ghost_width );
+}
+
+/*!
+  \brief Create a particle ghosting plan from the grid decomposition.
+
+  \param local_grid The local grid defining the decomposition.
+  \param positions Locally owned particle positions.
+  \param ghost_width Number of cells from the owned domain boundary in which
+  particles are ghosted.
+  \return Shared pointer to a ParticleGridHalo.
+*/
+template <class MeshType, class PositionSliceType>
+auto createParticleGridHalo( const LocalGrid<MeshType>& local_grid,
+                             const PositionSliceType& positions,
+                             const int ghost_width )
+{
+    using execution_space = typename PositionSliceType::execution_space;
+    return createParticleGridHalo( execution_space{}, local_grid, positions,
+                                   ghost_width );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cajita
+
+#endif // end CAJITA_PARTICLEGRIDHALO_HPP
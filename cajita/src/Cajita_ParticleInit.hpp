@@ -158,7 +158,7 @@ int createParticles(
                 }
             }
         } );
-    Kokkos::fence();
+    exec_space.fence();
 
     auto count_host =
         Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), count );
@@ -430,7 +430,7 @@ int createParticles(
                         }
                     }
         } );
-    Kokkos::fence();
+    exec_space.fence();
 
     auto count_host =
         Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), count );
@@ -335,29 +335,40 @@ class SparseDimPartitioner : public BlockPartitioner<NumSpaceDim>
     /*!
          \brief set all elements in _workload_per_tile and _workload_prefix_sum
          matrix to 0
+         \param exec_space The execution space to use.
        */
-    void resetWorkload()
+    template <class ExecSpace>
+    void resetWorkload( const ExecSpace& exec_space )
     {
-        Kokkos::deep_copy( _workload_per_tile, 0 );
-        Kokkos::deep_copy( _workload_prefix_sum, 0 );
+        Kokkos::deep_copy( exec_space, _workload_per_tile, 0 );
+        Kokkos::deep_copy( exec_space, _workload_prefix_sum, 0 );
     }
 
+    /*!
+         \brief set all elements in _workload_per_tile and _workload_prefix_sum
+         matrix to 0
+       */
+    void resetWorkload() { resetWorkload( execution_space() ); }
+
     /*!
       \brief compute the workload in the current MPI rank from particle
       positions (each particle count for 1 workload value)
+      \param exec_space The execution space to use.
       \param view particle positions view
       \param particle_num total particle number
       \param global_lower_corner the coordinate of the domain global lower
       corner
       \param dx cell dx size
     */
-    template <class ParticlePosViewType, typename ArrayType, typename CellUnit>
-    void computeLocalWorkLoad( const ParticlePosViewType& view,
+    template <class ExecSpace, class ParticlePosViewType, typename ArrayType,
+              typename CellUnit>
+    void computeLocalWorkLoad( const ExecSpace& exec_space,
+                               const ParticlePosViewType& view,
                                int particle_num,
                                const ArrayType& global_lower_corner,
                                const CellUnit dx )
     {
-        resetWorkload();
+        resetWorkload( exec_space );
         // make a local copy
         auto workload = _workload_per_tile;
         Kokkos::Array<CellUnit, num_space_dim> lower_corner;
@@ -368,7 +379,7 @@ class SparseDimPartitioner : public BlockPartitioner<NumSpaceDim>
 
         Kokkos::parallel_for(
             "compute_local_workload_parpos",
-            Kokkos::RangePolicy<execution_space>( 0, particle_num ),
+            Kokkos::RangePolicy<ExecSpace>( exec_space, 0, particle_num ),
             KOKKOS_LAMBDA( const int i ) {
                 int ti = static_cast<int>(
                              ( view( i, 0 ) - lower_corner[0] ) / dx - 0.5 ) >>
@@ -381,23 +392,45 @@ class SparseDimPartitioner : public BlockPartitioner<NumSpaceDim>
                          cell_bits_per_tile_dim;
                 Kokkos::atomic_increment( &workload( ti + 1, tj + 1, tz + 1 ) );
             } );
-        Kokkos::fence();
+        exec_space.fence();
+    }
+
+    /*!
+      \brief compute the workload in the current MPI rank from particle
+      positions (each particle count for 1 workload value)
+      \param view particle positions view
+      \param particle_num total particle number
+      \param global_lower_corner the coordinate of the domain global lower
+      corner
+      \param dx cell dx size
+    */
+    template <class ParticlePosViewType, typename ArrayType, typename CellUnit>
+    void computeLocalWorkLoad( const ParticlePosViewType& view,
+                               int particle_num,
+                               const ArrayType& global_lower_corner,
+                               const CellUnit dx )
+    {
+        computeLocalWorkLoad( execution_space(), view, particle_num,
+                              global_lower_corner, dx );
     }
 
     /*!
       \brief compute the workload in the current MPI rank from sparseMap
       (the workload of a tile is 1 if the tile is occupied, 0 otherwise)
+      \param exec_space The execution space to use.
       \param sparseMap sparseMap in the current rank
     */
-    template <class SparseMapType>
-    void computeLocalWorkLoad( const SparseMapType& sparseMap )
+    template <class ExecSpace, class SparseMapType>
+    void computeLocalWorkLoad( const ExecSpace& exec_space,
+                               const SparseMapType& sparseMap )
     {
-        resetWorkload();
+        resetWorkload( exec_space );
         // make a local copy
         auto workload = _workload_per_tile;
         Kokkos::parallel_for(
             "compute_local_workload_sparsmap",
-            Kokkos::RangePolicy<execution_space>( 0, sparseMap.capacity() ),
+            Kokkos::RangePolicy<ExecSpace>( exec_space, 0,
+                                            sparseMap.capacity() ),
             KOKKOS_LAMBDA( uint32_t i ) {
                 if ( sparseMap.valid_at( i ) )
                 {
@@ -408,15 +441,28 @@ class SparseDimPartitioner : public BlockPartitioner<NumSpaceDim>
                         &workload( ti + 1, tj + 1, tk + 1 ) );
                 }
             } );
-        Kokkos::fence();
+        exec_space.fence();
+    }
+
+    /*!
+      \brief compute the workload in the current MPI rank from sparseMap
+      (the workload of a tile is 1 if the tile is occupied, 0 otherwise)
+      \param sparseMap sparseMap in the current rank
+    */
+    template <class SparseMapType>
+    void computeLocalWorkLoad( const SparseMapType& sparseMap )
+    {
+        computeLocalWorkLoad( execution_space(), sparseMap );
     }
 
     /*!
       \brief 1. reduce the total workload in all MPI ranks; 2. compute the
       workload prefix sum matrix for all MPI ranks
+      \param exec_space The execution space to use.
       \param comm MPI communicator used for workload reduction
     */
-    void computeFullPrefixSum( MPI_Comm comm )
+    template <class ExecSpace>
+    void computeFullPrefixSum( const ExecSpace& exec_space, MPI_Comm comm )
     {
         // local copy
         auto workload = _workload_per_tile;
@@ -438,8 +484,8 @@ class SparseDimPartitioner : public BlockPartitioner<NumSpaceDim>
                   ++k )
                 Kokkos::parallel_scan(
                     "scan_prefix_sum_dim0",
-                    Kokkos::RangePolicy<execution_space>(
-                        0, _workload_prefix_sum.extent( 0 ) ),
+                    Kokkos::RangePolicy<ExecSpace>(
+                        exec_space, 0, _workload_prefix_sum.extent( 0 ) ),
                     KOKKOS_LAMBDA( const int i, int& update,
                                    const bool final ) {
                         const float val_i = prefix_sum( i, j, k );
@@ -449,7 +495,6 @@ class SparseDimPartitioner : public BlockPartitioner<NumSpaceDim>
                             prefix_sum( i, j, k ) = update;
                         }
                     } );
-        Kokkos::fence();
 
         // prefix sum in the dimension 1
         for ( int i = 0;
@@ -459,8 +504,8 @@ class SparseDimPartitioner : public BlockPartitioner<NumSpaceDim>
                   ++k )
                 Kokkos::parallel_scan(
                     "scan_prefix_sum_dim1",
-                    Kokkos::RangePolicy<execution_space>(
-                        0, _workload_prefix_sum.extent( 1 ) ),
+                    Kokkos::RangePolicy<ExecSpace>(
+                        exec_space, 0, _workload_prefix_sum.extent( 1 ) ),
                     KOKKOS_LAMBDA( const int j, int& update,
                                    const bool final ) {
                         const float val_i = prefix_sum( i, j, k );
@@ -470,7 +515,6 @@ class SparseDimPartitioner : public BlockPartitioner<NumSpaceDim>
                             prefix_sum( i, j, k ) = update;
                         }
                     } );
-        Kokkos::fence();
 
         // prefix sum in the dimension 2
         for ( int i = 0;
@@ -480,8 +524,8 @@ class SparseDimPartitioner : public BlockPartitioner<NumSpaceDim>
                   ++j )
                 Kokkos::parallel_scan(
                     "scan_prefix_sum_dim2",
-                    Kokkos::RangePolicy<execution_space>(
-                        0, _workload_prefix_sum.extent( 2 ) ),
+                    Kokkos::RangePolicy<ExecSpace>(
+                        exec_space, 0, _workload_prefix_sum.extent( 2 ) ),
                     KOKKOS_LAMBDA( const int k, int& update,
                                    const bool final ) {
                         const float val_i = prefix_sum( i, j, k );
@@ -491,11 +535,22 @@ class SparseDimPartitioner : public BlockPartitioner<NumSpaceDim>
                             prefix_sum( i, j, k ) = update;
                         }
                     } );
-        Kokkos::fence();
+        exec_space.fence();
+    }
+
+    /*!
+      \brief 1. reduce the total workload in all MPI ranks; 2. compute the
+      workload prefix sum matrix for all MPI ranks
+      \param comm MPI communicator used for workload reduction
+    */
+    void computeFullPrefixSum( MPI_Comm comm )
+    {
+        computeFullPrefixSum( execution_space(), comm );
     }
 
     /*!
       \brief iteratively optimize the partition
+      \param exec_space The execution space to use.
       \param view particle positions view
       \param particle_num total particle number
       \param global_lower_corner the coordinate of the domain global lower
@@ -504,15 +559,18 @@ class SparseDimPartitioner : public BlockPartitioner<NumSpaceDim>
       \param comm MPI communicator used for workload reduction
       \return iteration number
     */
-    template <class ParticlePosViewType, typename ArrayType, typename CellUnit>
-    int optimizePartition( const ParticlePosViewType& view, int particle_num,
+    template <class ExecSpace, class ParticlePosViewType, typename ArrayType,
+              typename CellUnit>
+    int optimizePartition( const ExecSpace& exec_space,
+                           const ParticlePosViewType& view, int particle_num,
                            const ArrayType& global_lower_corner,
                            const CellUnit dx, MPI_Comm comm )
     {
-        computeLocalWorkLoad( view, particle_num, global_lower_corner, dx );
+        computeLocalWorkLoad( exec_space, view, particle_num,
+                              global_lower_corner, dx );
         MPI_Barrier( comm );
 
-        computeFullPrefixSum( comm );
+        computeFullPrefixSum( exec_space, comm );
         MPI_Barrier( comm );
 
         // each iteration covers partitioner optization in all three dimensions
@@ -528,7 +586,8 @@ class SparseDimPartitioner : public BlockPartitioner<NumSpaceDim>
                     random_dim_id = std::rand() % num_space_dim;
 
                 bool is_dim_changed = false; // record changes in current dim
-                optimizePartition( is_dim_changed, random_dim_id );
+                optimizePartition( exec_space, is_dim_changed,
+                                   random_dim_id );
 
                 // update control info
                 is_changed = is_changed || is_dim_changed;
@@ -543,17 +602,38 @@ class SparseDimPartitioner : public BlockPartitioner<NumSpaceDim>
 
     /*!
       \brief iteratively optimize the partition
+      \param view particle positions view
+      \param particle_num total particle number
+      \param global_lower_corner the coordinate of the domain global lower
+      corner
+      \param dx cell dx size
+      \param comm MPI communicator used for workload reduction
+      \return iteration number
+    */
+    template <class ParticlePosViewType, typename ArrayType, typename CellUnit>
+    int optimizePartition( const ParticlePosViewType& view, int particle_num,
+                           const ArrayType& global_lower_corner,
+                           const CellUnit dx, MPI_Comm comm )
+    {
+        return optimizePartition( execution_space(), view, particle_num,
+                                  global_lower_corner, dx, comm );
+    }
+
+    /*!
+      \brief iteratively optimize the partition
+      \param exec_space The execution space to use.
       \param sparseMap sparseMap in the current rank
       \param comm MPI communicator used for workload reduction
       \return iteration number
     */
-    template <class SparseMapType>
-    int optimizePartition( const SparseMapType& sparseMap, MPI_Comm comm )
+    template <class ExecSpace, class SparseMapType>
+    int optimizePartition( const ExecSpace& exec_space,
+                           const SparseMapType& sparseMap, MPI_Comm comm )
     {
-        computeLocalWorkLoad( sparseMap );
+        computeLocalWorkLoad( exec_space, sparseMap );
         MPI_Barrier( comm );
 
-        computeFullPrefixSum( comm );
+        computeFullPrefixSum( exec_space, comm );
         MPI_Barrier( comm );
 
         for ( int i = 0; i < _max_optimize_iteration; ++i )
@@ -567,7 +647,8 @@ class SparseDimPartitioner : public BlockPartitioner<NumSpaceDim>
                     random_dim_id = std::rand() % num_space_dim;
 
                 bool is_dim_changed = false; // record changes in current dim
-                optimizePartition( is_dim_changed, random_dim_id );
+                optimizePartition( exec_space, is_dim_changed,
+                                   random_dim_id );
 
                 // update control info
                 is_changed = is_changed || is_dim_changed;
@@ -580,13 +661,28 @@ class SparseDimPartitioner : public BlockPartitioner<NumSpaceDim>
         return _max_optimize_iteration;
     }
 
+    /*!
+      \brief iteratively optimize the partition
+      \param sparseMap sparseMap in the current rank
+      \param comm MPI communicator used for workload reduction
+      \return iteration number
+    */
+    template <class SparseMapType>
+    int optimizePartition( const SparseMapType& sparseMap, MPI_Comm comm )
+    {
+        return optimizePartition( execution_space(), sparseMap, comm );
+    }
+
     /*!
       \brief optimize the partition in three dimensions seperately
+      \param exec_space The execution space to use.
       \param is_changed label if the partition is changed after the optimization
       \param iter_seed seed number to choose the starting dimension of the
       optimization
     */
-    void optimizePartition( bool& is_changed, int iter_seed )
+    template <class ExecSpace>
+    void optimizePartition( const ExecSpace& exec_space, bool& is_changed,
+                            int iter_seed )
     {
         is_changed = false;
         // loop over three dimensions, optimize the partition in dimension di
@@ -614,8 +710,8 @@ class SparseDimPartitioner : public BlockPartitioner<NumSpaceDim>
                 "ave_workload", _ranks_per_dim[dj] * _ranks_per_dim[dk] );
             Kokkos::parallel_for(
                 "compute_average_workload",
-                Kokkos::RangePolicy<execution_space>(
-                    0, _ranks_per_dim[dj] * _ranks_per_dim[dk] ),
+                Kokkos::RangePolicy<ExecSpace>(
+                    exec_space, 0, _ranks_per_dim[dj] * _ranks_per_dim[dk] ),
                 KOKKOS_LAMBDA( uint32_t jnk ) {
                     // compute rank_id in the fixed dimensions
                     int j = static_cast<int>( jnk / rank_k );
@@ -627,7 +723,6 @@ class SparseDimPartitioner : public BlockPartitioner<NumSpaceDim>
                                               dj, j, dk, k ) /
                         rank;
                 } );
-            Kokkos::fence();
 
             // point_i: current partition position
             int point_i = 1;
@@ -647,21 +742,22 @@ class SparseDimPartitioner : public BlockPartitioner<NumSpaceDim>
                     // compute current workload between [last_point, point_i)
                     Kokkos::parallel_for(
                         "compute_current_workload",
-                        Kokkos::RangePolicy<execution_space>(
-                            0, _ranks_per_dim[dj] * _ranks_per_dim[dk] ),
+                        Kokkos::RangePolicy<ExecSpace>(
+                            exec_space, 0,
+                            _ranks_per_dim[dj] * _ranks_per_dim[dk] ),
                         KOKKOS_LAMBDA( uint32_t jnk ) {
                             int j = static_cast<int>( jnk / rank_k );
                             int k = static_cast<int>( jnk % rank_k );
                             current_workload( jnk ) = compute_sub_workload(
                                 di, last_point, point_i, dj, j, dk, k );
                         } );
-                    Kokkos::fence();
 
                     // compute the (w_jk^ave - w_jk^{last_point:point_i})
                     Kokkos::parallel_for(
                         "compute_diff",
-                        Kokkos::RangePolicy<execution_space>(
-                            0, _ranks_per_dim[dj] * _ranks_per_dim[dk] ),
+                        Kokkos::RangePolicy<ExecSpace>(
+                            exec_space, 0,
+                            _ranks_per_dim[dj] * _ranks_per_dim[dk] ),
                         KOKKOS_LAMBDA( uint32_t jnk ) {
                             auto wl =
                                 current_workload( jnk ) - ave_workload( jnk );
@@ -671,20 +767,19 @@ class SparseDimPartitioner : public BlockPartitioner<NumSpaceDim>
                             wl = wl > 0 ? wl : -wl;
                             current_workload( jnk ) = wl;
                         } );
-                    Kokkos::fence();
 
                     // compute the sum of the difference in all rank_j*rank_k
                     // regions
                     int diff;
                     Kokkos::parallel_reduce(
                         "diff_reduce",
-                        Kokkos::RangePolicy<execution_space>(
-                            0, _ranks_per_dim[dj] * _ranks_per_dim[dk] ),
+                        Kokkos::RangePolicy<ExecSpace>(
+                            exec_space, 0,
+                            _ranks_per_dim[dj] * _ranks_per_dim[dk] ),
                         KOKKOS_LAMBDA( const int idx, int& update ) {
                             update += current_workload( idx );
                         },
                         diff );
-                    Kokkos::fence();
 
                     // record the new optimal position
                     if ( diff <= last_diff )
@@ -724,6 +819,17 @@ class SparseDimPartitioner : public BlockPartitioner<NumSpaceDim>
         } // end for (3 dimensions)
     }
 
+    /*!
+      \brief optimize the partition in three dimensions seperately
+      \param is_changed label if the partition is changed after the optimization
+      \param iter_seed seed number to choose the starting dimension of the
+      optimization
+    */
+    void optimizePartition( bool& is_changed, int iter_seed )
+    {
+        optimizePartition( execution_space(), is_changed, iter_seed );
+    }
+
     /*!
       \brief compute the total workload on the current MPI rank
       \param cart_comm MPI cartesian communicator
@@ -325,10 +325,11 @@ class SparseHalo
         \tparam ExecSpace execution space
         \tparam SparseMapType sparse map type
         \tparam scalar_type scalar type (type of dx)
+        \param exec_space execution space instance
         \param map sparse map
     */
     template <class ExecSpace, class SparseMapType>
-    void register_halo( SparseMapType& map )
+    void register_halo( const ExecSpace& exec_space, SparseMapType& map )
     {
         // return if there's no valid neighbors
         int num_n = _neighbor_ranks.size();
@@ -351,7 +352,8 @@ class SparseHalo
             // this steering keys will later be used for halo data collection
 
             Kokkos::parallel_for(
-                Kokkos::RangePolicy<ExecSpace>( 0, map.capacity() ),
+                Kokkos::RangePolicy<ExecSpace>( exec_space, 0,
+                                                map.capacity() ),
                 KOKKOS_LAMBDA( const int index ) {
                     if ( map.valid_at( index ) )
                     {
@@ -370,8 +372,21 @@ class SparseHalo
                         }
                     }
                 } );
-            Kokkos::fence();
         }
+        exec_space.fence();
+    }
+
+    /*!
+        \brief register valid halos (according to grid activation status in
+       sparse map) in the steerings
+        \tparam ExecSpace execution space
+        \tparam SparseMapType sparse map type
+        \param map sparse map
+    */
+    template <class ExecSpace, class SparseMapType>
+    void register_halo( SparseMapType& map )
+    {
+        register_halo( ExecSpace(), map );
     }
 
     //---------------------------------------------------------------------------//
@@ -657,7 +672,7 @@ class SparseHalo
             packBuffer( exec_space, _owned_buffers[nid],
                         _owned_tile_steering[nid], sparse_array,
                         h_counting( Index::own ) );
-            Kokkos::fence();
+            exec_space.fence();
 
             MPI_Isend(
                 _owned_buffers[nid].data(),
@@ -692,7 +707,7 @@ class SparseHalo
                               _ghosted_buffers[nid], _tmp_tile_steering[nid],
                               sparse_array, map,
                               h_neighbor_counting( Index::own ) );
-                Kokkos::fence();
+                exec_space.fence();
             }
         }
 
@@ -831,7 +846,7 @@ class SparseHalo
             packBuffer( exec_space, _ghosted_buffers[nid],
                         _ghosted_tile_steering[nid], sparse_array,
                         h_counting( Index::ghost ) );
-            Kokkos::fence();
+            exec_space.fence();
 
             MPI_Isend( _ghosted_buffers[nid].data(),
                        h_counting( Index::ghost ) * cell_num_per_tile *
@@ -866,7 +881,7 @@ class SparseHalo
                 unpackBuffer( reduce_op, exec_space, _owned_buffers[nid],
                               _tmp_tile_steering[nid], sparse_array, map,
                               h_neighbor_counting( Index::ghost ) );
-                Kokkos::fence();
+                exec_space.fence();
             }
         }
 
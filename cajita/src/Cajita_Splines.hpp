@@ -854,6 +854,194 @@ KOKKOS_INLINE_FUNCTION void evaluateSpline(
     setSplineData( SplinePhysicalDistance(), data, low_x, p, dx );
 }
 
+//---------------------------------------------------------------------------//
+// Batched spline evaluation.
+//---------------------------------------------------------------------------//
+//! \cond Impl
+// Vectorize the loop which follows over the lanes of a batch. Only host
+// compilation passes see the OpenMP pragma.
+#if defined( _OPENMP ) && !defined( __CUDA_ARCH__ ) &&                        \
+    !defined( __HIP_DEVICE_COMPILE__ ) && !defined( __SYCL_DEVICE_ONLY__ )
+#define CAJITA_IMPL_SIMD_LOOP _Pragma( "omp simd" )
+#elif defined( KOKKOS_ENABLE_PRAGMA_IVDEP )
+#define CAJITA_IMPL_SIMD_LOOP _Pragma( "ivdep" )
+#else
+#define CAJITA_IMPL_SIMD_LOOP
+#endif
+//! \endcond
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Spline data for a batch of particles stored in one AoSoA struct.
+
+  Data is stored as structure-of-arrays with the particle (lane) index
+  innermost such that evaluating the spline for all lanes of a struct has
+  contiguous, unit-stride loads and stores and no per-particle SplineData
+  struct to block vectorization across particles. A view of batches, one per
+  struct, holds the spline data of all particles in the AoSoA layout, from
+  which the lanes of a simd_parallel_for() load their data with unit stride.
+
+  \tparam Scalar Scalar type for geometric operations.
+  \tparam Order Spline order.
+  \tparam NumSpaceDim Spatial dimension.
+  \tparam VectorLength Number of particles in the batch. This is the vector
+  length of the AoSoA holding the particles.
+  \tparam EntityType Mesh entity type on which the spline is defined.
+*/
+template <typename Scalar, int Order, std::size_t NumSpaceDim, int VectorLength,
+          class EntityType>
+struct SplineBatchData
+{
+    //! Spline scalar type.
+    using scalar_type = Scalar;
+    //! Spline order.
+    static constexpr int order = Order;
+    //! Spline type.
+    using spline_type = Spline<Order>;
+    //! The number of non-zero knots in the spline.
+    static constexpr int num_knot = spline_type::num_knot;
+    //! Entity type.
+    using entity_type = EntityType;
+    //! Spatial dimension.
+    static constexpr std::size_t num_space_dim = NumSpaceDim;
+    //! Number of particles in the batch.
+    static constexpr int vector_length = VectorLength;
+
+    //! Number of valid particles in the batch.
+    int num_lane;
+    //! Physical cell size.
+    Scalar dx[NumSpaceDim];
+    //! Physical location of the low corner of the local mesh.
+    Scalar low_x[NumSpaceDim];
+    //! Logical position.
+    Scalar x[NumSpaceDim][VectorLength];
+    //! Local interpolation stencil.
+    int s[NumSpaceDim][num_knot][VectorLength];
+    //! Weight values.
+    Scalar w[NumSpaceDim][num_knot][VectorLength];
+    //! Weight physical gradients.
+    Scalar g[NumSpaceDim][num_knot][VectorLength];
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Evaluate spline data for all particles of one AoSoA struct in a
+  uniform mesh.
+
+  The mesh geometry is computed once for the batch. The stencils, weights,
+  and gradients of every particle in the struct are then evaluated one
+  dimension at a time in a vectorized loop over all lanes of the struct. The
+  spline weights are branch-free closed forms such that each lane loop maps
+  to the vector units of the host. Lanes past the end of the slice are
+  evaluated at the low corner of the mesh and are not valid.
+
+  \param local_mesh The local mesh.
+  \param positions Particle position slice. The slice vector length must
+  match the batch vector length.
+  \param s The struct index of the batch in the slice.
+  \param data The batch spline data.
+*/
+template <typename Scalar, int Order, std::size_t NumSpaceDim, int VectorLength,
+          class MemorySpace, class EntityType, class PositionSliceType>
+KOKKOS_INLINE_FUNCTION void evaluateSplineBatch(
+    const LocalMesh<MemorySpace, UniformMesh<Scalar, NumSpaceDim>>& local_mesh,
+    const PositionSliceType& positions, const int s,
+    SplineBatchData<Scalar, Order, NumSpaceDim, VectorLength, EntityType>&
+        data )
+{
+    static_assert( PositionSliceType::vector_length == VectorLength,
+                   "Position slice and batch vector lengths must match" );
+
+    using spline_type = Spline<Order>;
+    constexpr int num_knot = spline_type::num_knot;
+
+    // Number of particles in this struct.
+    int num_lane = positions.size() - s * VectorLength;
+    data.num_lane = ( num_lane < VectorLength ) ? num_lane : VectorLength;
+
+    // Get the low corner of the mesh.
+    Scalar low_x_p1[NumSpaceDim];
+    int low_id[NumSpaceDim];
+    int low_id_p1[NumSpaceDim];
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+    {
+        low_id[d] = 0;
+        low_id_p1[d] = 1;
+    }
+    local_mesh.coordinates( EntityType(), low_id, data.low_x );
+    local_mesh.coordinates( EntityType(), low_id_p1, low_x_p1 );
+
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+    {
+        // Compute the physical cell size and its inverse.
+        data.dx[d] = low_x_p1[d] - data.low_x[d];
+        Scalar rdx = 1.0 / data.dx[d];
+        Scalar low_x = data.low_x[d];
+        int valid_lane = data.num_lane;
+
+        // Evaluate every lane in this dimension.
+        CAJITA_IMPL_SIMD_LOOP
+        for ( int a = 0; a < VectorLength; ++a )
+        {
+            Scalar xp = ( a < valid_lane )
+                            ? static_cast<Scalar>( positions.access( s, a, d ) )
+                            : low_x;
+            Scalar x0 = spline_type::mapToLogicalGrid( xp, rdx, low_x );
+            data.x[d][a] = x0;
+
+            int sten[num_knot];
+            Scalar w[num_knot];
+            Scalar g[num_knot];
+            spline_type::stencil( x0, sten );
+            spline_type::value( x0, w );
+            spline_type::gradient( x0, rdx, g );
+            for ( int n = 0; n < num_knot; ++n )
+            {
+                data.s[d][n][a] = sten[n];
+                data.w[d][n][a] = w[n];
+                data.g[d][n][a] = g[n];
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Load the spline data of one particle from its batch.
+
+  The stencil, weights, and gradients are loaded from the lane of the batch
+  and the physical distance is computed from the particle position. Loads
+  by the lanes of a simd_parallel_for() have unit stride.
+
+  \param batch The batch spline data of the particle struct.
+  \param a The lane of the particle in the batch.
+  \param p The particle position.
+  \param data The spline data of the particle.
+*/
+template <typename Scalar, int Order, std::size_t NumSpaceDim, int VectorLength,
+          class EntityType>
+KOKKOS_INLINE_FUNCTION void loadSplineData(
+    const SplineBatchData<Scalar, Order, NumSpaceDim, VectorLength,
+                          EntityType>& batch,
+    const int a, const Scalar p[NumSpaceDim],
+    SplineData<Scalar, Order, NumSpaceDim, EntityType>& data )
+{
+    using spline_type = Spline<Order>;
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+    {
+        data.dx[d] = batch.dx[d];
+        data.x[d] = batch.x[d][a];
+        Scalar offset = batch.low_x[d] - p[d];
+        for ( int n = 0; n < spline_type::num_knot; ++n )
+        {
+            data.s[d][n] = batch.s[d][n][a];
+            data.w[d][n] = batch.w[d][n][a];
+            data.g[d][n] = batch.g[d][n][a];
+            data.d[d][n] = offset + data.s[d][n] * batch.dx[d];
+        }
+    }
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Cajita
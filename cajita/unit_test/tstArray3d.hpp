@@ -407,6 +407,26 @@ void arrayOpTest()
                 for ( long l = 0; l < ghosted_space.extent( 3 ); ++l )
                     EXPECT_DOUBLE_EQ( host_view( i, j, k, l ),
                                       ( 3.0 + 1.0 + 6.0 ) * scales[l] );
+
+    // Redo the 3 vector update on an execution space instance, fencing only
+    // that instance.
+    TEST_EXECSPACE exec_space;
+    ArrayOp::assign( exec_space, *array, 1.0, Ghost() );
+    ArrayOp::scale( exec_space, *array, scales, Ghost() );
+    ArrayOp::assign( exec_space, *array_2, 0.5, Ghost() );
+    ArrayOp::scale( exec_space, *array_2, scales, Ghost() );
+    ArrayOp::copy( exec_space, *array_3, *array_2, Ghost() );
+    ArrayOp::scale( exec_space, *array_3, 3.0, Ghost() );
+    ArrayOp::update( exec_space, *array, 3.0, *array_2, 2.0, *array_3, 4.0,
+                     Ghost() );
+    Kokkos::deep_copy( exec_space, host_view, array->view() );
+    exec_space.fence();
+    for ( long i = 0; i < ghosted_space.extent( Dim::I ); ++i )
+        for ( long j = 0; j < ghosted_space.extent( Dim::J ); ++j )
+            for ( long k = 0; k < ghosted_space.extent( Dim::K ); ++k )
+                for ( long l = 0; l < ghosted_space.extent( 3 ); ++l )
+                    EXPECT_DOUBLE_EQ( host_view( i, j, k, l ),
+                                      ( 3.0 + 1.0 + 6.0 ) * scales[l] );
 }
 
 //---------------------------------------------------------------------------//
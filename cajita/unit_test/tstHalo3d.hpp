@@ -24,6 +24,7 @@
 
 #include <array>
 #include <cmath>
+#include <tuple>
 
 using namespace Cajita;
 
@@ -331,6 +332,47 @@ void gatherScatterTest( const ManualBlockPartitioner<3>& partitioner,
         checkScatter( is_dim_periodic, halo_width, *edge_j_array );
         checkScatter( is_dim_periodic, halo_width, *edge_k_array );
     }
+
+    // Repeat the process but this time with a group of halos of different
+    // widths exchanged together.
+    {
+        auto cell_layout =
+            createArrayLayout( global_grid, array_halo_width, 4, Cell() );
+        auto cell_array =
+            createArray<double, TEST_MEMSPACE>( "cell_array", cell_layout );
+        ArrayOp::assign( *cell_array, 0.0, Ghost() );
+        ArrayOp::assign( *cell_array, 1.0, Own() );
+
+        auto node_layout =
+            createArrayLayout( global_grid, array_halo_width, 3, Node() );
+        auto node_array =
+            createArray<float, TEST_MEMSPACE>( "node_array", node_layout );
+        ArrayOp::assign( *node_array, 0.0, Ghost() );
+        ArrayOp::assign( *node_array, 1.0, Own() );
+
+        // Create a group from a halo for each array.
+        int cell_width = 1;
+        int node_width = 2;
+        auto cell_halo =
+            createHalo( NodeHaloPattern<3>(), cell_width, *cell_array );
+        auto node_halo =
+            createHalo( NodeHaloPattern<3>(), node_width, *node_array );
+        auto group = createHaloGroup<TEST_MEMSPACE>( { cell_halo, node_halo } );
+        EXPECT_EQ( group->numHalo(), 2u );
+        EXPECT_LE( group->numMessage(), 26u );
+
+        // Gather into the ghosts and check.
+        group->gather( TEST_EXECSPACE(), std::tie( *cell_array ),
+                       std::tie( *node_array ) );
+        checkGather( is_dim_periodic, cell_width, *cell_array );
+        checkGather( is_dim_periodic, node_width, *node_array );
+
+        // Scatter from the ghosts back to owned and check.
+        group->scatter( TEST_EXECSPACE(), ScatterReduce::Sum(),
+                        std::tie( *cell_array ), std::tie( *node_array ) );
+        checkScatter( is_dim_periodic, cell_width, *cell_array );
+        checkScatter( is_dim_periodic, node_width, *node_array );
+    }
 }
 
 //---------------------------------------------------------------------------//
@@ -446,6 +488,355 @@ void scatterReduceTest( const ReduceFunc& reduce )
     }
 }
 
+//---------------------------------------------------------------------------//
+// Gather with an upwind stencil reading +x (two cells) and -y (one cell).
+void stencilHaloTest()
+{
+    // Create the global grid.
+    double cell_size = 0.23;
+    std::array<int, 3> global_num_cell = { 17, 20, 21 };
+    std::array<double, 3> global_low_corner = { 1.2, 3.3, -2.8 };
+    std::array<double, 3> global_high_corner = {
+        global_low_corner[0] + cell_size * global_num_cell[0],
+        global_low_corner[1] + cell_size * global_num_cell[1],
+        global_low_corner[2] + cell_size * global_num_cell[2] };
+    auto global_mesh = createUniformGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    auto global_grid =
+        createGlobalGrid( MPI_COMM_WORLD, global_mesh, is_dim_periodic,
+                          DimBlockPartitioner<3>() );
+
+    // Create an array on the cells with a value depending on the global cell
+    // index on owned cells and a sentinel on ghosts.
+    int array_halo_width = 2;
+    auto cell_layout =
+        createArrayLayout( global_grid, array_halo_width, 1, Cell() );
+    auto array = createArray<double, TEST_MEMSPACE>( "array", cell_layout );
+    double sentinel = -1.0;
+    ArrayOp::assign( *array, sentinel, Ghost() );
+    auto global_value = [&]( const int gi, const int gj, const int gk )
+    {
+        auto wrap = [&]( const int g, const int d )
+        {
+            return ( g + global_num_cell[d] ) % global_num_cell[d];
+        };
+        return 1.0 + wrap( gi, 0 ) +
+               global_num_cell[0] *
+                   ( wrap( gj, 1 ) + global_num_cell[1] * wrap( gk, 2 ) );
+    };
+    auto owned_space = cell_layout->indexSpace( Own(), Local() );
+    auto ghosted_space = cell_layout->indexSpace( Ghost(), Local() );
+    int offset[3];
+    for ( int d = 0; d < 3; ++d )
+        offset[d] = global_grid->globalOffset( d ) - owned_space.min( d );
+    auto host_view = Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                          array->view() );
+    for ( int i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
+          ++i )
+        for ( int j = owned_space.min( Dim::J ); j < owned_space.max( Dim::J );
+              ++j )
+            for ( int k = owned_space.min( Dim::K );
+                  k < owned_space.max( Dim::K ); ++k )
+                host_view( i, j, k, 0 ) = global_value(
+                    i + offset[0], j + offset[1], k + offset[2] );
+    Kokkos::deep_copy( array->view(), host_view );
+
+    // Create the pattern. Only the +x and -y ghosts are read but the -x and
+    // +y neighbors are still needed to send data.
+    StencilHaloPattern<3> pattern(
+        { { 1, 0, 0 }, { 2, 0, 0 }, { 0, -1, 0 } } );
+    EXPECT_EQ( pattern.getNeighbors().size(), 4u );
+
+    // Gather.
+    auto halo = createHalo( pattern, array_halo_width, *array );
+    halo->gather( TEST_EXECSPACE(), *array );
+
+    // The ghosts read by the stencil get the values of the periodic image of
+    // their global cell. All other ghosts keep the sentinel.
+    Kokkos::deep_copy( host_view, array->view() );
+    for ( int i = 0; i < ghosted_space.extent( Dim::I ); ++i )
+        for ( int j = 0; j < ghosted_space.extent( Dim::J ); ++j )
+            for ( int k = 0; k < ghosted_space.extent( Dim::K ); ++k )
+            {
+                int ijk[3] = { i, j, k };
+                int region[3];
+                int distance[3];
+                for ( int d = 0; d < 3; ++d )
+                {
+                    region[d] = 0;
+                    distance[d] = 0;
+                    if ( ijk[d] < owned_space.min( d ) )
+                    {
+                        region[d] = -1;
+                        distance[d] = owned_space.min( d ) - ijk[d];
+                    }
+                    else if ( ijk[d] >= owned_space.max( d ) )
+                    {
+                        region[d] = 1;
+                        distance[d] = ijk[d] - owned_space.max( d ) + 1;
+                    }
+                }
+                bool filled =
+                    ( region[0] == 0 && region[1] == 0 && region[2] == 0 ) ||
+                    ( region[0] == 1 && region[1] == 0 && region[2] == 0 ) ||
+                    ( region[0] == 0 && region[1] == -1 && region[2] == 0 &&
+                      distance[1] <= 1 );
+                double expected =
+                    filled ? global_value( i + offset[0], j + offset[1],
+                                           k + offset[2] )
+                           : sentinel;
+                EXPECT_DOUBLE_EQ( host_view( i, j, k, 0 ), expected );
+            }
+}
+
+//---------------------------------------------------------------------------//
+// Check the ghosts on the physical boundaries against their mirror images.
+template <class HostView, class GlobalGridType, class IndexSpaceType>
+void checkBoundary( const HostView& host_view,
+                    const GlobalGridType& global_grid,
+                    const IndexSpaceType& owned_space,
+                    const IndexSpaceType& ghosted_space,
+                    const std::array<bool, 3>& node_dim, const int dof,
+                    const int kind, const double value )
+{
+    for ( int i = 0; i < ghosted_space.extent( Dim::I ); ++i )
+        for ( int j = 0; j < ghosted_space.extent( Dim::J ); ++j )
+            for ( int k = 0; k < ghosted_space.extent( Dim::K ); ++k )
+            {
+                int ijk[3] = { i, j, k };
+                int mirror[3] = { i, j, k };
+                bool ghost = false;
+                bool physical = true;
+                for ( int d = 0; d < 3; ++d )
+                {
+                    int lo = owned_space.min( d );
+                    int hi = owned_space.max( d );
+                    if ( ijk[d] < lo )
+                    {
+                        ghost = true;
+                        physical = physical && global_grid.onLowBoundary( d );
+                        mirror[d] = node_dim[d] ? 2 * lo - ijk[d]
+                                                : 2 * lo - 1 - ijk[d];
+                    }
+                    else if ( ijk[d] >= hi )
+                    {
+                        ghost = true;
+                        physical =
+                            physical && global_grid.onHighBoundary( d );
+                        mirror[d] = node_dim[d] ? 2 * hi - 2 - ijk[d]
+                                                : 2 * hi - 1 - ijk[d];
+                    }
+                }
+                if ( !ghost || !physical )
+                    continue;
+                double mirror_value =
+                    host_view( mirror[0], mirror[1], mirror[2], dof );
+                if ( 0 == kind )
+                    EXPECT_DOUBLE_EQ( host_view( i, j, k, dof ), value );
+                else if ( 1 == kind )
+                    EXPECT_DOUBLE_EQ( host_view( i, j, k, dof ),
+                                      mirror_value );
+                else
+                    EXPECT_DOUBLE_EQ( host_view( i, j, k, dof ),
+                                      -mirror_value );
+            }
+}
+
+//---------------------------------------------------------------------------//
+void boundaryConditionTest()
+{
+    // Create a non-periodic global grid.
+    double cell_size = 0.23;
+    std::array<int, 3> global_num_cell = { 17, 20, 21 };
+    std::array<double, 3> global_low_corner = { 1.2, 3.3, -2.8 };
+    std::array<double, 3> global_high_corner = {
+        global_low_corner[0] + cell_size * global_num_cell[0],
+        global_low_corner[1] + cell_size * global_num_cell[1],
+        global_low_corner[2] + cell_size * global_num_cell[2] };
+    auto global_mesh = createUniformGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+    std::array<bool, 3> is_dim_periodic = { false, false, false };
+    auto global_grid =
+        createGlobalGrid( MPI_COMM_WORLD, global_mesh, is_dim_periodic,
+                          DimBlockPartitioner<3>() );
+
+    // Create a cell array with two dofs and a node array with one. Fill the
+    // owned entities with unique values.
+    int halo_width = 2;
+    auto cell_layout =
+        createArrayLayout( global_grid, halo_width, 2, Cell() );
+    auto node_layout =
+        createArrayLayout( global_grid, halo_width, 1, Node() );
+    auto cell_array =
+        createArray<double, TEST_MEMSPACE>( "cell_array", cell_layout );
+    auto node_array =
+        createArray<double, TEST_MEMSPACE>( "node_array", node_layout );
+    ArrayOp::assign( *cell_array, 0.0, Ghost() );
+    ArrayOp::assign( *node_array, 0.0, Ghost() );
+    auto fill = []( const auto& array )
+    {
+        auto owned_space = array.layout()->indexSpace( Own(), Local() );
+        auto host_view = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), array.view() );
+        for ( int i = owned_space.min( 0 ); i < owned_space.max( 0 ); ++i )
+            for ( int j = owned_space.min( 1 ); j < owned_space.max( 1 ); ++j )
+                for ( int k = owned_space.min( 2 ); k < owned_space.max( 2 );
+                      ++k )
+                    for ( int l = owned_space.min( 3 );
+                          l < owned_space.max( 3 ); ++l )
+                        host_view( i, j, k, l ) =
+                            1.0 + i + 100.0 * j + 10000.0 * k + 0.5 * l;
+        Kokkos::deep_copy( array.view(), host_view );
+    };
+    fill( *cell_array );
+    fill( *node_array );
+
+    // Register the boundary conditions and gather.
+    auto halo = createHalo( NodeHaloPattern<3>(), halo_width, *cell_array,
+                            *node_array );
+    halo->addBoundaryCondition( BoundaryCondition::Dirichlet{ 3.0 }, 0,
+                                *cell_array, 0 );
+    halo->addBoundaryCondition( BoundaryCondition::Neumann(), 0, *cell_array,
+                                1 );
+    halo->addBoundaryCondition( BoundaryCondition::Reflect(), 1,
+                                *node_array );
+    bool on_boundary = false;
+    for ( int d = 0; d < 3; ++d )
+        on_boundary = on_boundary || global_grid->onLowBoundary( d ) ||
+                      global_grid->onHighBoundary( d );
+    EXPECT_EQ( on_boundary, halo->numBoundaryElement() > 0 );
+    halo->gather( TEST_EXECSPACE(), *cell_array, *node_array );
+
+    // Check the cell ghosts.
+    auto cell_view = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), cell_array->view() );
+    checkBoundary( cell_view, *global_grid,
+                   cell_layout->indexSpace( Own(), Local() ),
+                   cell_layout->indexSpace( Ghost(), Local() ),
+                   { false, false, false }, 0, 0, 3.0 );
+    checkBoundary( cell_view, *global_grid,
+                   cell_layout->indexSpace( Own(), Local() ),
+                   cell_layout->indexSpace( Ghost(), Local() ),
+                   { false, false, false }, 1, 1, 0.0 );
+
+    // Check the node ghosts.
+    auto node_view = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), node_array->view() );
+    checkBoundary( node_view, *global_grid,
+                   node_layout->indexSpace( Own(), Local() ),
+                   node_layout->indexSpace( Ghost(), Local() ),
+                   { true, true, true }, 0, 2, 0.0 );
+}
+
+//---------------------------------------------------------------------------//
+void mixedBoundaryConditionTest()
+{
+    // Create a global grid periodic in y only such that the physical
+    // boundaries in x and z meet a periodic dimension at edges and corners.
+    double cell_size = 0.23;
+    std::array<int, 3> global_num_cell = { 17, 20, 21 };
+    std::array<double, 3> global_low_corner = { 1.2, 3.3, -2.8 };
+    std::array<double, 3> global_high_corner = {
+        global_low_corner[0] + cell_size * global_num_cell[0],
+        global_low_corner[1] + cell_size * global_num_cell[1],
+        global_low_corner[2] + cell_size * global_num_cell[2] };
+    auto global_mesh = createUniformGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+    std::array<bool, 3> is_dim_periodic = { false, true, false };
+    auto global_grid =
+        createGlobalGrid( MPI_COMM_WORLD, global_mesh, is_dim_periodic,
+                          DimBlockPartitioner<3>() );
+
+    // Create a cell array with one dof per boundary condition kind. Fill the
+    // owned cells with values depending on the global cell index.
+    int halo_width = 2;
+    auto layout = createArrayLayout( global_grid, halo_width, 3, Cell() );
+    auto array = createArray<double, TEST_MEMSPACE>( "array", layout );
+    ArrayOp::assign( *array, 0.0, Ghost() );
+    auto global_value = [&]( const int gi, const int gj, const int gk,
+                             const int l )
+    {
+        int wj = ( gj + global_num_cell[1] ) % global_num_cell[1];
+        return 1.0 + gi + 100.0 * wj + 10000.0 * gk + 0.5 * l;
+    };
+    auto owned_space = layout->indexSpace( Own(), Local() );
+    auto ghosted_space = layout->indexSpace( Ghost(), Local() );
+    int offset[3];
+    for ( int d = 0; d < 3; ++d )
+        offset[d] = global_grid->globalOffset( d ) - owned_space.min( d );
+    auto host_view = Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                          array->view() );
+    for ( int i = owned_space.min( 0 ); i < owned_space.max( 0 ); ++i )
+        for ( int j = owned_space.min( 1 ); j < owned_space.max( 1 ); ++j )
+            for ( int k = owned_space.min( 2 ); k < owned_space.max( 2 ); ++k )
+                for ( int l = 0; l < 3; ++l )
+                    host_view( i, j, k, l ) = global_value(
+                        i + offset[0], j + offset[1], k + offset[2], l );
+    Kokkos::deep_copy( array->view(), host_view );
+
+    // Register the boundary conditions and gather.
+    auto halo = createHalo( NodeHaloPattern<3>(), halo_width, *array );
+    halo->addBoundaryCondition( BoundaryCondition::Dirichlet{ 3.0 }, 0,
+                                *array, 0 );
+    halo->addBoundaryCondition( BoundaryCondition::Neumann(), 0, *array, 1 );
+    halo->addBoundaryCondition( BoundaryCondition::Reflect(), 0, *array, 2 );
+    halo->gather( TEST_EXECSPACE(), *array );
+
+    // Ghosts are mirrored across the physical boundaries only. Mirrors
+    // falling in the ghosts of the other dimensions hold the received values
+    // of their global cell. Ghosts without a physical boundary are received.
+    Kokkos::deep_copy( host_view, array->view() );
+    for ( int i = 0; i < ghosted_space.extent( Dim::I ); ++i )
+        for ( int j = 0; j < ghosted_space.extent( Dim::J ); ++j )
+            for ( int k = 0; k < ghosted_space.extent( Dim::K ); ++k )
+            {
+                int ijk[3] = { i, j, k };
+                int mirror[3] = { i, j, k };
+                bool ghost = false;
+                bool physical = false;
+                for ( int d = 0; d < 3; ++d )
+                {
+                    int lo = owned_space.min( d );
+                    int hi = owned_space.max( d );
+                    if ( ijk[d] < lo )
+                    {
+                        ghost = true;
+                        if ( !is_dim_periodic[d] &&
+                             global_grid->onLowBoundary( d ) )
+                        {
+                            physical = true;
+                            mirror[d] = 2 * lo - 1 - ijk[d];
+                        }
+                    }
+                    else if ( ijk[d] >= hi )
+                    {
+                        ghost = true;
+                        if ( !is_dim_periodic[d] &&
+                             global_grid->onHighBoundary( d ) )
+                        {
+                            physical = true;
+                            mirror[d] = 2 * hi - 1 - ijk[d];
+                        }
+                    }
+                }
+                if ( !ghost )
+                    continue;
+                for ( int l = 0; l < 3; ++l )
+                {
+                    double source = global_value( mirror[0] + offset[0],
+                                                  mirror[1] + offset[1],
+                                                  mirror[2] + offset[2], l );
+                    double expected = source;
+                    if ( physical && 0 == l )
+                        expected = 3.0;
+                    else if ( physical && 2 == l )
+                        expected = -source;
+                    EXPECT_DOUBLE_EQ( host_view( i, j, k, l ), expected );
+                }
+            }
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
@@ -540,6 +931,18 @@ TEST( TEST_CATEGORY, scatter_reduce_replace_test )
     scatterReduceTest( ScatterReduce::Replace() );
 }
 
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, stencil_halo_test ) { stencilHaloTest(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, boundary_condition_test ) { boundaryConditionTest(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, mixed_boundary_condition_test )
+{
+    mixedBoundaryConditionTest();
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
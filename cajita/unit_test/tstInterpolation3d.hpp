@@ -11,6 +11,8 @@
 
 #include <Kokkos_Core.hpp>
 
+#include <Cabana_AoSoA.hpp>
+
 #include <Cajita_Array.hpp>
 #include <Cajita_GlobalGrid.hpp>
 #include <Cajita_GlobalMesh.hpp>
@@ -250,11 +252,142 @@ void interpolationTest()
         EXPECT_FLOAT_EQ( scalar_point_host( p ) + 1.0, 1.0 );
 }
 
+//---------------------------------------------------------------------------//
+void interpolationBatchTest()
+{
+    // Create the global mesh.
+    std::array<double, 3> low_corner = { -1.2, 0.1, 1.1 };
+    std::array<double, 3> high_corner = { -0.3, 9.5, 2.3 };
+    double cell_size = 0.1;
+    auto global_mesh =
+        createUniformGlobalMesh( low_corner, high_corner, cell_size );
+
+    // Create the global grid.
+    DimBlockPartitioner<3> partitioner;
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+
+    // Create a  grid local_grid.
+    int halo_width = 2;
+    auto local_grid = createLocalGrid( global_grid, halo_width );
+    auto local_mesh = createLocalMesh<TEST_MEMSPACE>( *local_grid );
+
+    // Create a point in every cell offset from the cell center by a
+    // different amount in each dimension. Store the points both in a View
+    // for the scalar path and in an AoSoA for the batched path.
+    auto cell_space = local_grid->indexSpace( Own(), Cell(), Local() );
+    int num_point = cell_space.size();
+    Kokkos::View<double* [3], TEST_MEMSPACE> points(
+        Kokkos::ViewAllocateWithoutInitializing( "points" ), num_point );
+    Cabana::AoSoA<Cabana::MemberTypes<double[3]>, TEST_MEMSPACE> particles(
+        "particles", num_point );
+    auto positions = Cabana::slice<0>( particles );
+    Kokkos::parallel_for(
+        "fill_points", createExecutionPolicy( cell_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            int pi = i - halo_width;
+            int pj = j - halo_width;
+            int pk = k - halo_width;
+            int pid = pi + cell_space.extent( Dim::I ) *
+                               ( pj + cell_space.extent( Dim::J ) * pk );
+            int idx[3] = { i, j, k };
+            double x[3];
+            local_mesh.coordinates( Cell(), idx, x );
+            for ( int d = 0; d < 3; ++d )
+            {
+                points( pid, d ) =
+                    x[d] + ( ( pid + 2 * d ) % 7 - 3 ) * cell_size / 7.0;
+                positions( pid, d ) = points( pid, d );
+            }
+        } );
+
+    // Create a scalar field on the grid which varies over the grid.
+    auto scalar_layout = createArrayLayout( local_grid, 1, Node() );
+    auto scalar_grid_field = createArray<double, TEST_MEMSPACE>(
+        "scalar_grid_field", scalar_layout );
+    auto scalar_halo =
+        createHalo( NodeHaloPattern<3>(), halo_width, *scalar_grid_field );
+    auto node_space = local_grid->indexSpace( Own(), Node(), Local() );
+    auto scalar_view = scalar_grid_field->view();
+    Kokkos::parallel_for(
+        "fill_grid", createExecutionPolicy( node_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            scalar_view( i, j, k, 0 ) = 1.0 + 0.1 * i + 0.01 * j + 0.001 * k;
+        } );
+
+    // Create point fields for the scalar and batched results.
+    Kokkos::View<double*, TEST_MEMSPACE> scalar_value( "scalar_value",
+                                                       num_point );
+    Kokkos::View<double*, TEST_MEMSPACE> batch_value( "batch_value",
+                                                      num_point );
+    Kokkos::View<double* [3], TEST_MEMSPACE> scalar_grad( "scalar_grad",
+                                                          num_point );
+    Kokkos::View<double* [3], TEST_MEMSPACE> batch_grad( "batch_grad",
+                                                         num_point );
+
+    // G2P
+    // ---
+
+    // Interpolate the scalar value and gradient with both paths.
+    g2p( *scalar_grid_field, *scalar_halo, points, num_point, Spline<3>(),
+         createScalarValueG2P( scalar_value, -0.5 ) );
+    g2pBatch( *scalar_grid_field, *scalar_halo, positions, Spline<3>(),
+              createScalarValueG2P( batch_value, -0.5 ) );
+    g2p( *scalar_grid_field, *scalar_halo, points, num_point, Spline<3>(),
+         createScalarGradientG2P( scalar_grad, -0.5 ) );
+    g2pBatch( *scalar_grid_field, *scalar_halo, positions, Spline<3>(),
+              createScalarGradientG2P( batch_grad, -0.5 ) );
+
+    auto scalar_value_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), scalar_value );
+    auto batch_value_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), batch_value );
+    auto scalar_grad_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), scalar_grad );
+    auto batch_grad_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), batch_grad );
+    for ( int p = 0; p < num_point; ++p )
+    {
+        EXPECT_NEAR( batch_value_host( p ), scalar_value_host( p ), 1.0e-12 );
+        for ( int d = 0; d < 3; ++d )
+            EXPECT_NEAR( batch_grad_host( p, d ), scalar_grad_host( p, d ),
+                         1.0e-10 );
+    }
+
+    // P2G
+    // ---
+
+    // Interpolate the point values back to the grid with both paths.
+    auto scalar_grid_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), scalar_grid_field->view() );
+    ArrayOp::assign( *scalar_grid_field, 0.0, Ghost() );
+    p2g( createScalarValueP2G( scalar_value, 2.0 ), points, num_point,
+         Spline<3>(), *scalar_halo, *scalar_grid_field );
+    Kokkos::deep_copy( scalar_grid_host, scalar_grid_field->view() );
+
+    auto batch_grid_host = Kokkos::create_mirror_view( scalar_grid_host );
+    ArrayOp::assign( *scalar_grid_field, 0.0, Ghost() );
+    p2gBatch( createScalarValueP2G( scalar_value, 2.0 ), positions,
+              Spline<3>(), *scalar_halo, *scalar_grid_field );
+    Kokkos::deep_copy( batch_grid_host, scalar_grid_field->view() );
+
+    for ( int i = node_space.min( Dim::I ); i < node_space.max( Dim::I ); ++i )
+        for ( int j = node_space.min( Dim::J ); j < node_space.max( Dim::J );
+              ++j )
+            for ( int k = node_space.min( Dim::K );
+                  k < node_space.max( Dim::K ); ++k )
+                EXPECT_NEAR( batch_grid_host( i, j, k, 0 ),
+                             scalar_grid_host( i, j, k, 0 ), 1.0e-10 );
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
 TEST( interpolation, interpolation_test ) { interpolationTest(); }
 
+TEST( interpolation, interpolation_batch_test ) { interpolationBatchTest(); }
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
@@ -761,6 +761,42 @@ void irregularTest3d( const std::array<int, 3>& ranks_per_dim )
                                            own_cell_local_space.min( Dim::K ) );
                 EXPECT_FLOAT_EQ( z_loc, compute_z );
             }
+
+    // Check that the cached cell metrics match the metrics computed from the
+    // edges everywhere in the ghosted domain.
+    auto cached_mesh = createLocalMesh<TEST_MEMSPACE>( *local_grid, true );
+    EXPECT_FALSE( local_mesh.hasMetricCache() );
+    EXPECT_TRUE( cached_mesh.hasMetricCache() );
+    auto metric_error = createView<double, TEST_MEMSPACE>(
+        "metric_error", ghost_cell_local_space );
+    Kokkos::parallel_for(
+        "check_cached_metrics",
+        createExecutionPolicy( ghost_cell_local_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            int idx[3] = { i, j, k };
+            double loc[3];
+            double cached_loc[3];
+            local_mesh.coordinates( Cell(), idx, loc );
+            cached_mesh.coordinates( Cell(), idx, cached_loc );
+            double error = fabs( local_mesh.measure( Cell(), idx ) -
+                                 cached_mesh.measure( Cell(), idx ) );
+            for ( int d = 0; d < 3; ++d )
+            {
+                error += fabs( loc[d] - cached_loc[d] );
+                error += fabs( local_mesh.cellWidth( d, idx[d] ) -
+                               cached_mesh.cellWidth( d, idx[d] ) );
+                error += fabs( cached_mesh.cellWidth( d, idx[d] ) *
+                                   cached_mesh.inverseCellWidth( d, idx[d] ) -
+                               1.0 );
+            }
+            metric_error( i, j, k ) = error;
+        } );
+    auto metric_error_h = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), metric_error );
+    for ( int i = 0; i < ghost_cell_local_space.extent( Dim::I ); ++i )
+        for ( int j = 0; j < ghost_cell_local_space.extent( Dim::J ); ++j )
+            for ( int k = 0; k < ghost_cell_local_space.extent( Dim::K ); ++k )
+                EXPECT_NEAR( metric_error_h( i, j, k ), 0.0, 1.0e-12 );
 }
 
 //---------------------------------------------------------------------------//
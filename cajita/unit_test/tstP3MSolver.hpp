@@ -0,0 +1,164 @@
+/****************************************************************************
+ * Copyright (c) 2018-2023 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
+#include <Cabana_VerletList.hpp>
+
+#include <Cajita_GlobalGrid.hpp>
+#include <Cajita_GlobalMesh.hpp>
+#include <Cajita_LocalGrid.hpp>
+#include <Cajita_LocalMesh.hpp>
+#include <Cajita_P3MSolver.hpp>
+#include <Cajita_ParticleGridHalo.hpp>
+#include <Cajita_Partitioner.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <array>
+#include <cmath>
+
+using namespace Cajita;
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+// Compute the Madelung energy of a periodic rock salt lattice.
+template <int SplineOrder, class DifferentiationType>
+void madelungTest()
+{
+    // Create a periodic box with 4 ions per dimension.
+    double box = 2.0;
+    double spacing = 0.5;
+    int num_ion = 4;
+    int num_cell = 32;
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    std::array<double, 3> global_low_corner = { 0.0, 0.0, 0.0 };
+    std::array<double, 3> global_high_corner = { box, box, box };
+    std::array<int, 3> global_num_cell = { num_cell, num_cell, num_cell };
+    auto global_mesh = createUniformGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+    DimBlockPartitioner<3> partitioner;
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+    auto local_grid = createLocalGrid( global_grid, 2 );
+    auto local_mesh = createLocalMesh<Kokkos::HostSpace>( *local_grid );
+
+    // Create the ions owned by this rank with alternating charges.
+    using member_types = Cabana::MemberTypes<double[3], double, double[3]>;
+    Cabana::AoSoA<member_types, Kokkos::HostSpace> ions_host( "ions" );
+    for ( int i = 0; i < num_ion; ++i )
+        for ( int j = 0; j < num_ion; ++j )
+            for ( int k = 0; k < num_ion; ++k )
+            {
+                int ijk[3] = { i, j, k };
+                double x[3];
+                bool owned = true;
+                for ( int d = 0; d < 3; ++d )
+                {
+                    x[d] = ( ijk[d] + 0.3 ) * spacing;
+                    owned = owned && x[d] >= local_mesh.lowCorner( Own(), d ) &&
+                            x[d] < local_mesh.highCorner( Own(), d );
+                }
+                if ( owned )
+                {
+                    ions_host.resize( ions_host.size() + 1 );
+                    auto tp = ions_host.getTuple( ions_host.size() - 1 );
+                    for ( int d = 0; d < 3; ++d )
+                    {
+                        Cabana::get<0>( tp, d ) = x[d];
+                        Cabana::get<2>( tp, d ) = 0.0;
+                    }
+                    Cabana::get<1>( tp ) = ( ( i + j + k ) % 2 ) ? -1.0 : 1.0;
+                    ions_host.setTuple( ions_host.size() - 1, tp );
+                }
+            }
+    auto ions = Cabana::create_mirror_view_and_copy( TEST_MEMSPACE(),
+                                                     ions_host );
+    int num_local = ions.size();
+
+    // Create the solver.
+    double r_cut = 0.6;
+    double alpha = 3.5 / r_cut;
+    auto solver =
+        Experimental::createP3MSolver<TEST_MEMSPACE, SplineOrder,
+                                      DifferentiationType>( local_grid, alpha,
+                                                            r_cut );
+
+    // Compute the long-range part.
+    auto x = Cabana::slice<0>( ions );
+    auto q = Cabana::slice<1>( ions );
+    auto f = Cabana::slice<2>( ions );
+    double energy =
+        solver->computeLongRange( TEST_EXECSPACE(), x, q, f, num_local );
+
+    // Gather ghosts within the cutoff and compute the short-range part.
+    int ghost_width = std::ceil( r_cut / global_mesh->cellSize( 0 ) );
+    auto particle_halo = createParticleGridHalo( TEST_EXECSPACE(), *local_grid,
+                                                 x, ghost_width );
+    ions.resize( particle_halo->numLocal() + particle_halo->numGhost() );
+    x = Cabana::slice<0>( ions );
+    q = Cabana::slice<1>( ions );
+    f = Cabana::slice<2>( ions );
+    particle_halo->gather( TEST_EXECSPACE(), ions, x );
+    double grid_min[3];
+    double grid_max[3];
+    for ( int d = 0; d < 3; ++d )
+    {
+        grid_min[d] = local_mesh.lowCorner( Own(), d ) - r_cut;
+        grid_max[d] = local_mesh.highCorner( Own(), d ) + r_cut;
+    }
+    Cabana::VerletList<TEST_MEMSPACE, Cabana::FullNeighborTag,
+                       Cabana::VerletLayoutCSR, Cabana::TeamOpTag>
+        neighbors( x, 0, num_local, r_cut, 1.0, grid_min, grid_max );
+    energy += solver->computeShortRange( TEST_EXECSPACE(), neighbors, x, q, f,
+                                         num_local );
+
+    // Check the energy against the Madelung constant. The energy per ion pair
+    // is -M/a for nearest neighbor distance a.
+    double madelung = 1.747564594633;
+    double num_pair = 0.5 * num_ion * num_ion * num_ion;
+    double expected = -madelung * num_pair / spacing;
+    EXPECT_NEAR( energy, expected, 2.0e-3 * std::abs( expected ) );
+
+    // The net force on every ion vanishes by symmetry.
+    ions.resize( num_local );
+    ions_host =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), ions );
+    auto f_host = Cabana::slice<2>( ions_host );
+    for ( int p = 0; p < num_local; ++p )
+        for ( int d = 0; d < 3; ++d )
+            EXPECT_NEAR( f_host( p, d ), 0.0, 1.0e-2 );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( p3m, ik_test )
+{
+    madelungTest<2, Experimental::P3MIkDifferentiation>();
+    madelungTest<3, Experimental::P3MIkDifferentiation>();
+}
+
+//---------------------------------------------------------------------------//
+TEST( p3m, analytical_test )
+{
+    madelungTest<3, Experimental::P3MAnalyticalDifferentiation>();
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
@@ -335,6 +335,163 @@ void removeOutsideTest( const GridType global_grid )
     EXPECT_EQ( particles_mirror.size(), 0 );
 }
 
+//---------------------------------------------------------------------------//
+// The objective of this test is to check migration when particles move farther
+// than a neighbor rank. Every rank creates a particle at the center of every
+// global cell, so every rank sends to every other rank. If periodic, the
+// particles are first shifted by multiple global extents to check the wrapping
+// as well.
+template <class GridType>
+void globalMigrateTest( const GridType global_grid, const double cell_size,
+                        const bool periodic )
+{
+    auto block = Cajita::createLocalGrid( global_grid, 1 );
+    auto local_mesh = Cajita::createLocalMesh<Kokkos::HostSpace>( *block );
+    const auto& global_mesh = global_grid->globalMesh();
+
+    int comm_size;
+    MPI_Comm_size( MPI_COMM_WORLD, &comm_size );
+
+    // Put particles in the center of every global cell. Add one particle
+    // outside the global domain which should be removed if not periodic.
+    std::array<int, 3> global_num_cell;
+    for ( int d = 0; d < 3; ++d )
+        global_num_cell[d] = global_grid->globalNumEntity( Cajita::Cell(), d );
+    int num_global = global_num_cell[Dim::I] * global_num_cell[Dim::J] *
+                     global_num_cell[Dim::K];
+    using MemberTypes = Cabana::MemberTypes<double[3], int>;
+    using ParticleContainer = Cabana::AoSoA<MemberTypes, Kokkos::HostSpace>;
+    ParticleContainer particles( "particles", num_global + 1 );
+    auto coords = Cabana::slice<0>( particles, "coords" );
+    auto linear_ids = Cabana::slice<1>( particles, "linear_ids" );
+    int pid = 0;
+    for ( int k = 0; k < global_num_cell[Dim::K]; ++k )
+        for ( int j = 0; j < global_num_cell[Dim::J]; ++j )
+            for ( int i = 0; i < global_num_cell[Dim::I]; ++i, ++pid )
+            {
+                int ijk[3] = { i, j, k };
+                for ( int d = 0; d < 3; ++d )
+                {
+                    coords( pid, d ) = global_mesh.lowCorner( d ) +
+                                       ( ijk[d] + 0.5 ) * cell_size;
+                    if ( periodic )
+                        coords( pid, d ) +=
+                            ( ( pid + d ) % 5 - 2 ) * global_mesh.extent( d );
+                }
+                linear_ids( pid ) = global_grid->blockId();
+            }
+    for ( int d = 0; d < 3; ++d )
+        coords( num_global, d ) = global_mesh.highCorner( d ) + 0.5 * cell_size;
+    linear_ids( num_global ) = global_grid->blockId();
+
+    // Redistribute the particles.
+    auto particles_mirror =
+        Cabana::create_mirror_view_and_copy( TEST_MEMSPACE(), particles );
+    auto coords_mirror = Cabana::slice<0>( particles_mirror, "coords" );
+    Cajita::particleGridMigrate( *block, coords_mirror, particles_mirror, 0,
+                                 true, Cajita::GlobalMigrateTag() );
+
+    // Copy back to check.
+    particles = Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                     particles_mirror );
+    coords = Cabana::slice<0>( particles, "coords" );
+    linear_ids = Cabana::slice<1>( particles, "linear_ids" );
+
+    // Every rank sent us one particle per owned cell.
+    auto owned_cell_space =
+        block->indexSpace( Cajita::Own(), Cajita::Cell(), Cajita::Local() );
+    int num_expected = comm_size * owned_cell_space.size();
+    if ( periodic )
+    {
+        // The particle outside the domain is wrapped to the low corner.
+        if ( global_grid->onLowBoundary( Dim::I ) &&
+             global_grid->onLowBoundary( Dim::J ) &&
+             global_grid->onLowBoundary( Dim::K ) )
+            num_expected += comm_size;
+    }
+    EXPECT_EQ( particles.size(), num_expected );
+
+    // Check that all of the particles are now in the local domain and that
+    // every rank sent the same number.
+    std::vector<int> count( comm_size, 0 );
+    for ( std::size_t p = 0; p < particles.size(); ++p )
+    {
+        for ( int d = 0; d < 3; ++d )
+        {
+            EXPECT_GE( coords( p, d ),
+                       local_mesh.lowCorner( Cajita::Own(), d ) );
+            EXPECT_LE( coords( p, d ),
+                       local_mesh.highCorner( Cajita::Own(), d ) );
+        }
+        ++count[linear_ids( p )];
+    }
+    for ( int r = 0; r < comm_size; ++r )
+        EXPECT_EQ( count[r], num_expected / comm_size );
+}
+
+//---------------------------------------------------------------------------//
+// The objective of this test is to check the non-periodic boundary policies.
+// Ranks on the low boundary of each dimension create a particle just outside
+// of it, at the center of their owned domain in the other dimensions.
+template <class GridType, class MigrateTag, class BoundaryTag>
+void boundaryPolicyTest( const GridType global_grid, const double cell_size,
+                         MigrateTag tag, BoundaryTag boundary_tag,
+                         const bool removed, const double expected_offset )
+{
+    auto block = Cajita::createLocalGrid( global_grid, 1 );
+    auto local_mesh = Cajita::createLocalMesh<Kokkos::HostSpace>( *block );
+    const auto& global_mesh = global_grid->globalMesh();
+
+    using MemberTypes = Cabana::MemberTypes<double[3], int>;
+    using ParticleContainer = Cabana::AoSoA<MemberTypes, Kokkos::HostSpace>;
+    ParticleContainer particles( "particles", 3 );
+    auto coords = Cabana::slice<0>( particles, "coords" );
+    auto dims = Cabana::slice<1>( particles, "dims" );
+    int pid = 0;
+    for ( int d = 0; d < 3; ++d )
+    {
+        if ( global_grid->onLowBoundary( d ) )
+        {
+            for ( int x = 0; x < 3; ++x )
+                coords( pid, x ) =
+                    0.5 * ( local_mesh.lowCorner( Cajita::Own(), x ) +
+                            local_mesh.highCorner( Cajita::Own(), x ) );
+            coords( pid, d ) = global_mesh.lowCorner( d ) - 0.3 * cell_size;
+            dims( pid ) = d;
+            ++pid;
+        }
+    }
+    int num_particle = pid;
+    particles.resize( num_particle );
+
+    // Redistribute the particles.
+    auto particles_mirror =
+        Cabana::create_mirror_view_and_copy( TEST_MEMSPACE(), particles );
+    auto coords_mirror = Cabana::slice<0>( particles_mirror, "coords" );
+    Cajita::particleGridMigrate( *block, coords_mirror, particles_mirror, 0,
+                                 true, tag, boundary_tag );
+
+    // Copy back to check.
+    particles = Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                     particles_mirror );
+    coords = Cabana::slice<0>( particles, "coords" );
+    dims = Cabana::slice<1>( particles, "dims" );
+
+    // Absorbed particles are removed. The others are moved back into the
+    // domain and stay on this rank.
+    if ( removed )
+    {
+        EXPECT_EQ( particles.size(), 0 );
+        return;
+    }
+    EXPECT_EQ( static_cast<int>( particles.size() ), num_particle );
+    for ( std::size_t p = 0; p < particles.size(); ++p )
+        EXPECT_NEAR( coords( p, dims( p ) ),
+                     global_mesh.lowCorner( dims( p ) ) +
+                         expected_offset * cell_size,
+                     1.0e-12 );
+}
+
 auto createGrid( const Cajita::ManualBlockPartitioner<3>& partitioner,
                  const std::array<bool, 3>& is_periodic,
                  const double cell_size )
@@ -453,5 +610,47 @@ TEST( TEST_CATEGORY, remove_outside_domain_test )
     removeOutsideTest( global_grid );
 }
 //---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, global_migrate_test )
+{
+    // Let MPI compute the partitioning for this test.
+    int comm_size;
+    MPI_Comm_size( MPI_COMM_WORLD, &comm_size );
+    std::array<int, 3> ranks_per_dim = { 0, 0, 0 };
+    MPI_Dims_create( comm_size, 3, ranks_per_dim.data() );
+    Cajita::ManualBlockPartitioner<3> partitioner( ranks_per_dim );
+
+    double cell_size = 0.23;
+    for ( auto periodic : { false, true } )
+    {
+        std::array<bool, 3> is_periodic = { periodic, periodic, periodic };
+        auto global_grid = createGrid( partitioner, is_periodic, cell_size );
+        globalMigrateTest( global_grid, cell_size, periodic );
+    }
+}
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, boundary_policy_test )
+{
+    // Let MPI compute the partitioning for this test.
+    int comm_size;
+    MPI_Comm_size( MPI_COMM_WORLD, &comm_size );
+    std::array<int, 3> ranks_per_dim = { 0, 0, 0 };
+    MPI_Dims_create( comm_size, 3, ranks_per_dim.data() );
+    Cajita::ManualBlockPartitioner<3> partitioner( ranks_per_dim );
+
+    // Every boundary is non-periodic.
+    std::array<bool, 3> is_periodic = { false, false, false };
+    double cell_size = 0.23;
+    auto global_grid = createGrid( partitioner, is_periodic, cell_size );
+
+    boundaryPolicyTest( global_grid, cell_size, Cajita::NeighborMigrateTag(),
+                        Cajita::AbsorbBoundaryTag(), true, 0.0 );
+    boundaryPolicyTest( global_grid, cell_size, Cajita::NeighborMigrateTag(),
+                        Cajita::ReflectBoundaryTag(), false, 0.3 );
+    boundaryPolicyTest( global_grid, cell_size, Cajita::NeighborMigrateTag(),
+                        Cajita::InjectBoundaryTag(), false, 0.0 );
+    boundaryPolicyTest( global_grid, cell_size, Cajita::GlobalMigrateTag(),
+                        Cajita::ReflectBoundaryTag(), false, 0.3 );
+}
+//---------------------------------------------------------------------------//
 
 } // end namespace Test
@@ -0,0 +1,165 @@
+/****************************************************************************
+ * Copyright (c) 2018-2023 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
+
+#include <Cajita_GlobalGrid.hpp>
+#include <Cajita_GlobalMesh.hpp>
+#include <Cajita_LocalGrid.hpp>
+#include <Cajita_LocalMesh.hpp>
+#include <Cajita_ParticleGridHalo.hpp>
+#include <Cajita_Partitioner.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <array>
+#include <vector>
+
+namespace Test
+{
+
+using Cajita::Dim;
+
+//---------------------------------------------------------------------------//
+void ghostTest( const bool periodic, const int ghost_width )
+{
+    // Let MPI compute the partitioning for this test.
+    int comm_size;
+    MPI_Comm_size( MPI_COMM_WORLD, &comm_size );
+    std::array<int, 3> ranks_per_dim = { 0, 0, 0 };
+    MPI_Dims_create( comm_size, 3, ranks_per_dim.data() );
+    Cajita::ManualBlockPartitioner<3> partitioner( ranks_per_dim );
+
+    // Create the global grid.
+    double cell_size = 0.23;
+    std::array<int, 3> global_num_cell = { 18, 15, 9 };
+    std::array<double, 3> global_low_corner = { 1.2, 3.3, -2.8 };
+    std::array<double, 3> global_high_corner = {
+        global_low_corner[0] + cell_size * global_num_cell[0],
+        global_low_corner[1] + cell_size * global_num_cell[1],
+        global_low_corner[2] + cell_size * global_num_cell[2] };
+    auto global_mesh = Cajita::createUniformGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+    std::array<bool, 3> is_periodic = { periodic, periodic, periodic };
+    auto global_grid = Cajita::createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                                 is_periodic, partitioner );
+    auto local_grid = Cajita::createLocalGrid( global_grid, 1 );
+    auto local_mesh = Cajita::createLocalMesh<Kokkos::HostSpace>( *local_grid );
+
+    // Put a particle in the center of every owned cell.
+    auto owned_space = local_grid->indexSpace( Cajita::Own(), Cajita::Cell(),
+                                               Cajita::Local() );
+    int num_local = owned_space.size();
+    using MemberTypes = Cabana::MemberTypes<double[3], int>;
+    Cabana::AoSoA<MemberTypes, Kokkos::HostSpace> particles_host(
+        "particles", num_local );
+    auto x_host = Cabana::slice<0>( particles_host );
+    auto rank_host = Cabana::slice<1>( particles_host );
+    int pid = 0;
+    for ( int i = 0; i < owned_space.extent( Dim::I ); ++i )
+        for ( int j = 0; j < owned_space.extent( Dim::J ); ++j )
+            for ( int k = 0; k < owned_space.extent( Dim::K ); ++k, ++pid )
+            {
+                int ijk[3] = { i, j, k };
+                for ( int d = 0; d < 3; ++d )
+                    x_host( pid, d ) =
+                        local_mesh.lowCorner( Cajita::Own(), d ) +
+                        ( ijk[d] + 0.5 ) * cell_size;
+                rank_host( pid ) = global_grid->blockId();
+            }
+    auto particles =
+        Cabana::create_mirror_view_and_copy( TEST_MEMSPACE(), particles_host );
+    auto x = Cabana::slice<0>( particles );
+
+    // Build the ghosting plan.
+    auto particle_halo = Cajita::createParticleGridHalo(
+        TEST_EXECSPACE(), *local_grid, x, ghost_width );
+    EXPECT_EQ( particle_halo->numLocal(), num_local );
+
+    // Every cell within the ghost width of the owned domain which exists in
+    // the global domain should get exactly one ghost.
+    int num_total = 1;
+    for ( int d = 0; d < 3; ++d )
+    {
+        int num_d = owned_space.extent( d );
+        if ( periodic || !global_grid->onLowBoundary( d ) )
+            num_d += ghost_width;
+        if ( periodic || !global_grid->onHighBoundary( d ) )
+            num_d += ghost_width;
+        num_total *= num_d;
+    }
+    EXPECT_EQ( particle_halo->numGhost(), num_total - num_local );
+
+    // Gather the ghosts.
+    particles.resize( particle_halo->numLocal() + particle_halo->numGhost() );
+    x = Cabana::slice<0>( particles );
+    particle_halo->gather( TEST_EXECSPACE(), particles, x );
+
+    // Check that all ghosts are in the ghost region adjacent to the owned
+    // domain.
+    particles_host =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), particles );
+    x_host = Cabana::slice<0>( particles_host );
+    rank_host = Cabana::slice<1>( particles_host );
+    for ( std::size_t p = num_local; p < particles_host.size(); ++p )
+    {
+        bool in_owned = true;
+        for ( int d = 0; d < 3; ++d )
+        {
+            auto low = local_mesh.lowCorner( Cajita::Own(), d );
+            auto high = local_mesh.highCorner( Cajita::Own(), d );
+            EXPECT_GT( x_host( p, d ), low - ghost_width * cell_size );
+            EXPECT_LT( x_host( p, d ), high + ghost_width * cell_size );
+            in_owned =
+                in_owned && x_host( p, d ) > low && x_host( p, d ) < high;
+        }
+        EXPECT_FALSE( in_owned );
+        EXPECT_GE( rank_host( p ), 0 );
+    }
+
+    // The plan is still valid if no particle changed cells.
+    particles.resize( num_local );
+    x = Cabana::slice<0>( particles );
+    EXPECT_FALSE( particle_halo->updateRequired( TEST_EXECSPACE(), x ) );
+
+    // Move the first particle on every rank to a new cell.
+    Kokkos::parallel_for(
+        "move", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, 1 ),
+        KOKKOS_LAMBDA( const int p ) { x( p, Dim::I ) += cell_size; } );
+    Kokkos::fence();
+    EXPECT_TRUE( particle_halo->updateRequired( TEST_EXECSPACE(), x ) );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, not_periodic_test )
+{
+    ghostTest( false, 1 );
+    ghostTest( false, 2 );
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, periodic_test )
+{
+    ghostTest( true, 1 );
+    ghostTest( true, 2 );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
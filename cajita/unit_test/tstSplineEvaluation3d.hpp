@@ -11,6 +11,8 @@
 
 #include <Kokkos_Core.hpp>
 
+#include <Cabana_AoSoA.hpp>
+
 #include <Cajita_GlobalGrid.hpp>
 #include <Cajita_GlobalMesh.hpp>
 #include <Cajita_LocalGrid.hpp>
@@ -23,6 +25,7 @@
 
 #include <mpi.h>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <vector>
@@ -496,6 +499,103 @@ void splineEvaluationTest()
             }
 }
 
+//---------------------------------------------------------------------------//
+template <int Order>
+void splineBatchEvaluationTest()
+{
+    // Create the global mesh.
+    std::array<double, 3> low_corner = { -1.2, 0.1, 1.1 };
+    std::array<double, 3> high_corner = { -0.3, 9.5, 2.3 };
+    double cell_size = 0.05;
+    auto global_mesh =
+        createUniformGlobalMesh( low_corner, high_corner, cell_size );
+
+    // Create the global grid.
+    DimBlockPartitioner<3> partitioner;
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+
+    // Create a local grid.
+    int halo_width = 2;
+    auto local_grid = createLocalGrid( global_grid, halo_width );
+    // Evaluate the batches on the host.
+    auto local_mesh = createLocalMesh<Kokkos::HostSpace>( *local_grid );
+
+    // Create a point in every owned cell offset from the cell center by a
+    // different amount in each dimension. Use a vector length which does not
+    // evenly divide the number of points to check the partial last batch.
+    auto cell_space = local_grid->indexSpace( Own(), Cell(), Local() );
+    int num_point = cell_space.size() - 3;
+    constexpr int vector_length = 16;
+    using point_type = Cabana::AoSoA<Cabana::MemberTypes<double[3]>,
+                                     Kokkos::HostSpace, vector_length>;
+    point_type points( "points", num_point );
+    auto x = Cabana::slice<0>( points );
+    int pid = 0;
+    for ( int k = cell_space.min( Dim::K ); k < cell_space.max( Dim::K ); ++k )
+        for ( int j = cell_space.min( Dim::J ); j < cell_space.max( Dim::J );
+              ++j )
+            for ( int i = cell_space.min( Dim::I );
+                  i < cell_space.max( Dim::I ) && pid < num_point;
+                  ++i, ++pid )
+            {
+                double loc[3];
+                int idx[3] = { i, j, k };
+                local_mesh.coordinates( Cell(), idx, loc );
+                for ( int d = 0; d < 3; ++d )
+                    x( pid, d ) =
+                        loc[d] + ( ( pid + d ) % 7 - 3 ) * cell_size / 7.0;
+            }
+
+    // Evaluate each batch and compare to the scalar evaluation.
+    using batch_type = SplineBatchData<double, Order, 3, vector_length, Node>;
+    using data_type = SplineData<double, Order, 3, Node>;
+    for ( std::size_t s = 0; s < points.numSoA(); ++s )
+    {
+        batch_type batch;
+        evaluateSplineBatch( local_mesh, x, s, batch );
+        int num_lane = std::min( vector_length,
+                                 num_point - static_cast<int>( s ) *
+                                                 vector_length );
+        EXPECT_EQ( batch.num_lane, num_lane );
+        for ( int a = 0; a < batch.num_lane; ++a )
+        {
+            int p = s * vector_length + a;
+            double px[3] = { x( p, 0 ), x( p, 1 ), x( p, 2 ) };
+            data_type sd;
+            evaluateSpline( local_mesh, px, sd );
+            for ( int d = 0; d < 3; ++d )
+            {
+                EXPECT_DOUBLE_EQ( batch.dx[d], sd.dx[d] );
+                EXPECT_DOUBLE_EQ( batch.x[d][a], sd.x[d] );
+                for ( int n = 0; n < data_type::num_knot; ++n )
+                {
+                    EXPECT_EQ( batch.s[d][n][a], sd.s[d][n] );
+                    EXPECT_DOUBLE_EQ( batch.w[d][n][a], sd.w[d][n] );
+                    EXPECT_DOUBLE_EQ( batch.g[d][n][a], sd.g[d][n] );
+                }
+            }
+
+            // Load the particle spline data back from its lane.
+            data_type loaded;
+            loadSplineData( batch, a, px, loaded );
+            for ( int d = 0; d < 3; ++d )
+            {
+                EXPECT_DOUBLE_EQ( loaded.dx[d], sd.dx[d] );
+                EXPECT_DOUBLE_EQ( loaded.x[d], sd.x[d] );
+                for ( int n = 0; n < data_type::num_knot; ++n )
+                {
+                    EXPECT_EQ( loaded.s[d][n], sd.s[d][n] );
+                    EXPECT_DOUBLE_EQ( loaded.w[d][n], sd.w[d][n] );
+                    EXPECT_DOUBLE_EQ( loaded.g[d][n], sd.g[d][n] );
+                    EXPECT_DOUBLE_EQ( loaded.d[d][n], sd.d[d][n] );
+                }
+            }
+        }
+    }
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
@@ -510,6 +610,15 @@ TEST( splines, eval_test )
         SplineWeightValues, SplineWeightPhysicalGradients>>();
 }
 
+//---------------------------------------------------------------------------//
+TEST( splines, batch_eval_test )
+{
+    splineBatchEvaluationTest<0>();
+    splineBatchEvaluationTest<1>();
+    splineBatchEvaluationTest<2>();
+    splineBatchEvaluationTest<3>();
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
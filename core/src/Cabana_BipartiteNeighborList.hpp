@@ -0,0 +1,282 @@
+/****************************************************************************
+ * Copyright (c) 2018-2023 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_BipartiteNeighborList.hpp
+  \brief Neighbor list between two particle sets
+*/
+#ifndef CABANA_BIPARTITENEIGHBORLIST_HPP
+#define CABANA_BIPARTITENEIGHBORLIST_HPP
+
+#include <Cabana_LinkedCellList.hpp>
+#include <Cabana_NeighborList.hpp>
+#include <Cabana_Slice.hpp>
+#include <Cabana_VerletList.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <type_traits>
+
+namespace Cabana
+{
+namespace Impl
+{
+//! \cond Impl
+//---------------------------------------------------------------------------//
+// Search the binned source particles for the neighbors of each target
+// particle. When counting, only the number of neighbors is computed. The
+// list is filled with fillNeighbors.
+template <class MemorySpace, class LayoutTag, class SourceSlice,
+          class TargetSlice>
+struct BipartiteNeighborSearch
+{
+    using memory_space = MemorySpace;
+
+    VerletListData<MemorySpace, LayoutTag> data;
+    LinkedCellList<MemorySpace> source_cells;
+    typename SourceSlice::random_access_slice source;
+    typename TargetSlice::random_access_slice target;
+    double rsqr;
+    Kokkos::Array<int, 3> range;
+    Kokkos::Array<int, 3> num_bin;
+    bool count;
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()( const int t ) const
+    {
+        double xt[3] = { target( t, 0 ), target( t, 1 ), target( t, 2 ) };
+
+        // Find the bin of the target. Targets outside of the source grid only
+        // see the bins of the grid within the stencil.
+        int ijk[3];
+        source_cells.locatePoint( xt[0], xt[1], xt[2], ijk[0], ijk[1],
+                                  ijk[2] );
+        int lo[3];
+        int hi[3];
+        for ( int d = 0; d < 3; ++d )
+        {
+            lo[d] = Kokkos::max( ijk[d] - range[d], 0 );
+            hi[d] = Kokkos::min( ijk[d] + range[d], num_bin[d] - 1 );
+        }
+
+        for ( int i = lo[0]; i <= hi[0]; ++i )
+            for ( int j = lo[1]; j <= hi[1]; ++j )
+                for ( int k = lo[2]; k <= hi[2]; ++k )
+                {
+                    auto offset = source_cells.binOffset( i, j, k );
+                    int size = source_cells.binSize( i, j, k );
+                    for ( int b = 0; b < size; ++b )
+                    {
+                        int s = source_cells.permutation( offset + b );
+                        double r2 = 0.0;
+                        for ( int d = 0; d < 3; ++d )
+                            r2 += ( xt[d] - source( s, d ) ) *
+                                  ( xt[d] - source( s, d ) );
+                        if ( r2 <= rsqr )
+                        {
+                            if ( count )
+                                ++data.counts( t );
+                            else
+                                data.addNeighbor( t, s );
+                        }
+                    }
+                }
+    }
+};
+
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Neighbor list between a set of target particles and a separate set
+  of source particles.
+
+  \tparam MemorySpace The Kokkos memory space for storing the neighbor list.
+  \tparam LayoutTag Tag indicating the neighbor list layout.
+
+  The source particles are binned once in a LinkedCellList which is reused by
+  every build, such that the targets may move and be searched again without
+  binning the sources. The list is indexed by target particle and stores the
+  indices of the source particles within the neighborhood radius. Both the
+  CSR and 2D (and blocked 2D) layouts of the VerletList are supported.
+*/
+template <class MemorySpace, class LayoutTag = VerletLayoutCSR>
+class BipartiteNeighborList
+{
+  public:
+    static_assert( Kokkos::is_memory_space<MemorySpace>::value, "" );
+
+    //! Kokkos memory space in which the neighbor list data resides.
+    using memory_space = MemorySpace;
+
+    //! Kokkos default execution space for this memory space.
+    using execution_space = typename memory_space::execution_space;
+
+    //! Neighbor list data indexed by target particle.
+    VerletListData<memory_space, LayoutTag> _data;
+
+    /*!
+      \brief Default constructor.
+    */
+    BipartiteNeighborList() {}
+
+    /*!
+      \brief Constructor. Given binned source particles and a set of target
+      particle positions calculate the source neighbors of each target.
+
+      \param source_cells The cell list binning the source particles. The
+      source particles must lie within the cell list grid.
+
+      \param source_x The slice containing the source particle positions used
+      to build the cell list.
+
+      \param target_x The slice containing the target particle positions.
+
+      \param begin The beginning target index to compute neighbors for.
+
+      \param end The end target index to compute neighbors for.
+
+      \param neighborhood_radius The radius of the neighborhood. Source
+      particles within this radius of a target are considered neighbors.
+
+      \param max_neigh Optional maximum number of neighbors per target to
+      pre-allocate the neighbor list. Potentially avoids recounting with 2D
+      layouts only.
+    */
+    template <class SourceSlice, class TargetSlice>
+    BipartiteNeighborList(
+        const LinkedCellList<memory_space>& source_cells,
+        SourceSlice source_x, TargetSlice target_x, const std::size_t begin,
+        const std::size_t end, const double neighborhood_radius,
+        const std::size_t max_neigh = 0,
+        typename std::enable_if<( is_slice<SourceSlice>::value &&
+                                  is_slice<TargetSlice>::value ),
+                                int>::type* = 0 )
+    {
+        build( source_cells, source_x, target_x, begin, end,
+               neighborhood_radius, max_neigh );
+    }
+
+    /*!
+      \brief Given binned source particles and a set of target particle
+      positions calculate the source neighbors of each target.
+    */
+    template <class SourceSlice, class TargetSlice>
+    void build( const LinkedCellList<memory_space>& source_cells,
+                SourceSlice source_x, TargetSlice target_x,
+                const std::size_t begin, const std::size_t end,
+                const double neighborhood_radius,
+                const std::size_t max_neigh = 0 )
+    {
+        // Use the default execution space.
+        build( execution_space{}, source_cells, source_x, target_x, begin, end,
+               neighborhood_radius, max_neigh );
+    }
+
+    /*!
+      \brief Given binned source particles and a set of target particle
+      positions calculate the source neighbors of each target.
+    */
+    template <class ExecutionSpace, class SourceSlice, class TargetSlice>
+    void build( ExecutionSpace exec_space,
+                const LinkedCellList<memory_space>& source_cells,
+                SourceSlice source_x, TargetSlice target_x,
+                const std::size_t begin, const std::size_t end,
+                const double neighborhood_radius,
+                const std::size_t max_neigh = 0 )
+    {
+        Kokkos::Profiling::pushRegion( "Cabana::BipartiteNeighborList::build" );
+
+        static_assert( is_accessible_from<memory_space, ExecutionSpace>{}, "" );
+
+        assert( end >= begin );
+        assert( end <= target_x.size() );
+
+        // Create the search functor. Each target searches the source bins
+        // within the neighborhood radius of its own bin.
+        Impl::BipartiteNeighborSearch<memory_space, LayoutTag, SourceSlice,
+                                      TargetSlice>
+            search;
+        search.data.counts = Kokkos::View<int*, memory_space>(
+            "num_neighbors", target_x.size() );
+        search.source_cells = source_cells;
+        search.source = source_x;
+        search.target = target_x;
+        search.rsqr = neighborhood_radius * neighborhood_radius;
+        for ( int d = 0; d < 3; ++d )
+        {
+            search.range[d] = static_cast<int>(
+                std::ceil( neighborhood_radius / source_cells.binDelta( d ) ) );
+            search.num_bin[d] = source_cells.numBin( d );
+        }
+
+        Kokkos::RangePolicy<ExecutionSpace> policy( exec_space, begin, end );
+        Impl::fillNeighbors( exec_space, policy, search, max_neigh,
+                             LayoutTag() );
+
+        // Get the data from the search.
+        _data = search.data;
+
+        Kokkos::Profiling::popRegion();
+    }
+};
+
+//---------------------------------------------------------------------------//
+// Neighbor list interface implementation.
+//---------------------------------------------------------------------------//
+//! BipartiteNeighborList NeighborList interface.
+template <class MemorySpace, class LayoutTag>
+class NeighborList<BipartiteNeighborList<MemorySpace, LayoutTag>>
+{
+  public:
+    //! Kokkos memory space.
+    using memory_space = MemorySpace;
+    //! Neighbor list type.
+    using list_type = BipartiteNeighborList<MemorySpace, LayoutTag>;
+
+    //! Get the maximum number of neighbors per target (total number of
+    //! neighbors for CSR lists).
+    KOKKOS_INLINE_FUNCTION
+    static std::size_t maxNeighbor( const list_type& list )
+    {
+        if constexpr ( std::is_same<LayoutTag, VerletLayoutCSR>::value )
+            return list._data.neighbors.extent( 0 );
+        else
+            return list._data.neighbors.extent( 1 );
+    }
+
+    //! Get the number of source neighbors for a given target index.
+    KOKKOS_INLINE_FUNCTION
+    static std::size_t numNeighbor( const list_type& list,
+                                    const std::size_t particle_index )
+    {
+        return list._data.counts( particle_index );
+    }
+
+    //! Get the source index of a neighbor for a given target index and the
+    //! index of the neighbor relative to the target.
+    KOKKOS_INLINE_FUNCTION
+    static std::size_t getNeighbor( const list_type& list,
+                                    const std::size_t particle_index,
+                                    const std::size_t neighbor_index )
+    {
+        return list._data.getNeighbor( particle_index, neighbor_index );
+    }
+};
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_BIPARTITENEIGHBORLIST_HPP
@@ -90,7 +90,7 @@ struct CountSendsAndCreateSteeringAlgorithm
 //---------------------------------------------------------------------------//
 // Count sends and generate the steering vector. Atomic version.
 template <class ExecutionSpace, class ExportRankView>
-auto countSendsAndCreateSteering( ExecutionSpace,
+auto countSendsAndCreateSteering( ExecutionSpace exec_space,
                                   const ExportRankView element_export_ranks,
                                   const int comm_size,
                                   CountSendsAndCreateSteeringAtomic )
@@ -116,6 +116,7 @@ auto countSendsAndCreateSteering( ExecutionSpace,
     {
         constexpr int team_size = 256;
         Kokkos::TeamPolicy<ExecutionSpace> team_policy(
+            exec_space,
             ( element_export_ranks.size() + team_size - 1 ) / team_size,
             team_size );
         team_policy = team_policy.set_scratch_size(
@@ -206,7 +207,7 @@ auto countSendsAndCreateSteering( ExecutionSpace,
 
         Kokkos::parallel_for(
             "Cabana::CommunicationPlan::countSendsAndCreateSteering",
-            Kokkos::RangePolicy<ExecutionSpace>( 0,
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
                                                  element_export_ranks.size() ),
             KOKKOS_LAMBDA( const size_type i ) {
                 if ( element_export_ranks( i ) >= 0 )
@@ -214,7 +215,7 @@ auto countSendsAndCreateSteering( ExecutionSpace,
                         &neighbor_counts( element_export_ranks( i ) ), 1 );
             } );
     }
-    Kokkos::fence();
+    exec_space.fence();
 
     // Return the counts and ids.
     return std::make_pair( neighbor_counts, neighbor_ids );
@@ -223,7 +224,7 @@ auto countSendsAndCreateSteering( ExecutionSpace,
 //---------------------------------------------------------------------------//
 // Count sends and generate the steering vector. Duplicated version.
 template <class ExecutionSpace, class ExportRankView>
-auto countSendsAndCreateSteering( ExecutionSpace,
+auto countSendsAndCreateSteering( ExecutionSpace exec_space,
                                   const ExportRankView element_export_ranks,
                                   const int comm_size,
                                   CountSendsAndCreateSteeringDuplicated )
@@ -237,7 +238,7 @@ auto countSendsAndCreateSteering( ExecutionSpace,
     // Create a unique thread token.
     Kokkos::Experimental::UniqueToken<
         ExecutionSpace, Kokkos::Experimental::UniqueTokenScope::Global>
-        unique_token;
+        unique_token( exec_space );
 
     // Create views.
     Kokkos::View<int*, memory_space> neighbor_counts(
@@ -254,7 +255,8 @@ auto countSendsAndCreateSteering( ExecutionSpace,
     // Compute initial duplicated sends and steering.
     Kokkos::parallel_for(
         "Cabana::CommunicationPlan::intialCount",
-        Kokkos::RangePolicy<ExecutionSpace>( 0, element_export_ranks.size() ),
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                             element_export_ranks.size() ),
         KOKKOS_LAMBDA( const size_type i ) {
             if ( element_export_ranks( i ) >= 0 )
             {
@@ -276,7 +278,6 @@ auto countSendsAndCreateSteering( ExecutionSpace,
                 unique_token.release( thread_id );
             }
         } );
-    Kokkos::fence();
 
     // Team policy
     using team_policy =
@@ -287,7 +288,7 @@ auto countSendsAndCreateSteering( ExecutionSpace,
     // the thread duplicates.
     Kokkos::parallel_for(
         "Cabana::CommunicationPlan::finalCount",
-        team_policy( neighbor_counts.extent( 0 ), Kokkos::AUTO ),
+        team_policy( exec_space, neighbor_counts.extent( 0 ), Kokkos::AUTO ),
         KOKKOS_LAMBDA( const typename team_policy::member_type& team ) {
             // Get the element id.
             auto i = team.league_rank();
@@ -302,13 +303,12 @@ auto countSendsAndCreateSteering( ExecutionSpace,
                 thread_counts );
             neighbor_counts( i ) = thread_counts;
         } );
-    Kokkos::fence();
 
     // Compute the location of each export element in the send buffer of
     // its destination rank.
     Kokkos::parallel_for(
         "Cabana::CommunicationPlan::createSteering",
-        team_policy( element_export_ranks.size(), Kokkos::AUTO ),
+        team_policy( exec_space, element_export_ranks.size(), Kokkos::AUTO ),
         KOKKOS_LAMBDA( const typename team_policy::member_type& team ) {
             // Get the element id.
             auto i = team.league_rank();
@@ -351,7 +351,7 @@ auto countSendsAndCreateSteering( ExecutionSpace,
                     thread_offset + neighbor_ids_dup( dup_thread, i ) - 1;
             }
         } );
-    Kokkos::fence();
+    exec_space.fence();
 
     // Return the counts and ids.
     return std::make_pair( neighbor_counts, neighbor_ids );
@@ -980,7 +980,7 @@ class CommunicationPlan
     // Create the export steering vector.
     template <class ExecutionSpace, class PackViewType, class RankViewType,
               class IdViewType>
-    void createSteering( ExecutionSpace, const bool use_iota,
+    void createSteering( ExecutionSpace exec_space, const bool use_iota,
                          const PackViewType& neighbor_ids,
                          const RankViewType& element_export_ranks,
                          const IdViewType& element_export_ids )
@@ -1019,14 +1019,15 @@ class CommunicationPlan
         auto steer_vec = _export_steering;
         Kokkos::parallel_for(
             "Cabana::createSteering",
-            Kokkos::RangePolicy<ExecutionSpace>( 0, _num_export_element ),
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                                 _num_export_element ),
             KOKKOS_LAMBDA( const int i ) {
                 if ( element_export_ranks( i ) >= 0 )
                     steer_vec( rank_offsets( element_export_ranks( i ) ) +
                                neighbor_ids( i ) ) =
                         ( use_iota ) ? i : element_export_ids( i );
             } );
-        Kokkos::fence();
+        exec_space.fence();
     }
 
     template <class PackViewType, class RankViewType, class IdViewType>
@@ -19,6 +19,7 @@
 #include <CabanaCore_config.hpp>
 
 #include <Cabana_AoSoA.hpp>
+#include <Cabana_BipartiteNeighborList.hpp>
 #include <Cabana_DeepCopy.hpp>
 #include <Cabana_Fields.hpp>
 #include <Cabana_LinkedCellList.hpp>
@@ -26,11 +27,14 @@
 #include <Cabana_NeighborList.hpp>
 #include <Cabana_Parallel.hpp>
 #include <Cabana_ParameterPack.hpp>
+#include <Cabana_ParticleIdIndex.hpp>
 #include <Cabana_ParticleInit.hpp>
 #include <Cabana_ParticleList.hpp>
+#include <Cabana_PartitionedPipeline.hpp>
 #include <Cabana_Slice.hpp>
 #include <Cabana_SoA.hpp>
 #include <Cabana_Sort.hpp>
+#include <Cabana_SparseCellList.hpp>
 #include <Cabana_Tuple.hpp>
 #include <Cabana_Types.hpp>
 #include <Cabana_Utils.hpp>
@@ -38,8 +42,12 @@
 #include <Cabana_Version.hpp>
 
 #ifdef Cabana_ENABLE_MPI
+#include <Cabana_DistributedSort.hpp>
 #include <Cabana_Distributor.hpp>
 #include <Cabana_Halo.hpp>
+#include <Cabana_ParticleIdDirectory.hpp>
+#include <Cabana_ParticleTopology.hpp>
+#include <Cabana_TreeCode.hpp>
 
 #ifdef Cabana_ENABLE_SILO
 #include <Cabana_SiloParticleOutput.hpp>
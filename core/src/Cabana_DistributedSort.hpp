@@ -0,0 +1,217 @@
+/****************************************************************************
+ * Copyright (c) 2018-2023 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_DistributedSort.hpp
+  \brief Global sort of distributed particles by key
+*/
+#ifndef CABANA_DISTRIBUTEDSORT_HPP
+#define CABANA_DISTRIBUTEDSORT_HPP
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_Distributor.hpp>
+#include <Cabana_Slice.hpp>
+#include <Cabana_Sort.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+namespace Cabana
+{
+namespace Impl
+{
+//! \cond Impl
+// Sort the AoSoA on this rank by the keys of the given member.
+template <std::size_t KeyMember, class ExecutionSpace, class AoSoA_t>
+void localSortByKey( ExecutionSpace exec_space, AoSoA_t& aosoa )
+{
+    // The bin sort needs at least two distinct keys.
+    if ( aosoa.size() < 2 )
+        return;
+    // Copy the keys into a View for the bin sort.
+    using memory_space = typename AoSoA_t::memory_space;
+    using key_type = typename AoSoA_t::template member_value_type<KeyMember>;
+    auto key_slice = slice<KeyMember>( aosoa );
+    Kokkos::View<key_type*, memory_space> keys(
+        Kokkos::ViewAllocateWithoutInitializing( "keys" ), aosoa.size() );
+    copySliceToView( exec_space, keys, key_slice, 0, aosoa.size() );
+
+    Kokkos::MinMaxScalar<key_type> bounds;
+    Kokkos::parallel_reduce(
+        "Cabana::sampleSort::key_bounds",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, aosoa.size() ),
+        KOKKOS_LAMBDA( const int i, Kokkos::MinMaxScalar<key_type>& result ) {
+            if ( keys( i ) < result.min_val )
+                result.min_val = keys( i );
+            if ( keys( i ) > result.max_val )
+                result.max_val = keys( i );
+        },
+        Kokkos::MinMax<key_type>( bounds ) );
+    if ( !( bounds.min_val < bounds.max_val ) )
+        return;
+
+    auto binning_data = sortByKey<decltype( keys ), ExecutionSpace>( keys );
+    permute( exec_space, binning_data, aosoa );
+}
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Sort the elements of an AoSoA by key across all ranks with a sample
+  sort. Collective.
+
+  Each rank sorts its elements locally and contributes evenly spaced samples
+  of its keys. The gathered samples give splitters dividing the key range
+  into one range per rank, and the elements are migrated to the rank of
+  their key range with a Distributor and sorted locally again. Afterwards
+  every key on rank r is no larger than every key on rank r + 1, and the
+  concatenation of the elements in rank order is sorted.
+
+  \tparam KeyMember The AoSoA member containing the keys. The keys must be
+  a scalar type which is comparable and copyable by value.
+
+  \param exec_space The execution space to use.
+  \param comm The communicator over which the AoSoA is distributed.
+  \param aosoa The AoSoA to sort. It is resized to the number of elements
+  this rank owns after the sort.
+  \param samples_per_rank The number of keys sampled on each rank to choose
+  the splitters. More samples give a better balance.
+*/
+template <std::size_t KeyMember, class ExecutionSpace, class AoSoA_t>
+void sampleSort(
+    ExecutionSpace exec_space, MPI_Comm comm, AoSoA_t& aosoa,
+    const int samples_per_rank = 64,
+    typename std::enable_if<( is_aosoa<AoSoA_t>::value ), int>::type* = 0 )
+{
+    Kokkos::Profiling::pushRegion( "Cabana::sampleSort" );
+
+    using memory_space = typename AoSoA_t::memory_space;
+    static_assert( is_accessible_from<memory_space, ExecutionSpace>{}, "" );
+    using key_type = typename AoSoA_t::template member_value_type<KeyMember>;
+    static_assert( std::is_arithmetic<key_type>::value,
+                   "Sample sort keys must be scalar" );
+
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+
+    // Sort locally and take evenly spaced samples of the keys.
+    Impl::localSortByKey<KeyMember>( exec_space, aosoa );
+    std::size_t num_local = aosoa.size();
+    int num_sample = static_cast<int>(
+        std::min<std::size_t>( samples_per_rank, num_local ) );
+    Kokkos::View<key_type*, memory_space> samples(
+        Kokkos::ViewAllocateWithoutInitializing( "samples" ), num_sample );
+    auto keys = slice<KeyMember>( aosoa );
+    Kokkos::parallel_for(
+        "Cabana::sampleSort::sample",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_sample ),
+        KOKKOS_LAMBDA( const int s ) {
+            samples( s ) =
+                keys( ( 2 * s + 1 ) * num_local / ( 2 * num_sample ) );
+        } );
+    auto samples_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), samples );
+
+    // Gather the samples from every rank.
+    std::vector<int> sample_bytes( comm_size );
+    int local_bytes = num_sample * sizeof( key_type );
+    MPI_Allgather( &local_bytes, 1, MPI_INT, sample_bytes.data(), 1, MPI_INT,
+                   comm );
+    std::vector<int> sample_displs( comm_size + 1, 0 );
+    for ( int r = 0; r < comm_size; ++r )
+        sample_displs[r + 1] = sample_displs[r] + sample_bytes[r];
+    std::vector<key_type> all_samples( sample_displs[comm_size] /
+                                       sizeof( key_type ) );
+    MPI_Allgatherv( samples_host.data(), local_bytes, MPI_BYTE,
+                    all_samples.data(), sample_bytes.data(),
+                    sample_displs.data(), MPI_BYTE, comm );
+
+    // There is nothing to route if no rank has elements.
+    if ( all_samples.empty() )
+    {
+        Kokkos::Profiling::popRegion();
+        return;
+    }
+
+    // Choose the splitters. Rank r receives the keys in
+    // [splitter r - 1, splitter r).
+    std::sort( all_samples.begin(), all_samples.end() );
+    Kokkos::View<key_type*, Kokkos::HostSpace> splitters_host(
+        "splitters", comm_size - 1 );
+    for ( int r = 1; r < comm_size; ++r )
+        splitters_host( r - 1 ) =
+            all_samples[r * all_samples.size() / comm_size];
+    auto splitters =
+        Kokkos::create_mirror_view_and_copy( memory_space(), splitters_host );
+
+    // Route each element to the rank of its key range.
+    Kokkos::View<int*, memory_space> export_ranks(
+        Kokkos::ViewAllocateWithoutInitializing( "export_ranks" ),
+        num_local );
+    int num_splitter = comm_size - 1;
+    Kokkos::parallel_for(
+        "Cabana::sampleSort::export_ranks",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_local ),
+        KOKKOS_LAMBDA( const int p ) {
+            // Find the number of splitters no larger than the key.
+            int lo = 0;
+            int hi = num_splitter;
+            while ( lo < hi )
+            {
+                int mid = ( lo + hi ) / 2;
+                if ( splitters( mid ) <= keys( p ) )
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            export_ranks( p ) = lo;
+        } );
+    exec_space.fence();
+    Distributor<memory_space> distributor( comm, export_ranks );
+    migrate( exec_space, distributor, aosoa );
+
+    // Sort the received elements.
+    Impl::localSortByKey<KeyMember>( exec_space, aosoa );
+
+    Kokkos::Profiling::popRegion();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Sort the elements of an AoSoA by key across all ranks with a sample
+  sort using the default execution space. Collective.
+
+  \tparam KeyMember The AoSoA member containing the keys.
+
+  \param comm The communicator over which the AoSoA is distributed.
+  \param aosoa The AoSoA to sort.
+  \param samples_per_rank The number of keys sampled on each rank.
+*/
+template <std::size_t KeyMember, class AoSoA_t>
+void sampleSort(
+    MPI_Comm comm, AoSoA_t& aosoa, const int samples_per_rank = 64,
+    typename std::enable_if<( is_aosoa<AoSoA_t>::value ), int>::type* = 0 )
+{
+    sampleSort<KeyMember>( typename AoSoA_t::execution_space{}, comm, aosoa,
+                           samples_per_rank );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_DISTRIBUTEDSORT_HPP
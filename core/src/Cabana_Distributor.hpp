@@ -170,8 +170,8 @@ namespace Impl
 // the forward communication plan.
 template <class ExecutionSpace, class Distributor_t, class AoSoA_t>
 void distributeData(
-    ExecutionSpace, const Distributor_t& distributor, const AoSoA_t& src,
-    AoSoA_t& dst,
+    ExecutionSpace exec_space, const Distributor_t& distributor,
+    const AoSoA_t& src, AoSoA_t& dst,
     typename std::enable_if<( is_distributor<Distributor_t>::value &&
                               is_aosoa<AoSoA_t>::value ),
                             int>::type* = 0 )
@@ -229,10 +229,13 @@ void distributeData(
             send_buffer( i - num_stay ) = tpl;
     };
     Kokkos::RangePolicy<ExecutionSpace> build_send_buffer_policy(
-        0, distributor.totalNumExport() );
+        exec_space, 0, distributor.totalNumExport() );
     Kokkos::parallel_for( "Cabana::Impl::distributeData::build_send_buffer",
                           build_send_buffer_policy, build_send_buffer_func );
-    Kokkos::fence();
+
+    // Only this execution space instance needs to complete before MPI reads
+    // the send buffer.
+    exec_space.fence();
 
     // The distributor has its own communication space so choose any tag.
     const int mpi_tag = 1234;
@@ -296,11 +299,13 @@ void distributeData(
         dst.setTuple( i, recv_buffer( i ) );
     };
     Kokkos::RangePolicy<ExecutionSpace> extract_recv_buffer_policy(
-        0, distributor.totalNumImport() );
+        exec_space, 0, distributor.totalNumImport() );
     Kokkos::parallel_for( "Cabana::Impl::distributeData::extract_recv_buffer",
                           extract_recv_buffer_policy,
                           extract_recv_buffer_func );
-    Kokkos::fence();
+
+    // Complete the unpack on this instance before the buffers are released.
+    exec_space.fence();
 
     // Barrier before completing to ensure synchronization.
     MPI_Barrier( distributor.comm() );
@@ -482,7 +487,7 @@ void migrate( const Distributor_t& distributor, AoSoA_t& aosoa,
   rank. Call totalNumImport() on the distributor to get this size value.
 */
 template <class ExecutionSpace, class Distributor_t, class Slice_t>
-void migrate( ExecutionSpace, const Distributor_t& distributor,
+void migrate( ExecutionSpace exec_space, const Distributor_t& distributor,
               const Slice_t& src, Slice_t& dst,
               typename std::enable_if<( is_distributor<Distributor_t>::value &&
                                         is_slice<Slice_t>::value ),
@@ -558,10 +563,13 @@ void migrate( ExecutionSpace, const Distributor_t& distributor,
                     src_data[src_offset + n * Slice_t::vector_length];
     };
     Kokkos::RangePolicy<ExecutionSpace> build_send_buffer_policy(
-        0, distributor.totalNumExport() );
+        exec_space, 0, distributor.totalNumExport() );
     Kokkos::parallel_for( "Cabana::migrate::build_send_buffer",
                           build_send_buffer_policy, build_send_buffer_func );
-    Kokkos::fence();
+
+    // Only this execution space instance needs to complete before MPI reads
+    // the send buffer.
+    exec_space.fence();
 
     // The distributor has its own communication space so choose any tag.
     const int mpi_tag = 1234;
@@ -632,11 +640,13 @@ void migrate( ExecutionSpace, const Distributor_t& distributor,
                 recv_buffer( i, n );
     };
     Kokkos::RangePolicy<ExecutionSpace> extract_recv_buffer_policy(
-        0, distributor.totalNumImport() );
+        exec_space, 0, distributor.totalNumImport() );
     Kokkos::parallel_for( "Cabana::migrate::extract_recv_buffer",
                           extract_recv_buffer_policy,
                           extract_recv_buffer_func );
-    Kokkos::fence();
+
+    // Complete the unpack on this instance before the buffers are released.
+    exec_space.fence();
 
     // Barrier before completing to ensure synchronization.
     MPI_Barrier( distributor.comm() );
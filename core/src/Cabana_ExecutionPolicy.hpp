@@ -108,6 +108,30 @@ class SimdPolicy : public Kokkos::TeamPolicy<Properties...,
     {
     }
 
+    /*!
+      \brief Range constructor on an execution space instance.
+      \param space The execution space instance to use.
+      \param begin The beginning of the 1D range. This will be decomposed
+      into 2D indices.
+      \param end The ending of the 1D range. This will be decomposed
+      into 2D indices.
+    */
+    SimdPolicy( const typename base_type::execution_space& space,
+                const index_type begin, const index_type end )
+        : base_type(
+              space,
+              Impl::StructRange<VectorLength, index_type>::size( begin, end ),
+              1, VectorLength )
+        , _struct_begin(
+              Impl::StructRange<VectorLength, index_type>::structBegin(
+                  begin ) )
+        , _struct_end(
+              Impl::StructRange<VectorLength, index_type>::structEnd( end ) )
+        , _array_begin( Impl::Index<VectorLength>::a( begin ) )
+        , _array_end( Impl::Index<VectorLength>::a( end ) )
+    {
+    }
+
     //! Get the starting struct index.
     KOKKOS_INLINE_FUNCTION index_type structBegin() const
     {
@@ -297,6 +297,35 @@ auto makeNeighborList( ExecutionSpace space, Tag, Slice const& coordinate_slice,
         std::move( indices ), std::move( offset ), first, bvh.size() };
 }
 
+/*!
+  \brief Neighbor list implementation using ArborX for particles within the
+  interaction distance with a 1D compressed layout for particles and neighbors,
+  with the neighbor buffer size taken from the statistics of a previous list.
+
+  \param space Kokkos execution space.
+  \param tag Tag indicating whether to build a full or half neighbor list.
+  \param coordinate_slice The slice containing the particle positions.
+  \param first The beginning particle index to compute neighbors for.
+  \param last The end particle index to compute neighbors for.
+  \param radius The radius of the neighborhood.
+  \param stats Neighbor statistics used to pick the buffer size.
+  \param headroom Relative extra capacity added to the maximum number of
+  neighbors in the statistics.
+*/
+template <typename ExecutionSpace, typename Slice, typename Tag>
+auto makeNeighborList( ExecutionSpace space, Tag tag,
+                       Slice const& coordinate_slice,
+                       typename Slice::size_type first,
+                       typename Slice::size_type last,
+                       typename Slice::value_type radius,
+                       const NeighborStatistics& stats,
+                       const double headroom = 0.0 )
+{
+    return makeNeighborList(
+        space, tag, coordinate_slice, first, last, radius,
+        static_cast<int>( stats.suggestedMaxNeighbor( headroom ) ) );
+}
+
 /*!
   \brief Neighbor list implementation using ArborX for particles within the
   interaction distance with a 1D compressed layout for particles and neighbors.
@@ -357,6 +386,98 @@ template <typename DeviceType, typename Slice, typename Tag>
                              radius, buffer_size );
 }
 
+/*!
+  \brief Derive a neighbor list with a smaller cutoff from an existing ArborX
+  compressed neighbor list by compaction, without a new tree search.
+
+  \param space Kokkos execution space.
+  \param graph The outer neighbor list.
+  \param coordinate_slice The particle positions used to build the outer
+  list.
+  \param radius The radius of the inner neighborhood. Should be less than or
+  equal to the radius of the outer list.
+  \return The inner list.
+*/
+template <typename ExecutionSpace, typename MemorySpace, typename Tag,
+          typename Slice>
+CrsGraph<MemorySpace, Tag>
+filterNeighborList( ExecutionSpace space,
+                    CrsGraph<MemorySpace, Tag> const& graph,
+                    Slice const& coordinate_slice,
+                    typename Slice::value_type radius )
+{
+    int const num_row = graph.row_ptr.size() - 1;
+    int const shift = graph.shift;
+    auto const rsqr = radius * radius;
+    auto const row_ptr = graph.row_ptr;
+    auto const col_ind = graph.col_ind;
+
+    // Count the neighbors within the radius. The extra entry holds the total
+    // after the scan.
+    Kokkos::View<int*, MemorySpace> offset( "offset", num_row + 1 );
+    Kokkos::parallel_for(
+        "Cabana::Experimental::filterNeighborList::count",
+        Kokkos::RangePolicy<ExecutionSpace>( space, 0, num_row ),
+        KOKKOS_LAMBDA( int const r ) {
+            int const p = r + shift;
+            for ( int n = row_ptr( r ); n < row_ptr( r + 1 ); ++n )
+            {
+                int const j = col_ind( n );
+                typename Slice::value_type dist_sqr = 0;
+                for ( int d = 0; d < 3; ++d )
+                {
+                    auto const dx =
+                        coordinate_slice( p, d ) - coordinate_slice( j, d );
+                    dist_sqr += dx * dx;
+                }
+                if ( dist_sqr <= rsqr )
+                    ++offset( r );
+            }
+        } );
+    Kokkos::parallel_scan(
+        "Cabana::Experimental::filterNeighborList::offset_scan",
+        Kokkos::RangePolicy<ExecutionSpace>( space, 0, num_row + 1 ),
+        KOKKOS_LAMBDA( int const r, int& update, bool const final_pass ) {
+            auto const count = offset( r );
+            if ( final_pass )
+                offset( r ) = update;
+            update += count;
+        } );
+
+    // Fill, keeping the order of the outer list.
+    int total_num_neighbor = 0;
+    Kokkos::deep_copy( space, total_num_neighbor,
+                       Kokkos::subview( offset, num_row ) );
+    space.fence();
+    Kokkos::View<int*, MemorySpace> indices(
+        Kokkos::view_alloc( "indices", Kokkos::WithoutInitializing ),
+        total_num_neighbor );
+    Kokkos::parallel_for(
+        "Cabana::Experimental::filterNeighborList::fill",
+        Kokkos::RangePolicy<ExecutionSpace>( space, 0, num_row ),
+        KOKKOS_LAMBDA( int const r ) {
+            int const p = r + shift;
+            int c = offset( r );
+            for ( int n = row_ptr( r ); n < row_ptr( r + 1 ); ++n )
+            {
+                int const j = col_ind( n );
+                typename Slice::value_type dist_sqr = 0;
+                for ( int d = 0; d < 3; ++d )
+                {
+                    auto const dx =
+                        coordinate_slice( p, d ) - coordinate_slice( j, d );
+                    dist_sqr += dx * dx;
+                }
+                if ( dist_sqr <= rsqr )
+                    indices( c++ ) = j;
+            }
+        } );
+
+    return CrsGraph<MemorySpace, Tag>{ std::move( indices ),
+                                       std::move( offset ), graph.shift,
+                                       graph.total };
+}
+
 //---------------------------------------------------------------------------//
 //! 2d ArborX neighbor list storage layout.
 template <typename MemorySpace, typename Tag>
@@ -459,6 +580,35 @@ auto make2DNeighborList( ExecutionSpace space, Tag,
     return Dense<memory_space, Tag>{ counts, neighbors, first, bvh.size() };
 }
 
+/*!
+  \brief Neighbor list implementation using ArborX for particles within the
+  interaction distance with a 2D layout for particles and neighbors, with the
+  neighbor buffer size taken from the statistics of a previous list.
+
+  \param space Kokkos execution space.
+  \param tag Tag indicating whether to build a full or half neighbor list.
+  \param coordinate_slice The slice containing the particle positions.
+  \param first The beginning particle index to compute neighbors for.
+  \param last The end particle index to compute neighbors for.
+  \param radius The radius of the neighborhood.
+  \param stats Neighbor statistics used to pick the buffer size.
+  \param headroom Relative extra capacity added to the maximum number of
+  neighbors in the statistics.
+*/
+template <typename ExecutionSpace, typename Slice, typename Tag>
+auto make2DNeighborList( ExecutionSpace space, Tag tag,
+                         Slice const& coordinate_slice,
+                         typename Slice::size_type first,
+                         typename Slice::size_type last,
+                         typename Slice::value_type radius,
+                         const NeighborStatistics& stats,
+                         const double headroom = 0.0 )
+{
+    return make2DNeighborList(
+        space, tag, coordinate_slice, first, last, radius,
+        static_cast<int>( stats.suggestedMaxNeighbor( headroom ) ) );
+}
+
 /*!
   \brief Neighbor list implementation using ArborX for particles within the
   interaction distance with a 2D layout for particles and neighbors.
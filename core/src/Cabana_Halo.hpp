@@ -282,9 +282,14 @@ class Gather<HaloType, AoSoAType,
 
     /*!
       \brief Perform the gather operation.
+
+      Kernels are enqueued on the given execution space instance. Only that
+      instance is fenced: once before the MPI sends and once after unpacking.
+
+      \param exec_space The execution space instance to use.
     */
     template <class ExecutionSpace>
-    void apply( ExecutionSpace )
+    void apply( ExecutionSpace exec_space )
     {
         Kokkos::Profiling::pushRegion( "Cabana::gather" );
 
@@ -300,10 +305,14 @@ class Gather<HaloType, AoSoAType,
         {
             send_buffer( i ) = aosoa.getTuple( steering( i ) );
         };
-        Kokkos::RangePolicy<ExecutionSpace> send_policy( 0, _send_size );
+        Kokkos::RangePolicy<ExecutionSpace> send_policy( exec_space, 0,
+                                                         _send_size );
         Kokkos::parallel_for( "Cabana::gather::gather_send_buffer", send_policy,
                               gather_send_buffer_func );
-        Kokkos::fence();
+
+        // Only this execution space instance needs to complete before MPI
+        // reads the send buffer.
+        exec_space.fence();
 
         // The halo has it's own communication space so choose any mpi tag.
         const int mpi_tag = 2345;
@@ -355,10 +364,13 @@ class Gather<HaloType, AoSoAType,
             std::size_t ghost_idx = i + num_local;
             aosoa.setTuple( ghost_idx, recv_buffer( i ) );
         };
-        Kokkos::RangePolicy<ExecutionSpace> recv_policy( 0, _recv_size );
+        Kokkos::RangePolicy<ExecutionSpace> recv_policy( exec_space, 0,
+                                                         _recv_size );
         Kokkos::parallel_for( "Cabana::gather::extract_recv_buffer",
                               recv_policy, extract_recv_buffer_func );
-        Kokkos::fence();
+
+        // Complete the unpack on this instance before returning.
+        exec_space.fence();
 
         // Barrier before completing to ensure synchronization.
         MPI_Barrier( _halo.comm() );
@@ -463,9 +475,14 @@ class Gather<HaloType, SliceType,
 
     /*!
       \brief Perform the gather operation.
+
+      Kernels are enqueued on the given execution space instance. Only that
+      instance is fenced: once before the MPI sends and once after unpacking.
+
+      \param exec_space The execution space instance to use.
     */
     template <class ExecutionSpace>
-    void apply( ExecutionSpace )
+    void apply( ExecutionSpace exec_space )
     {
         Kokkos::Profiling::pushRegion( "Cabana::gather" );
 
@@ -493,10 +510,14 @@ class Gather<HaloType, SliceType,
                 send_buffer( i, n ) =
                     slice_data[slice_offset + n * SliceType::vector_length];
         };
-        Kokkos::RangePolicy<ExecutionSpace> send_policy( 0, _send_size );
+        Kokkos::RangePolicy<ExecutionSpace> send_policy( exec_space, 0,
+                                                         _send_size );
         Kokkos::parallel_for( "Cabana::gather::gather_send_buffer", send_policy,
                               gather_send_buffer_func );
-        Kokkos::fence();
+
+        // Only this execution space instance needs to complete before MPI
+        // reads the send buffer.
+        exec_space.fence();
 
         // The halo has it's own communication space so choose any mpi tag.
         const int mpi_tag = 2345;
@@ -555,10 +576,13 @@ class Gather<HaloType, SliceType,
                 slice_data[slice_offset + SliceType::vector_length * n] =
                     recv_buffer( i, n );
         };
-        Kokkos::RangePolicy<ExecutionSpace> recv_policy( 0, _recv_size );
+        Kokkos::RangePolicy<ExecutionSpace> recv_policy( exec_space, 0,
+                                                         _recv_size );
         Kokkos::parallel_for( "Cabana::gather::extract_recv_buffer",
                               recv_policy, extract_recv_buffer_func );
-        Kokkos::fence();
+
+        // Complete the unpack on this instance before returning.
+        exec_space.fence();
 
         // Barrier before completing to ensure synchronization.
         MPI_Barrier( _halo.comm() );
@@ -626,6 +650,36 @@ auto createGather( const HaloType& halo, const ParticleDataType& data,
     return Gather<HaloType, ParticleDataType>( halo, data, overallocation );
 }
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Synchronously gather data from the local decomposition to the
+  ghosts using the halo forward communication plan. Slice version. This is a
+  uniquely-owned to multiply-owned communication.
+
+  \note This routine allocates send and receive buffers internally. This is
+  often not performant due to frequent buffer reallocations - consider creating
+  and reusing Gather instead.
+
+  \param exec_space The execution space instance to use.
+
+  \param halo The halo to use for the gather.
+
+  \param data The data on which to perform the gather. The slice should
+  have a size equivalent to halo.numGhost() + halo.numLocal(). The locally
+  owned elements are expected to appear first (i.e. in the first
+  halo.numLocal() elements) and the ghosted elements are expected to appear
+  second (i.e. in the next halo.numGhost() elements()).
+*/
+template <class ExecutionSpace, class HaloType, class ParticleDataType>
+void gather( ExecutionSpace exec_space, const HaloType& halo,
+             ParticleDataType& data,
+             typename std::enable_if<( is_halo<HaloType>::value ), int>::type* =
+                 0 )
+{
+    auto gather = createGather( halo, data );
+    gather.apply( exec_space );
+}
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Synchronously gather data from the local decomposition to the
@@ -713,9 +767,14 @@ class Scatter
 
     /*!
       \brief Perform the scatter operation.
+
+      Kernels are enqueued on the given execution space instance. Only that
+      instance is fenced: once before the MPI sends and once after unpacking.
+
+      \param exec_space The execution space instance to use.
     */
     template <class ExecutionSpace>
-    void apply( ExecutionSpace )
+    void apply( ExecutionSpace exec_space )
     {
         Kokkos::Profiling::pushRegion( "Cabana::scatter" );
 
@@ -745,10 +804,14 @@ class Scatter
                 send_buffer( i, n ) =
                     slice_data( slice_offset + SliceType::vector_length * n );
         };
-        Kokkos::RangePolicy<ExecutionSpace> send_policy( 0, _send_size );
+        Kokkos::RangePolicy<ExecutionSpace> send_policy( exec_space, 0,
+                                                         _send_size );
         Kokkos::parallel_for( "Cabana::scatter::extract_send_buffer",
                               send_policy, extract_send_buffer_func );
-        Kokkos::fence();
+
+        // Only this execution space instance needs to complete before MPI
+        // reads the send buffer.
+        exec_space.fence();
 
         // The halo has it's own communication space so choose any mpi tag.
         const int mpi_tag = 2345;
@@ -809,10 +872,13 @@ class Scatter
                     &slice_data( slice_offset + SliceType::vector_length * n ),
                     recv_buffer( i, n ) );
         };
-        Kokkos::RangePolicy<ExecutionSpace> recv_policy( 0, _recv_size );
+        Kokkos::RangePolicy<ExecutionSpace> recv_policy( exec_space, 0,
+                                                         _recv_size );
         Kokkos::parallel_for( "Cabana::scatter::scatter_recv_buffer",
                               recv_policy, scatter_recv_buffer_func );
-        Kokkos::fence();
+
+        // Complete the unpack on this instance before returning.
+        exec_space.fence();
 
         // Barrier before completing to ensure synchronization.
         MPI_Barrier( _halo.comm() );
@@ -882,6 +948,37 @@ auto createScatter( const HaloType& halo, const SliceType& slice,
     return Scatter<HaloType, SliceType>( halo, slice, overallocation );
 }
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Synchronously scatter data from the ghosts to the local decomposition
+  of a slice using the halo reverse communication plan. This is a
+  multiply-owned to uniquely owned communication.
+
+  \note This routine allocates send and receive buffers internally. This is
+  often not performant due to frequent buffer reallocations - consider creating
+  and reusing Gather instead.
+
+  \param exec_space The execution space instance to use.
+
+  \param halo The halo to use for the scatter.
+
+  \param slice The Slice on which to perform the scatter. The Slice should have
+  a size equivalent to halo.numGhost() + halo.numLocal(). The locally owned
+  elements are expected to appear first (i.e. in the first halo.numLocal()
+  elements) and the ghosted elements are expected to appear second (i.e. in
+  the next halo.numGhost() elements()).
+*/
+template <class ExecutionSpace, class HaloType, class SliceType>
+void scatter( ExecutionSpace exec_space, const HaloType& halo,
+              SliceType& slice,
+              typename std::enable_if<( is_halo<HaloType>::value &&
+                                        is_slice<SliceType>::value ),
+                                      int>::type* = 0 )
+{
+    auto scatter = createScatter( halo, slice );
+    scatter.apply( exec_space );
+}
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Synchronously scatter data from the ghosts to the local decomposition
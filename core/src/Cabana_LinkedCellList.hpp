@@ -16,6 +16,7 @@
 #ifndef CABANA_LINKEDCELLLIST_HPP
 #define CABANA_LINKEDCELLLIST_HPP
 
+#include <Cabana_Parallel.hpp>
 #include <Cabana_Slice.hpp>
 #include <Cabana_Sort.hpp>
 #include <Cabana_Utils.hpp>
@@ -25,6 +26,8 @@
 #include <Kokkos_ScatterView.hpp>
 
 #include <cassert>
+#include <cmath>
+#include <string>
 
 namespace Cabana
 {
@@ -75,23 +78,68 @@ class LinkedCellList
       \param grid_min Grid minimum value in each direction.
 
       \param grid_max Grid maximum value in each direction.
+
+      \param stable_order If true, particles within each bin are ordered by
+      their original index so the binning is reproducible.
     */
     template <class SliceType>
     LinkedCellList(
         SliceType positions, const typename SliceType::value_type grid_delta[3],
         const typename SliceType::value_type grid_min[3],
         const typename SliceType::value_type grid_max[3],
+        const bool stable_order = false,
         typename std::enable_if<( is_slice<SliceType>::value ), int>::type* =
             0 )
         : _grid( grid_min[0], grid_min[1], grid_min[2], grid_max[0],
                  grid_max[1], grid_max[2], grid_delta[0], grid_delta[1],
                  grid_delta[2] )
+        , _stable_order( stable_order )
     {
         std::size_t np = positions.size();
         allocate( totalBins(), np );
         build( positions, 0, np );
     }
 
+    /*!
+      \brief Slice constructor building on an execution space instance.
+
+      \tparam ExecutionSpace Kokkos execution space.
+      \tparam SliceType Slice type for positions.
+
+      \param exec_space The execution space instance to build on.
+
+      \param positions Slice of positions.
+
+      \param grid_delta Grid sizes in each cardinal direction.
+
+      \param grid_min Grid minimum value in each direction.
+
+      \param grid_max Grid maximum value in each direction.
+
+      \param stable_order If true, particles within each bin are ordered by
+      their original index so the binning is reproducible.
+    */
+    template <class ExecutionSpace, class SliceType>
+    LinkedCellList(
+        ExecutionSpace exec_space, SliceType positions,
+        const typename SliceType::value_type grid_delta[3],
+        const typename SliceType::value_type grid_min[3],
+        const typename SliceType::value_type grid_max[3],
+        const bool stable_order = false,
+        typename std::enable_if<
+            ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+              is_slice<SliceType>::value ),
+            int>::type* = 0 )
+        : _grid( grid_min[0], grid_min[1], grid_min[2], grid_max[0],
+                 grid_max[1], grid_max[2], grid_delta[0], grid_delta[1],
+                 grid_delta[2] )
+        , _stable_order( stable_order )
+    {
+        std::size_t np = positions.size();
+        allocate( totalBins(), np );
+        build( exec_space, positions, 0, np );
+    }
+
     /*!
       \brief Slice range constructor
 
@@ -108,6 +156,9 @@ class LinkedCellList
       \param grid_min Grid minimum value in each direction.
 
       \param grid_max Grid maximum value in each direction.
+
+      \param stable_order If true, particles within each bin are ordered by
+      their original index so the binning is reproducible.
     */
     template <class SliceType>
     LinkedCellList(
@@ -115,11 +166,13 @@ class LinkedCellList
         const typename SliceType::value_type grid_delta[3],
         const typename SliceType::value_type grid_min[3],
         const typename SliceType::value_type grid_max[3],
+        const bool stable_order = false,
         typename std::enable_if<( is_slice<SliceType>::value ), int>::type* =
             0 )
         : _grid( grid_min[0], grid_min[1], grid_min[2], grid_max[0],
                  grid_max[1], grid_max[2], grid_delta[0], grid_delta[1],
                  grid_delta[2] )
+        , _stable_order( stable_order )
     {
         allocate( totalBins(), end - begin );
         build( positions, begin, end );
@@ -140,6 +193,30 @@ class LinkedCellList
     KOKKOS_INLINE_FUNCTION
     int numBin( const int dim ) const { return _grid.numBin( dim ); }
 
+    /*!
+      \brief Get the bin size in a given dimension.
+      \param dim The dimension to get the bin size for.
+      \return The bin size.
+    */
+    KOKKOS_INLINE_FUNCTION
+    double binDelta( const int dim ) const
+    {
+        return ( 0 == dim ) ? _grid._dx : ( 1 == dim ) ? _grid._dy : _grid._dz;
+    }
+
+    /*!
+      \brief Get the bin in which a point is located.
+      \param xp, yp, zp The point coordinates.
+      \param i, j, k The bin indices. Points outside the grid give indices
+      outside the range of bins.
+    */
+    KOKKOS_INLINE_FUNCTION
+    void locatePoint( const double xp, const double yp, const double zp,
+                      int& i, int& j, int& k ) const
+    {
+        _grid.locatePoint( xp, yp, zp, i, j, k );
+    }
+
     /*!
       \brief Given the ijk index of a bin get its cardinal index.
       \param i The i bin index (x).
@@ -222,6 +299,34 @@ class LinkedCellList
     KOKKOS_INLINE_FUNCTION
     std::size_t rangeEnd() const { return _bin_data.rangeEnd(); }
 
+    /*!
+      \brief Get the cell index of a particle computed in the last build.
+      \param particle_id The id of the particle in the old (unbinned) layout
+      relative to the beginning of the binned range.
+      \return The cardinal cell index of the particle.
+    */
+    KOKKOS_INLINE_FUNCTION
+    int cellIndex( const int particle_id ) const
+    {
+        return _cell_ids( particle_id );
+    }
+
+    /*!
+      \brief Whether particles within each bin are ordered by their original
+      index.
+    */
+    bool stableOrder() const { return _stable_order; }
+
+    /*!
+      \brief Set whether particles within each bin are ordered by their
+      original index in subsequent builds. Without stable ordering the order
+      within a bin depends on thread scheduling.
+    */
+    void setStableOrder( const bool stable_order )
+    {
+        _stable_order = stable_order;
+    }
+
     /*!
       \brief Get the 1d bin data.
       \return The 1d bin data.
@@ -231,16 +336,20 @@ class LinkedCellList
     /*!
       \brief Build the linked cell list with a subset of particles.
 
+      Kernels are enqueued on the given execution space instance and only
+      that instance is fenced.
+
       \tparam ExecutionSpace Kokkos execution space.
       \tparam SliceType Slice type for positions.
 
+      \param exec_space The execution space instance to use.
       \param positions Slice of positions.
       \param begin The beginning index of the slice range to sort.
       \param end The end index of the slice range to sort.
     */
     template <class ExecutionSpace, class SliceType>
-    void build( ExecutionSpace, SliceType positions, const std::size_t begin,
-                const std::size_t end )
+    void build( ExecutionSpace exec_space, SliceType positions,
+                const std::size_t begin, const std::size_t end )
     {
         Kokkos::Profiling::pushRegion( "Cabana::LinkedCellList::build" );
 
@@ -260,6 +369,7 @@ class LinkedCellList
         if ( _permutes.extent( 0 ) != nparticles )
         {
             Kokkos::resize( _permutes, nparticles );
+            Kokkos::resize( _cell_ids, nparticles );
         }
 
         // Get local copies of class data for lambda function capture.
@@ -267,26 +377,30 @@ class LinkedCellList
         auto counts = _counts;
         auto offsets = _offsets;
         auto permutes = _permutes;
+        auto cell_ids = _cell_ids;
 
-        // Count.
-        Kokkos::RangePolicy<ExecutionSpace> particle_range( begin, end );
-        Kokkos::deep_copy( _counts, 0 );
+        // Locate each particle once and count. The cell index is cached so
+        // the permutation pass does not read the positions again.
+        Kokkos::RangePolicy<ExecutionSpace> particle_range( exec_space, begin,
+                                                            end );
+        Kokkos::deep_copy( exec_space, _counts, 0 );
         auto counts_sv = Kokkos::Experimental::create_scatter_view( _counts );
         auto cell_count = KOKKOS_LAMBDA( const std::size_t p )
         {
             int i, j, k;
             grid.locatePoint( positions( p, 0 ), positions( p, 1 ),
                               positions( p, 2 ), i, j, k );
+            auto cell_id = grid.cardinalCellIndex( i, j, k );
+            cell_ids( p - begin ) = cell_id;
             auto counts_data = counts_sv.access();
-            counts_data( grid.cardinalCellIndex( i, j, k ) ) += 1;
+            counts_data( cell_id ) += 1;
         };
         Kokkos::parallel_for( "Cabana::LinkedCellList::build::cell_count",
                               particle_range, cell_count );
-        Kokkos::fence();
-        Kokkos::Experimental::contribute( _counts, counts_sv );
+        Kokkos::Experimental::contribute( exec_space, _counts, counts_sv );
 
         // Compute offsets.
-        Kokkos::RangePolicy<ExecutionSpace> cell_range( 0, ncell );
+        Kokkos::RangePolicy<ExecutionSpace> cell_range( exec_space, 0, ncell );
         auto offset_scan = KOKKOS_LAMBDA( const std::size_t c, int& update,
                                           const bool final_pass )
         {
@@ -296,24 +410,43 @@ class LinkedCellList
         };
         Kokkos::parallel_scan( "Cabana::LinkedCellList::build::offset_scan",
                                cell_range, offset_scan );
-        Kokkos::fence();
 
         // Reset counts.
-        Kokkos::deep_copy( _counts, 0 );
+        Kokkos::deep_copy( exec_space, _counts, 0 );
 
         // Compute the permutation vector.
         auto create_permute = KOKKOS_LAMBDA( const std::size_t p )
         {
-            int i, j, k;
-            grid.locatePoint( positions( p, 0 ), positions( p, 1 ),
-                              positions( p, 2 ), i, j, k );
-            auto cell_id = grid.cardinalCellIndex( i, j, k );
+            auto cell_id = cell_ids( p - begin );
             int c = Kokkos::atomic_fetch_add( &counts( cell_id ), 1 );
             permutes( offsets( cell_id ) + c ) = p;
         };
         Kokkos::parallel_for( "Cabana::LinkedCellList::build::create_permute",
                               particle_range, create_permute );
-        Kokkos::fence();
+
+        // The order within a cell from the atomic fill depends on thread
+        // scheduling. Sorting each cell by particle index gives the same
+        // result as a serial stable counting sort.
+        if ( _stable_order )
+        {
+            auto stable_sort = KOKKOS_LAMBDA( const std::size_t c )
+            {
+                auto cell_begin = offsets( c );
+                auto cell_end = cell_begin + counts( c );
+                for ( auto n = cell_begin + 1; n < cell_end; ++n )
+                {
+                    auto pid = permutes( n );
+                    auto m = n;
+                    for ( ; m > cell_begin && permutes( m - 1 ) > pid; --m )
+                        permutes( m ) = permutes( m - 1 );
+                    permutes( m ) = pid;
+                }
+            };
+            Kokkos::parallel_for(
+                "Cabana::LinkedCellList::build::stable_sort", cell_range,
+                stable_sort );
+        }
+        exec_space.fence();
 
         // Create the binning data.
         _bin_data = BinningData<MemorySpace>( begin, end, _counts, _offsets,
@@ -359,6 +492,8 @@ class LinkedCellList
     CountView _counts;
     OffsetView _offsets;
     OffsetView _permutes;
+    CountView _cell_ids;
+    bool _stable_order = false;
 
     void allocate( const int ncell, const int nparticles )
     {
@@ -371,6 +506,9 @@ class LinkedCellList
         _permutes = OffsetView(
             Kokkos::view_alloc( Kokkos::WithoutInitializing, "permutes" ),
             nparticles );
+        _cell_ids = CountView(
+            Kokkos::view_alloc( Kokkos::WithoutInitializing, "cell_ids" ),
+            nparticles );
     }
 };
 
@@ -396,6 +534,32 @@ struct is_linked_cell_list
 };
 
 //---------------------------------------------------------------------------//
+/*!
+  \brief Given a linked cell list permute an AoSoA.
+
+  \tparam ExecutionSpace Kokkos execution space.
+
+  \tparam LinkedCellListType The linked cell list type.
+
+  \tparam AoSoA_t The AoSoA type.
+
+  \param exec_space The execution space instance to use.
+
+  \param linked_cell_list The linked cell list to permute the AoSoA with.
+
+  \param aosoa The AoSoA to permute.
+ */
+template <class ExecutionSpace, class LinkedCellListType, class AoSoA_t>
+void permute(
+    const ExecutionSpace& exec_space,
+    const LinkedCellListType& linked_cell_list, AoSoA_t& aosoa,
+    typename std::enable_if<( is_linked_cell_list<LinkedCellListType>::value &&
+                              is_aosoa<AoSoA_t>::value ),
+                            int>::type* = 0 )
+{
+    permute( exec_space, linked_cell_list.binningData(), aosoa );
+}
+
 /*!
   \brief Given a linked cell list permute an AoSoA.
 
@@ -418,6 +582,32 @@ void permute(
 }
 
 //---------------------------------------------------------------------------//
+/*!
+  \brief Given a linked cell list permute a slice.
+
+  \tparam ExecutionSpace Kokkos execution space.
+
+  \tparam LinkedCellListType The linked cell list type.
+
+  \tparam SliceType The slice type.
+
+  \param exec_space The execution space instance to use.
+
+  \param linked_cell_list The linked cell list to permute the slice with.
+
+  \param slice The slice to permute.
+ */
+template <class ExecutionSpace, class LinkedCellListType, class SliceType>
+void permute(
+    const ExecutionSpace& exec_space,
+    const LinkedCellListType& linked_cell_list, SliceType& slice,
+    typename std::enable_if<( is_linked_cell_list<LinkedCellListType>::value &&
+                              is_slice<SliceType>::value ),
+                            int>::type* = 0 )
+{
+    permute( exec_space, linked_cell_list.binningData(), slice );
+}
+
 /*!
   \brief Given a linked cell list permute a slice.
 
@@ -439,6 +629,178 @@ void permute(
     permute( linked_cell_list.binningData(), slice );
 }
 
+//---------------------------------------------------------------------------//
+namespace Impl
+{
+//! \cond Impl
+// Add a pair contribution to particle i and its negation to particle j.
+template <class OutputSliceType, class PairType>
+KOKKOS_INLINE_FUNCTION void accumulatePair( const OutputSliceType& output,
+                                            const std::size_t i,
+                                            const std::size_t j,
+                                            const PairType& f )
+{
+    using contribution = PairContribution<PairType>;
+    if constexpr ( OutputSliceType::kokkos_view::rank == 2 )
+    {
+        output( i ) += contribution::get( f, 0 );
+        output( j ) -= contribution::get( f, 0 );
+    }
+    else
+    {
+        for ( int c = 0; c < contribution::size; ++c )
+        {
+            output( i, c ) += contribution::get( f, c );
+            output( j, c ) -= contribution::get( f, c );
+        }
+    }
+}
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Execute a pair functor over every pair of binned particles within a
+  neighborhood radius and accumulate the pair contributions into both
+  particles without atomics.
+
+  Cells are colored such that two cells of the same color are separated by
+  more than the width of the cell stencil in some dimension (27 colors when
+  the bin size is at least the neighborhood radius). Cells of one color are
+  processed concurrently and each cell visits its pairs with the half stencil
+  serially, so concurrent cells never write to the same particle. Colors are
+  processed in a fixed order. If the cell list was built with stable ordering
+  the accumulation order, and therefore the result, is bitwise reproducible.
+
+  \param exec_space The execution space instance to use.
+  \param functor The pair functor. It is called as functor( i, j ) and returns
+  the contribution of the pair to particle i, either a scalar for a scalar
+  output slice or a Kokkos::Array with one value per slice component. The
+  negated contribution is added to particle j (Newton's third law).
+  \param cell_list The linked cell list binning the particles.
+  \param positions The particle positions used to build the cell list.
+  \param neighborhood_radius The radius within which particles interact.
+  \param output The slice to which the contributions are added.
+  \param str Optional name for the functor.
+*/
+template <class ExecutionSpace, class FunctorType, class MemorySpace,
+          class PositionSlice, class OutputSliceType>
+void linked_cell_parallel_for( const ExecutionSpace& exec_space,
+                               const FunctorType& functor,
+                               const LinkedCellList<MemorySpace>& cell_list,
+                               const PositionSlice& positions,
+                               const double neighborhood_radius,
+                               const OutputSliceType& output,
+                               const std::string& str = "" )
+{
+    Kokkos::Profiling::pushRegion( "Cabana::linked_cell_parallel_for" );
+
+    static_assert( is_accessible_from<typename LinkedCellList<
+                                          MemorySpace>::memory_space,
+                                      ExecutionSpace>{},
+                   "" );
+    static_assert( is_slice<OutputSliceType>::value, "" );
+
+    // Number of neighbor cells in each direction and the number of colors.
+    int range[3];
+    int num_color[3];
+    int num_bin[3];
+    for ( int d = 0; d < 3; ++d )
+    {
+        range[d] = std::ceil( neighborhood_radius / cell_list.binDelta( d ) );
+        num_color[d] = 2 * range[d] + 1;
+        num_bin[d] = cell_list.numBin( d );
+    }
+    double rsqr = neighborhood_radius * neighborhood_radius;
+    std::string label =
+        str.empty() ? std::string( "Cabana::linked_cell_parallel_for" ) : str;
+
+    for ( int cx = 0; cx < num_color[0]; ++cx )
+        for ( int cy = 0; cy < num_color[1]; ++cy )
+            for ( int cz = 0; cz < num_color[2]; ++cz )
+            {
+                // Number of cells of this color in each direction.
+                int color[3] = { cx, cy, cz };
+                Kokkos::Array<int, 3> num_cell;
+                for ( int d = 0; d < 3; ++d )
+                    num_cell[d] = ( num_bin[d] > color[d] )
+                                      ? ( num_bin[d] - color[d] - 1 ) /
+                                                num_color[d] +
+                                            1
+                                      : 0;
+                int total = num_cell[0] * num_cell[1] * num_cell[2];
+                if ( 0 == total )
+                    continue;
+
+                Kokkos::parallel_for(
+                    label,
+                    Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                                         total ),
+                    KOKKOS_LAMBDA( const int c ) {
+                        int ijk[3] = {
+                            cx + num_color[0] *
+                                     ( c / ( num_cell[1] * num_cell[2] ) ),
+                            cy + num_color[1] *
+                                     ( ( c / num_cell[2] ) % num_cell[1] ),
+                            cz + num_color[2] * ( c % num_cell[2] ) };
+                        int size = cell_list.binSize( ijk[0], ijk[1], ijk[2] );
+                        auto offset =
+                            cell_list.binOffset( ijk[0], ijk[1], ijk[2] );
+
+                        for ( int a = 0; a < size; ++a )
+                        {
+                            auto pi = cell_list.permutation( offset + a );
+
+                            // Loop over the half stencil: later particles in
+                            // this cell and cells with a lexicographically
+                            // positive offset.
+                            for ( int di = 0; di <= range[0]; ++di )
+                                for ( int dj = ( di > 0 ) ? -range[1] : 0;
+                                      dj <= range[1]; ++dj )
+                                    for ( int dk = ( di > 0 || dj > 0 )
+                                                       ? -range[2]
+                                                       : 0;
+                                          dk <= range[2]; ++dk )
+                                    {
+                                        int ni = ijk[0] + di;
+                                        int nj = ijk[1] + dj;
+                                        int nk = ijk[2] + dk;
+                                        if ( ni >= num_bin[0] || nj < 0 ||
+                                             nj >= num_bin[1] || nk < 0 ||
+                                             nk >= num_bin[2] )
+                                            continue;
+                                        bool self =
+                                            ( 0 == di && 0 == dj && 0 == dk );
+                                        int n_size =
+                                            cell_list.binSize( ni, nj, nk );
+                                        auto n_offset =
+                                            cell_list.binOffset( ni, nj, nk );
+                                        for ( int b = self ? a + 1 : 0;
+                                              b < n_size; ++b )
+                                        {
+                                            auto pj = cell_list.permutation(
+                                                n_offset + b );
+                                            double r2 = 0.0;
+                                            for ( int d = 0; d < 3; ++d )
+                                            {
+                                                double dx = positions( pi, d ) -
+                                                            positions( pj, d );
+                                                r2 += dx * dx;
+                                            }
+                                            if ( r2 <= rsqr )
+                                                Impl::accumulatePair(
+                                                    output, pi, pj,
+                                                    functor( pi, pj ) );
+                                        }
+                                    }
+                        }
+                    } );
+            }
+    exec_space.fence();
+
+    Kokkos::Profiling::popRegion();
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Cabana
@@ -18,6 +18,9 @@
 
 #include <Kokkos_Core.hpp>
 
+#include <cmath>
+#include <limits>
+
 namespace Cabana
 {
 //---------------------------------------------------------------------------//
@@ -77,6 +80,161 @@ class NeighborList
                              const std::size_t neighbor_index );
 };
 
+//---------------------------------------------------------------------------//
+// Neighbor Statistics
+//---------------------------------------------------------------------------//
+/*!
+  \brief Neighbor count statistics of a neighbor list and memory forecasts
+  for the available list layouts.
+
+  The histogram uses power of two bins: bin 0 counts particles without
+  neighbors and bin b > 0 counts particles with [2^(b-1), 2^b) neighbors.
+*/
+struct NeighborStatistics
+{
+    //! Number of histogram bins.
+    static constexpr int num_histogram_bin =
+        std::numeric_limits<unsigned int>::digits + 1;
+
+    //! Number of particles.
+    std::size_t num_particle = 0;
+
+    //! Minimum number of neighbors per particle.
+    std::size_t min_neighbor = 0;
+
+    //! Maximum number of neighbors per particle.
+    std::size_t max_neighbor = 0;
+
+    //! Total number of neighbors.
+    std::size_t total_neighbor = 0;
+
+    //! Histogram of the number of neighbors per particle.
+    Kokkos::Array<std::size_t, num_histogram_bin> histogram = {};
+
+    //! Get the histogram bin of a neighbor count.
+    KOKKOS_INLINE_FUNCTION
+    static int histogramBin( std::size_t count )
+    {
+        int bin = 0;
+        while ( count > 0 && bin < num_histogram_bin - 1 )
+        {
+            count >>= 1;
+            ++bin;
+        }
+        return bin;
+    }
+
+    //! Get the mean number of neighbors per particle.
+    double meanNeighbor() const
+    {
+        return ( num_particle > 0 )
+                   ? static_cast<double>( total_neighbor ) / num_particle
+                   : 0.0;
+    }
+
+    //! Estimated bytes of a compressed sparse row (CSR) neighbor list.
+    std::size_t csrBytes() const
+    {
+        return ( 2 * num_particle + total_neighbor ) * sizeof( int );
+    }
+
+    //! Estimated bytes of a 2D neighbor list. Particles are padded to a
+    //! multiple of the vector length for blocked (AoSoA) layouts.
+    std::size_t denseBytes( const std::size_t vector_length = 1 ) const
+    {
+        std::size_t num_padded =
+            ( num_particle + vector_length - 1 ) / vector_length *
+            vector_length;
+        return ( num_particle + num_padded * max_neighbor ) * sizeof( int );
+    }
+
+    /*!
+      \brief Get the maximum number of neighbors per particle to allocate for
+      a 2D neighbor list or the neighbor buffer size of a tree search.
+      \param headroom Relative extra capacity, e.g. 0.1 for 10%, to avoid a
+      second build pass when the neighbor counts grow.
+    */
+    std::size_t suggestedMaxNeighbor( const double headroom = 0.0 ) const
+    {
+        return std::ceil( max_neighbor * ( 1.0 + headroom ) );
+    }
+};
+
+namespace Impl
+{
+//! \cond Impl
+// Reduction of the neighbor counts of a list.
+template <class ListType>
+struct NeighborStatisticsReducer
+{
+    using value_type = NeighborStatistics;
+
+    ListType list;
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()( const std::size_t i, value_type& stats ) const
+    {
+        std::size_t count = NeighborList<ListType>::numNeighbor( list, i );
+        if ( count < stats.min_neighbor )
+            stats.min_neighbor = count;
+        if ( count > stats.max_neighbor )
+            stats.max_neighbor = count;
+        stats.total_neighbor += count;
+        stats.num_particle += 1;
+        stats.histogram[value_type::histogramBin( count )] += 1;
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void join( value_type& dst, const value_type& src ) const
+    {
+        if ( src.min_neighbor < dst.min_neighbor )
+            dst.min_neighbor = src.min_neighbor;
+        if ( src.max_neighbor > dst.max_neighbor )
+            dst.max_neighbor = src.max_neighbor;
+        dst.total_neighbor += src.total_neighbor;
+        dst.num_particle += src.num_particle;
+        for ( int b = 0; b < value_type::num_histogram_bin; ++b )
+            dst.histogram[b] += src.histogram[b];
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void init( value_type& stats ) const
+    {
+        stats.num_particle = 0;
+        stats.min_neighbor = ~std::size_t( 0 );
+        stats.max_neighbor = 0;
+        stats.total_neighbor = 0;
+        for ( int b = 0; b < value_type::num_histogram_bin; ++b )
+            stats.histogram[b] = 0;
+    }
+};
+//! \endcond
+} // end namespace Impl
+
+/*!
+  \brief Compute the neighbor count statistics of a neighbor list in a single
+  reduction.
+  \param exec_space The execution space instance.
+  \param list The neighbor list.
+  \param begin The first particle index.
+  \param end The end particle index.
+  \return The neighbor statistics of the particles in [begin, end).
+*/
+template <class ExecutionSpace, class ListType>
+NeighborStatistics neighborStatistics( const ExecutionSpace& exec_space,
+                                       const ListType& list,
+                                       const std::size_t begin,
+                                       const std::size_t end )
+{
+    NeighborStatistics stats;
+    if ( end > begin )
+        Kokkos::parallel_reduce(
+            "Cabana::neighborStatistics",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, begin, end ),
+            Impl::NeighborStatisticsReducer<ListType>{ list }, stats );
+    return stats;
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Cabana
@@ -18,11 +18,14 @@
 
 #include <Cabana_ExecutionPolicy.hpp>
 #include <Cabana_NeighborList.hpp>
+#include <Cabana_Slice.hpp>
 #include <Cabana_Types.hpp> // is_accessible_from
 
 #include <Kokkos_Core.hpp>
+#include <Kokkos_ScatterView.hpp>
 
 #include <cstdlib>
+#include <string>
 #include <type_traits>
 
 namespace Cabana
@@ -592,6 +595,578 @@ inline void neighbor_parallel_for(
     Kokkos::Profiling::popRegion();
 }
 
+//---------------------------------------------------------------------------//
+// Neighbor Parallel Scatter
+//---------------------------------------------------------------------------//
+namespace Impl
+{
+//! \cond Impl
+
+// Component access for scalar pair contributions.
+template <class T>
+struct PairContribution
+{
+    static constexpr int size = 1;
+
+    KOKKOS_INLINE_FUNCTION
+    static T get( const T& value, const int ) { return value; }
+};
+
+// Component access for vector pair contributions.
+template <class T, std::size_t N>
+struct PairContribution<Kokkos::Array<T, N>>
+{
+    static constexpr int size = N;
+
+    KOKKOS_INLINE_FUNCTION
+    static T get( const Kokkos::Array<T, N>& value, const int c )
+    {
+        return value[c];
+    }
+};
+
+// Number of components of an output slice.
+template <class SliceType>
+struct SliceComponents
+{
+    static constexpr int value =
+        ( SliceType::kokkos_view::rank == 2 )
+            ? 1
+            : static_cast<int>( SliceType::kokkos_view::static_extent( 2 ) );
+};
+
+// Kokkos::ScatterView type accumulating pair contributions: the ScatterView
+// defaults of the execution space or an explicit duplication strategy.
+// Duplicated copies are private to each thread so they do not need atomic
+// updates.
+template <class ViewType, class Duplication>
+struct NeighborScatterViewType
+{
+    using type = Kokkos::Experimental::ScatterView<
+        typename ViewType::data_type, typename ViewType::array_layout,
+        typename ViewType::device_type, Kokkos::Experimental::ScatterSum,
+        Duplication,
+        std::conditional_t<
+            std::is_same<Duplication,
+                         Kokkos::Experimental::ScatterDuplicated>::value,
+            Kokkos::Experimental::ScatterNonAtomic,
+            Kokkos::Experimental::ScatterAtomic>>;
+};
+
+template <class ViewType>
+struct NeighborScatterViewType<ViewType, void>
+{
+    using type = Kokkos::Experimental::ScatterView<
+        typename ViewType::data_type, typename ViewType::array_layout,
+        typename ViewType::device_type>;
+};
+
+// Accumulation strategy of a Kokkos::ScatterView type.
+template <class ScatterViewType>
+struct ScatterViewStrategy;
+
+template <class DataType, class Layout, class DeviceType, class Op,
+          class Duplication, class Contribution>
+struct ScatterViewStrategy<Kokkos::Experimental::ScatterView<
+    DataType, Layout, DeviceType, Op, Duplication, Contribution>>
+{
+    static constexpr bool is_duplicated =
+        std::is_same<Duplication,
+                     Kokkos::Experimental::ScatterDuplicated>::value;
+    static constexpr bool is_atomic =
+        std::is_same<Contribution, Kokkos::Experimental::ScatterAtomic>::value;
+};
+
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Reusable accumulation storage for neighbor_parallel_for over a half
+  neighbor list into an output slice.
+
+  Duplicated strategies accumulate into per-thread copies of a buffer which
+  are then added to the output slice. Keeping this object across calls (e.g.
+  every time step) avoids reallocating the copies; they are only reallocated
+  when the number of particles changes. Non-duplicated strategies accumulate
+  directly into the output slice and allocate nothing.
+
+  \tparam ExecutionSpace The execution space of the neighbor loop.
+  \tparam OutputSliceType The output slice type.
+  \tparam Duplication Optional Kokkos::Experimental::ScatterDuplicated or
+  Kokkos::Experimental::ScatterNonDuplicated. The Kokkos::ScatterView default
+  of the execution space is used otherwise.
+*/
+template <class ExecutionSpace, class OutputSliceType,
+          class Duplication = void>
+class NeighborScatterBuffer
+{
+  public:
+    static_assert( is_slice<OutputSliceType>::value, "" );
+
+    //! Kokkos execution space.
+    using execution_space = ExecutionSpace;
+    //! Kokkos memory space.
+    using memory_space = typename OutputSliceType::memory_space;
+    //! Output value type.
+    using value_type = typename OutputSliceType::value_type;
+    //! Number of output components.
+    static constexpr int num_comp =
+        Impl::SliceComponents<OutputSliceType>::value;
+
+    //! Buffer type.
+    using view_type =
+        Kokkos::View<value_type**, Kokkos::LayoutRight,
+                     Kokkos::Device<execution_space, memory_space>>;
+    //! Scatter view type.
+    using scatter_view_type =
+        typename Impl::NeighborScatterViewType<view_type, Duplication>::type;
+
+    //! Whether contributions are accumulated into per-thread copies.
+    static constexpr bool is_duplicated =
+        Impl::ScatterViewStrategy<scatter_view_type>::is_duplicated;
+    //! Whether contributions are accumulated with atomics.
+    static constexpr bool is_atomic =
+        Impl::ScatterViewStrategy<scatter_view_type>::is_atomic;
+
+    /*!
+      \brief Allocate the copies for a number of particles, if not already
+      allocated with that size, and reset them for accumulation.
+      \param exec_space The execution space instance to use.
+      \param num_particle The number of particles of the output slice.
+    */
+    void reset( const execution_space& exec_space,
+                const std::size_t num_particle )
+    {
+        if ( !_buffer.is_allocated() || _buffer.extent( 0 ) != num_particle )
+        {
+            _buffer = view_type( "Cabana::neighbor_scatter_buffer",
+                                 num_particle, num_comp );
+            _scatter = scatter_view_type( _buffer );
+        }
+        else
+        {
+            Kokkos::deep_copy( exec_space, _buffer, value_type( 0 ) );
+            _scatter.reset( exec_space );
+        }
+    }
+
+    //! Get the buffer the copies are contributed to.
+    view_type buffer() const { return _buffer; }
+
+    //! Get the scatter view.
+    scatter_view_type scatterView() const { return _scatter; }
+
+  private:
+    view_type _buffer;
+    scatter_view_type _scatter;
+};
+
+//! \cond Impl
+template <typename>
+struct is_neighbor_scatter_buffer_impl : public std::false_type
+{
+};
+
+template <class ExecutionSpace, class OutputSliceType, class Duplication>
+struct is_neighbor_scatter_buffer_impl<
+    NeighborScatterBuffer<ExecutionSpace, OutputSliceType, Duplication>>
+    : public std::true_type
+{
+};
+//! \endcond
+
+//! NeighborScatterBuffer static type checker.
+template <class T>
+struct is_neighbor_scatter_buffer
+    : public is_neighbor_scatter_buffer_impl<
+          typename std::remove_cv<T>::type>::type
+{
+};
+
+/*!
+  \brief Create reusable accumulation storage for neighbor_parallel_for over
+  a half neighbor list with the default strategy of the execution space.
+  \param exec_space The execution space of the neighbor loop.
+  \param output The output slice.
+  \return The accumulation storage.
+*/
+template <class ExecutionSpace, class OutputSliceType>
+NeighborScatterBuffer<ExecutionSpace, OutputSliceType>
+createNeighborScatterBuffer( const ExecutionSpace&, const OutputSliceType& )
+{
+    return NeighborScatterBuffer<ExecutionSpace, OutputSliceType>();
+}
+
+/*!
+  \brief Create reusable accumulation storage for neighbor_parallel_for over
+  a half neighbor list with an explicit strategy.
+  \param exec_space The execution space of the neighbor loop.
+  \param output The output slice.
+  \param Duplication Kokkos::Experimental::ScatterDuplicated or
+  Kokkos::Experimental::ScatterNonDuplicated.
+  \return The accumulation storage.
+*/
+template <class ExecutionSpace, class OutputSliceType, class Duplication>
+NeighborScatterBuffer<ExecutionSpace, OutputSliceType, Duplication>
+createNeighborScatterBuffer( const ExecutionSpace&, const OutputSliceType&,
+                             const Duplication )
+{
+    return NeighborScatterBuffer<ExecutionSpace, OutputSliceType,
+                                 Duplication>();
+}
+
+namespace Impl
+{
+//! \cond Impl
+
+// Accumulate directly into the output slice.
+template <class SliceType, bool Atomic>
+struct SliceScatterTarget
+{
+    SliceType slice;
+
+    KOKKOS_INLINE_FUNCTION
+    SliceScatterTarget access() const { return *this; }
+
+    KOKKOS_INLINE_FUNCTION
+    void add( const std::size_t p, const int c,
+              const typename SliceType::value_type v ) const
+    {
+        if constexpr ( SliceType::kokkos_view::rank == 2 )
+            add( slice( p ), v );
+        else
+            add( slice( p, c ), v );
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void add( typename SliceType::value_type& out,
+              const typename SliceType::value_type v ) const
+    {
+        if constexpr ( Atomic )
+            Kokkos::atomic_add( &out, v );
+        else
+            out += v;
+    }
+};
+
+// Accumulate into the per-thread copies of a scatter view.
+template <class ScatterViewType>
+struct DuplicatedScatterTarget
+{
+    ScatterViewType scatter;
+
+    template <class AccessType>
+    struct Access
+    {
+        AccessType access;
+
+        template <class ValueType>
+        KOKKOS_INLINE_FUNCTION void add( const std::size_t p, const int c,
+                                         const ValueType v )
+        {
+            access( p, c ) += v;
+        }
+    };
+
+    KOKKOS_INLINE_FUNCTION
+    auto access() const
+    {
+        return Access<decltype( scatter.access() )>{ scatter.access() };
+    }
+};
+
+// Accumulate pair contributions into i and their negation into j.
+template <class FunctorType, class NeighborListType, class TargetType,
+          class OpTag, class... ExecParameters>
+void neighborScatterKernel(
+    const Kokkos::RangePolicy<ExecParameters...>& exec_policy,
+    const FunctorType& functor, const NeighborListType& list,
+    const TargetType& target, OpTag, const std::string& label )
+{
+    using execution_space =
+        typename Kokkos::RangePolicy<ExecParameters...>::execution_space;
+
+    using index_type =
+        typename Kokkos::RangePolicy<ExecParameters...>::index_type;
+
+    using neighbor_list_traits = NeighborList<NeighborListType>;
+
+    using pair_type = std::remove_cv_t<std::remove_reference_t<decltype(
+        functor( index_type(), index_type() ) )>>;
+    using contribution = PairContribution<pair_type>;
+    constexpr int num_comp = contribution::size;
+
+    auto begin = exec_policy.begin();
+    auto end = exec_policy.end();
+
+    if constexpr ( std::is_same<OpTag, SerialOpTag>::value )
+    {
+        auto scatter_func = KOKKOS_LAMBDA( const index_type i )
+        {
+            auto access = target.access();
+            for ( index_type n = 0;
+                  n < neighbor_list_traits::numNeighbor( list, i ); ++n )
+            {
+                index_type j = neighbor_list_traits::getNeighbor( list, i, n );
+                auto f = functor( i, j );
+                for ( int c = 0; c < num_comp; ++c )
+                {
+                    auto v = contribution::get( f, c );
+                    access.add( i, c, v );
+                    access.add( j, c, -v );
+                }
+            }
+        };
+        Kokkos::parallel_for(
+            label,
+            Kokkos::RangePolicy<execution_space>( exec_policy.space(), begin,
+                                                  end ),
+            scatter_func );
+    }
+    else
+    {
+        using kokkos_policy = Kokkos::TeamPolicy<
+            execution_space, Kokkos::Schedule<Kokkos::Dynamic>>;
+        kokkos_policy team_policy( exec_policy.space(), end - begin,
+                                   Kokkos::AUTO );
+        auto scatter_func =
+            KOKKOS_LAMBDA( const typename kokkos_policy::member_type& team )
+        {
+            index_type i = team.league_rank() + begin;
+            Kokkos::parallel_for(
+                Kokkos::TeamThreadRange(
+                    team, neighbor_list_traits::numNeighbor( list, i ) ),
+                [&]( const index_type n )
+                {
+                    auto access = target.access();
+                    index_type j =
+                        neighbor_list_traits::getNeighbor( list, i, n );
+                    auto f = functor( i, j );
+                    for ( int c = 0; c < num_comp; ++c )
+                    {
+                        auto v = contribution::get( f, c );
+                        access.add( i, c, v );
+                        access.add( j, c, -v );
+                    }
+                } );
+        };
+        Kokkos::parallel_for( label, team_policy, scatter_func );
+    }
+}
+
+// Accumulate pair contributions into i and their negation into j with the
+// strategy of the scatter storage.
+template <class FunctorType, class NeighborListType, class OutputSliceType,
+          class ScatterBufferType, class OpTag, class... ExecParameters>
+void neighborScatter( const Kokkos::RangePolicy<ExecParameters...>& exec_policy,
+                      const FunctorType& functor, const NeighborListType& list,
+                      const OutputSliceType& output,
+                      ScatterBufferType& scatter, OpTag,
+                      const std::string& str )
+{
+    using execution_space =
+        typename Kokkos::RangePolicy<ExecParameters...>::execution_space;
+
+    using index_type =
+        typename Kokkos::RangePolicy<ExecParameters...>::index_type;
+
+    using memory_space = typename NeighborList<NeighborListType>::memory_space;
+
+    static_assert( is_accessible_from<memory_space, execution_space>{}, "" );
+    static_assert(
+        is_accessible_from<typename OutputSliceType::memory_space,
+                           execution_space>{},
+        "" );
+    static_assert( std::is_same<typename ScatterBufferType::execution_space,
+                                execution_space>::value,
+                   "" );
+
+    // Pair contributions need one value per output slice component.
+    using pair_type = std::remove_cv_t<std::remove_reference_t<decltype(
+        functor( index_type(), index_type() ) )>>;
+    static_assert( PairContribution<pair_type>::size ==
+                       SliceComponents<OutputSliceType>::value,
+                   "" );
+    static_assert( ScatterBufferType::num_comp ==
+                       SliceComponents<OutputSliceType>::value,
+                   "" );
+
+    std::string label =
+        str.empty() ? std::string( "Cabana::neighbor_parallel_for" ) : str;
+    auto exec_space = exec_policy.space();
+
+    if constexpr ( ScatterBufferType::is_duplicated )
+    {
+        // Accumulate into the per-thread copies and add their sum to the
+        // output.
+        scatter.reset( exec_space, output.size() );
+        auto scatter_view = scatter.scatterView();
+        neighborScatterKernel(
+            exec_policy, functor, list,
+            DuplicatedScatterTarget<decltype( scatter_view )>{ scatter_view },
+            OpTag(), label );
+        auto buffer = scatter.buffer();
+        Kokkos::Experimental::contribute( exec_space, buffer, scatter_view );
+
+        constexpr int num_comp = ScatterBufferType::num_comp;
+        Kokkos::parallel_for(
+            "Cabana::neighbor_parallel_for::add_output",
+            Kokkos::RangePolicy<execution_space>( exec_space, 0,
+                                                  output.size() ),
+            KOKKOS_LAMBDA( const index_type p ) {
+                if constexpr ( OutputSliceType::kokkos_view::rank == 2 )
+                    output( p ) += buffer( p, 0 );
+                else
+                    for ( int c = 0; c < num_comp; ++c )
+                        output( p, c ) += buffer( p, c );
+            } );
+    }
+    else
+    {
+        neighborScatterKernel(
+            exec_policy, functor, list,
+            SliceScatterTarget<OutputSliceType,
+                               ScatterBufferType::is_atomic>{ output },
+            OpTag(), label );
+    }
+}
+
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Execute a pair functor in parallel over a half neighbor list and
+  accumulate the pair contributions into both particles of each pair.
+
+  \tparam FunctorType The pair functor type to execute.
+  \tparam NeighborListType The neighbor list type.
+  \tparam OutputSliceType The output slice type.
+  \tparam OpTag SerialOpTag or TeamOpTag loop strategy over neighbors.
+  \tparam ExecParams The Kokkos range policy parameters.
+
+  \param exec_policy The policy over which to execute the functor.
+  \param functor The pair functor. It is called as functor( i, j ) and returns
+  the contribution of the pair to particle i, either a scalar for a scalar
+  output slice or a Kokkos::Array with one value per slice component. The
+  negated contribution is added to particle j (Newton's third law).
+  \param list The half neighbor list. Each pair must appear only once.
+  \param output The slice to which the contributions are added.
+  \param FirstNeighborsTag Tag indicating operations over particle first
+  neighbors.
+  \param OpTag Tag indicating the loop strategy over neighbors.
+  \param str Optional name for the functor.
+
+  Writes to particles i and j are accumulated with the default
+  Kokkos::ScatterView strategy of the execution space: thread-duplicated
+  buffers on host threaded backends and atomics on GPUs. Use the overload
+  taking a NeighborScatterBuffer to reuse the duplicated buffers across
+  calls.
+*/
+template <class FunctorType, class NeighborListType, class OutputSliceType,
+          class OpTag, class... ExecParameters>
+inline std::enable_if_t<is_slice<OutputSliceType>::value &&
+                        ( std::is_same<OpTag, SerialOpTag>::value ||
+                          std::is_same<OpTag, TeamOpTag>::value )>
+neighbor_parallel_for(
+    const Kokkos::RangePolicy<ExecParameters...>& exec_policy,
+    const FunctorType& functor, const NeighborListType& list,
+    const OutputSliceType& output, const FirstNeighborsTag, const OpTag,
+    const std::string& str = "" )
+{
+    Kokkos::Profiling::pushRegion( "Cabana::neighbor_parallel_for" );
+
+    using execution_space =
+        typename Kokkos::RangePolicy<ExecParameters...>::execution_space;
+    NeighborScatterBuffer<execution_space, OutputSliceType> scatter;
+    Impl::neighborScatter( exec_policy, functor, list, output, scatter,
+                           OpTag(), str );
+
+    Kokkos::Profiling::popRegion();
+}
+
+/*!
+  \brief Execute a pair functor in parallel over a half neighbor list and
+  accumulate the pair contributions into both particles of each pair with an
+  explicit accumulation strategy.
+
+  \param exec_policy The policy over which to execute the functor.
+  \param functor The pair functor.
+  \param list The half neighbor list. Each pair must appear only once.
+  \param output The slice to which the contributions are added.
+  \param FirstNeighborsTag Tag indicating operations over particle first
+  neighbors.
+  \param OpTag Tag indicating the loop strategy over neighbors.
+  \param Duplication Kokkos::Experimental::ScatterDuplicated to accumulate
+  into per-thread copies or Kokkos::Experimental::ScatterNonDuplicated to
+  accumulate with atomics.
+  \param str Optional name for the functor.
+*/
+template <class FunctorType, class NeighborListType, class OutputSliceType,
+          class OpTag, class Duplication, class... ExecParameters>
+inline std::enable_if_t<
+    is_slice<OutputSliceType>::value &&
+    ( std::is_same<OpTag, SerialOpTag>::value ||
+      std::is_same<OpTag, TeamOpTag>::value ) &&
+    ( std::is_same<Duplication,
+                   Kokkos::Experimental::ScatterDuplicated>::value ||
+      std::is_same<Duplication,
+                   Kokkos::Experimental::ScatterNonDuplicated>::value )>
+neighbor_parallel_for(
+    const Kokkos::RangePolicy<ExecParameters...>& exec_policy,
+    const FunctorType& functor, const NeighborListType& list,
+    const OutputSliceType& output, const FirstNeighborsTag, const OpTag,
+    const Duplication, const std::string& str = "" )
+{
+    Kokkos::Profiling::pushRegion( "Cabana::neighbor_parallel_for" );
+
+    using execution_space =
+        typename Kokkos::RangePolicy<ExecParameters...>::execution_space;
+    NeighborScatterBuffer<execution_space, OutputSliceType, Duplication>
+        scatter;
+    Impl::neighborScatter( exec_policy, functor, list, output, scatter,
+                           OpTag(), str );
+
+    Kokkos::Profiling::popRegion();
+}
+
+/*!
+  \brief Execute a pair functor in parallel over a half neighbor list and
+  accumulate the pair contributions into both particles of each pair with
+  reusable accumulation storage.
+
+  \param exec_policy The policy over which to execute the functor.
+  \param functor The pair functor.
+  \param list The half neighbor list. Each pair must appear only once.
+  \param output The slice to which the contributions are added.
+  \param FirstNeighborsTag Tag indicating operations over particle first
+  neighbors.
+  \param OpTag Tag indicating the loop strategy over neighbors.
+  \param scatter The accumulation storage, created with
+  createNeighborScatterBuffer and kept across calls.
+  \param str Optional name for the functor.
+*/
+template <class FunctorType, class NeighborListType, class OutputSliceType,
+          class OpTag, class ScatterBufferType, class... ExecParameters>
+inline std::enable_if_t<is_slice<OutputSliceType>::value &&
+                        ( std::is_same<OpTag, SerialOpTag>::value ||
+                          std::is_same<OpTag, TeamOpTag>::value ) &&
+                        is_neighbor_scatter_buffer<ScatterBufferType>::value>
+neighbor_parallel_for(
+    const Kokkos::RangePolicy<ExecParameters...>& exec_policy,
+    const FunctorType& functor, const NeighborListType& list,
+    const OutputSliceType& output, const FirstNeighborsTag, const OpTag,
+    ScatterBufferType& scatter, const std::string& str = "" )
+{
+    Kokkos::Profiling::pushRegion( "Cabana::neighbor_parallel_for" );
+
+    Impl::neighborScatter( exec_policy, functor, list, output, scatter,
+                           OpTag(), str );
+
+    Kokkos::Profiling::popRegion();
+}
+
 //---------------------------------------------------------------------------//
 // Neighbor Parallel Reduce
 //---------------------------------------------------------------------------//
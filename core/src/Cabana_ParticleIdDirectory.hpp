@@ -0,0 +1,363 @@
+/****************************************************************************
+ * Copyright (c) 2018-2023 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_ParticleIdDirectory.hpp
+  \brief Distributed directory of the owning rank of particle global ids
+*/
+#ifndef CABANA_PARTICLEIDDIRECTORY_HPP
+#define CABANA_PARTICLEIDDIRECTORY_HPP
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_Distributor.hpp>
+#include <Cabana_ParticleIdIndex.hpp>
+#include <Cabana_Slice.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_UnorderedMap.hpp>
+
+#include <mpi.h>
+
+#include <cstdint>
+#include <type_traits>
+
+namespace Cabana
+{
+namespace Impl
+{
+//! \cond Impl
+// Rank of the directory entry of a global id.
+template <class IdType>
+KOKKOS_INLINE_FUNCTION int directoryRank( const IdType id,
+                                          const int comm_size )
+{
+    // Mix the bits of the id such that consecutive ids are spread over the
+    // ranks.
+    std::uint64_t h = static_cast<std::uint64_t>( id );
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return static_cast<int>( h % static_cast<std::uint64_t>( comm_size ) );
+}
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Distributed directory of the rank owning each particle global id.
+
+  \tparam MemorySpace The Kokkos memory space in which the directory resides.
+  \tparam IdType The global id type.
+
+  Each id is registered on a directory rank given by a hash of the id modulo
+  the number of ranks, independent of the rank owning the particle. The
+  owner of any set of ids is then found in one batched round trip to the
+  directory ranks. After particles migrate only the imported particles need
+  to be registered again.
+*/
+template <class MemorySpace, class IdType = long>
+class ParticleIdDirectory
+{
+  public:
+    static_assert( Kokkos::is_memory_space<MemorySpace>::value, "" );
+
+    //! Kokkos memory space.
+    using memory_space = MemorySpace;
+    //! Default execution space.
+    using execution_space = typename memory_space::execution_space;
+    //! Global id type.
+    using id_type = IdType;
+    //! Hash map type.
+    using map_type = Kokkos::UnorderedMap<id_type, int, memory_space>;
+
+    /*!
+      \brief Constructor.
+      \param comm The communicator over which particles are distributed.
+    */
+    ParticleIdDirectory( MPI_Comm comm )
+        : _comm( comm )
+    {
+        MPI_Comm_rank( _comm, &_comm_rank );
+        MPI_Comm_size( _comm, &_comm_size );
+    }
+
+    /*!
+      \brief Build the directory from the particles owned by every rank.
+      \param exec_space The execution space to use.
+      \param ids The global ids of the local particles.
+      \param size The number of local particles.
+    */
+    template <class ExecutionSpace, class IdSlice>
+    void build( ExecutionSpace exec_space, const IdSlice& ids,
+                const std::size_t size )
+    {
+        Kokkos::Profiling::pushRegion( "Cabana::ParticleIdDirectory::build" );
+        _map.clear();
+        update( exec_space, ids, 0, size );
+        Kokkos::Profiling::popRegion();
+    }
+
+    /*!
+      \brief Build the directory from the particles owned by every rank.
+      \param ids The global ids of the local particles.
+      \param size The number of local particles.
+    */
+    template <class IdSlice>
+    void build( const IdSlice& ids, const std::size_t size )
+    {
+        build( execution_space{}, ids, size );
+    }
+
+    /*!
+      \brief Register the particles in a range as owned by this rank.
+
+      After a migrate() only the particles imported from other ranks need to
+      be registered; their previous entries are overwritten. Collective.
+
+      \param exec_space The execution space to use.
+      \param ids The global ids of the local particles.
+      \param begin The first local index to register.
+      \param end One past the last local index to register.
+    */
+    template <class ExecutionSpace, class IdSlice>
+    void update( ExecutionSpace exec_space, const IdSlice& ids,
+                 const std::size_t begin, const std::size_t end )
+    {
+        Kokkos::Profiling::pushRegion( "Cabana::ParticleIdDirectory::update" );
+        setOwner( exec_space, ids, begin, end, _comm_rank );
+        Kokkos::Profiling::popRegion();
+    }
+
+    /*!
+      \brief Register the particles in a range as owned by this rank.
+      Collective.
+      \param ids The global ids of the local particles.
+      \param begin The first local index to register.
+      \param end One past the last local index to register.
+    */
+    template <class IdSlice>
+    void update( const IdSlice& ids, const std::size_t begin,
+                 const std::size_t end )
+    {
+        update( execution_space{}, ids, begin, end );
+    }
+
+    /*!
+      \brief Set the owning rank of the ids of a range of local particles,
+      e.g. -1 to unregister particles which are about to be removed.
+      Collective.
+
+      \param exec_space The execution space to use.
+      \param ids The global ids of the local particles.
+      \param begin The first local index to set.
+      \param end One past the last local index to set.
+      \param owner_rank The owning rank to set.
+    */
+    template <class ExecutionSpace, class IdSlice>
+    void setOwner( ExecutionSpace exec_space, const IdSlice& ids,
+                   const std::size_t begin, const std::size_t end,
+                   const int owner_rank )
+    {
+        using entry_types = MemberTypes<id_type, int>;
+        std::size_t num_entry = end - begin;
+        AoSoA<entry_types, memory_space> entries( "entries", num_entry );
+        auto e_id = slice<0>( entries );
+        auto e_rank = slice<1>( entries );
+        Kokkos::View<int*, memory_space> export_ranks(
+            Kokkos::ViewAllocateWithoutInitializing( "export_ranks" ),
+            num_entry );
+        int comm_size = _comm_size;
+        Kokkos::parallel_for(
+            "Cabana::ParticleIdDirectory::pack_entries",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_entry ),
+            KOKKOS_LAMBDA( const int e ) {
+                e_id( e ) = ids( begin + e );
+                e_rank( e ) = owner_rank;
+                export_ranks( e ) =
+                    Impl::directoryRank( e_id( e ), comm_size );
+            } );
+        exec_space.fence();
+        Distributor<memory_space> distributor( _comm, export_ranks );
+        AoSoA<entry_types, memory_space> received(
+            "received", distributor.totalNumImport() );
+        migrate( exec_space, distributor, entries, received );
+
+        // Insert the entries, growing the map if it is full.
+        std::size_t num_received = received.size();
+        if ( _map.capacity() < _map.size() + num_received )
+            _map.rehash( _map.size() + num_received );
+        auto r_id = slice<0>( received );
+        auto r_rank = slice<1>( received );
+        do
+        {
+            if ( _map.failed_insert() )
+                _map.rehash( 2 * _map.capacity() );
+
+            auto map = _map;
+            Kokkos::parallel_for(
+                "Cabana::ParticleIdDirectory::insert",
+                Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                                     num_received ),
+                KOKKOS_LAMBDA( const int r ) {
+                    auto result = map.insert( r_id( r ), r_rank( r ) );
+                    if ( result.existing() )
+                        map.value_at( result.index() ) = r_rank( r );
+                } );
+            exec_space.fence();
+        } while ( _map.failed_insert() );
+    }
+
+    /*!
+      \brief Find the owning rank of a set of global ids. Collective.
+      \param exec_space The execution space to use.
+      \param query_ids The global ids to find.
+      \return The owning rank of each id, or -1 if the id is not registered.
+    */
+    template <class ExecutionSpace>
+    Kokkos::View<int*, memory_space>
+    owner( ExecutionSpace exec_space,
+           const Kokkos::View<id_type*, memory_space>& query_ids ) const
+    {
+        Kokkos::Profiling::pushRegion( "Cabana::ParticleIdDirectory::owner" );
+
+        // Send the queries to the directory ranks with their origin.
+        using query_types = MemberTypes<id_type, int, int>;
+        std::size_t num_query = query_ids.size();
+        AoSoA<query_types, memory_space> queries( "queries", num_query );
+        auto q_id = slice<0>( queries );
+        auto q_rank = slice<1>( queries );
+        auto q_index = slice<2>( queries );
+        Kokkos::View<int*, memory_space> export_ranks(
+            Kokkos::ViewAllocateWithoutInitializing( "export_ranks" ),
+            num_query );
+        int comm_rank = _comm_rank;
+        int comm_size = _comm_size;
+        Kokkos::parallel_for(
+            "Cabana::ParticleIdDirectory::pack_queries",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_query ),
+            KOKKOS_LAMBDA( const int q ) {
+                q_id( q ) = query_ids( q );
+                q_rank( q ) = comm_rank;
+                q_index( q ) = q;
+                export_ranks( q ) =
+                    Impl::directoryRank( query_ids( q ), comm_size );
+            } );
+        exec_space.fence();
+        Distributor<memory_space> query_distributor( _comm, export_ranks );
+        AoSoA<query_types, memory_space> received(
+            "received", query_distributor.totalNumImport() );
+        migrate( exec_space, query_distributor, queries, received );
+
+        // Answer the queries in place, replacing the origin rank with the
+        // owner rank, and send them back to their origin.
+        auto r_id = slice<0>( received );
+        auto r_rank = slice<1>( received );
+        auto map = _map;
+        std::size_t num_received = received.size();
+        Kokkos::View<int*, memory_space> return_ranks(
+            Kokkos::ViewAllocateWithoutInitializing( "return_ranks" ),
+            num_received );
+        Kokkos::parallel_for(
+            "Cabana::ParticleIdDirectory::answer_queries",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_received ),
+            KOKKOS_LAMBDA( const int r ) {
+                auto i = map.find( r_id( r ) );
+                return_ranks( r ) = r_rank( r );
+                r_rank( r ) = map.valid_at( i ) ? map.value_at( i ) : -1;
+            } );
+        exec_space.fence();
+        Distributor<memory_space> answer_distributor( _comm, return_ranks );
+        AoSoA<query_types, memory_space> answers(
+            "answers", answer_distributor.totalNumImport() );
+        migrate( exec_space, answer_distributor, received, answers );
+
+        // Scatter the answers to the order of the queries.
+        Kokkos::View<int*, memory_space> owners( "owners", num_query );
+        auto a_owner = slice<1>( answers );
+        auto a_index = slice<2>( answers );
+        Kokkos::parallel_for(
+            "Cabana::ParticleIdDirectory::unpack_answers",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                                 answers.size() ),
+            KOKKOS_LAMBDA( const int a ) {
+                owners( a_index( a ) ) = a_owner( a );
+            } );
+        exec_space.fence();
+
+        Kokkos::Profiling::popRegion();
+        return owners;
+    }
+
+    /*!
+      \brief Find the owning rank of a set of global ids. Collective.
+      \param query_ids The global ids to find.
+      \return The owning rank of each id, or -1 if the id is not registered.
+    */
+    Kokkos::View<int*, memory_space>
+    owner( const Kokkos::View<id_type*, memory_space>& query_ids ) const
+    {
+        return owner( execution_space{}, query_ids );
+    }
+
+    //! Get the number of ids registered on this directory rank.
+    std::size_t numRegistered() const { return _map.size(); }
+
+  private:
+    MPI_Comm _comm;
+    int _comm_rank;
+    int _comm_size;
+    map_type _map;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Migrate an AoSoA in place with the distributor and update the
+  particle id index of its particles. Collective.
+
+  The particles staying on this rank are the first ones received, in the
+  order of the distributor steering. Their entries are reassigned from the
+  ids held by the index before the migration, the entries of the particles
+  which left are invalidated, and the imported particles are inserted.
+
+  \tparam IdMember The AoSoA member containing the particle global ids.
+
+  \param exec_space Kokkos execution space.
+  \param distributor The distributor to use for the migration.
+  \param aosoa The AoSoA containing the data to be migrated.
+  \param index The particle id index of the AoSoA.
+*/
+template <std::size_t IdMember, class ExecutionSpace, class Distributor_t,
+          class AoSoA_t, class MemorySpace, class IdType>
+void migrate( ExecutionSpace exec_space, const Distributor_t& distributor,
+              AoSoA_t& aosoa, ParticleIdIndex<MemorySpace, IdType>& index,
+              typename std::enable_if<( is_distributor<Distributor_t>::value &&
+                                        is_aosoa<AoSoA_t>::value ),
+                                      int>::type* = 0 )
+{
+    // The elements sent to this rank come first in the steering and are
+    // received first.
+    int my_rank = -1;
+    MPI_Comm_rank( distributor.comm(), &my_rank );
+    std::size_t num_stay = ( distributor.numNeighbor() > 0 &&
+                             distributor.neighborRank( 0 ) == my_rank )
+                               ? distributor.numExport( 0 )
+                               : 0;
+
+    migrate( exec_space, distributor, aosoa );
+    index.compact( exec_space, distributor.getExportSteering(), num_stay,
+                   slice<IdMember>( aosoa ), aosoa.size() );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_PARTICLEIDDIRECTORY_HPP
@@ -0,0 +1,450 @@
+/****************************************************************************
+ * Copyright (c) 2018-2023 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_ParticleIdIndex.hpp
+  \brief Hashed lookup of local particles by global id
+*/
+#ifndef CABANA_PARTICLEIDINDEX_HPP
+#define CABANA_PARTICLEIDINDEX_HPP
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_Slice.hpp>
+#include <Cabana_Sort.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_UnorderedMap.hpp>
+
+#include <cassert>
+#include <type_traits>
+
+namespace Cabana
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Device hash map from particle global id to local particle index.
+
+  \tparam MemorySpace The Kokkos memory space in which the map resides.
+  \tparam IdType The global id type.
+
+  The index follows the particles through the overloads of permute() and
+  migrate() taking the index, which remap only the entries of the moved
+  particles from the permutation or the distributor steering. After other
+  changes, e.g. removing particles, call update() with the range of local
+  indices that changed, or insert() for particles appended to the end,
+  before the next find().
+
+  Updates are in place. Only the entries of the changed range are
+  reassigned, and only the ids that previously occupied the changed local
+  indices, or local indices past the new number of particles, are
+  invalidated. The id previously held at each local index is kept for this
+  purpose. Invalidated entries are kept in the map until enough of them
+  accumulate that the map is rebuilt, such that updates do not reallocate.
+*/
+template <class MemorySpace, class IdType = long>
+class ParticleIdIndex
+{
+  public:
+    static_assert( Kokkos::is_memory_space<MemorySpace>::value, "" );
+
+    //! Kokkos memory space.
+    using memory_space = MemorySpace;
+    //! Default execution space.
+    using execution_space = typename memory_space::execution_space;
+    //! Global id type.
+    using id_type = IdType;
+    //! Hash map type.
+    using map_type = Kokkos::UnorderedMap<id_type, int, memory_space>;
+
+    /*!
+      \brief Constructor.
+      \param capacity Initial capacity of the map.
+    */
+    ParticleIdIndex( const std::size_t capacity = 0 )
+        : _map( capacity )
+        , _num_stale( 0 )
+        , _size( 0 )
+    {
+    }
+
+    /*!
+      \brief Build the index from scratch.
+      \param exec_space The execution space to use.
+      \param ids The global ids of the local particles.
+      \param size The number of local particles to index.
+    */
+    template <class ExecutionSpace, class IdSlice>
+    void build( ExecutionSpace exec_space, const IdSlice& ids,
+                const std::size_t size )
+    {
+        Kokkos::Profiling::pushRegion( "Cabana::ParticleIdIndex::build" );
+
+        _map.clear();
+        _num_stale = 0;
+        _size = 0;
+        insert( exec_space, ids, 0, size );
+
+        Kokkos::Profiling::popRegion();
+    }
+
+    /*!
+      \brief Build the index from scratch.
+      \param ids The global ids of the local particles.
+      \param size The number of local particles to index.
+    */
+    template <class IdSlice>
+    void build( const IdSlice& ids, const std::size_t size )
+    {
+        build( execution_space{}, ids, size );
+    }
+
+    /*!
+      \brief Update the index after the particles in a range have changed
+      local index.
+
+      Entries of particles in [begin, end) are reassigned. The entries of the
+      ids previously held in [begin, end) or past size are invalidated unless
+      the particle moved within [begin, end). After a permute() pass the
+      binned range, after a migrate() pass the full range of the migrated
+      particles, and after removing particles pass the range of particles
+      that were moved to fill the gaps.
+
+      \param exec_space The execution space to use.
+      \param ids The global ids of the local particles.
+      \param begin The first local index that changed.
+      \param end One past the last local index that changed.
+      \param size The number of local particles to index.
+    */
+    template <class ExecutionSpace, class IdSlice>
+    void update( ExecutionSpace exec_space, const IdSlice& ids,
+                 const std::size_t begin, const std::size_t end,
+                 const std::size_t size )
+    {
+        Kokkos::Profiling::pushRegion( "Cabana::ParticleIdIndex::update" );
+
+        assert( begin <= end );
+        assert( end <= size );
+
+        // Rebuild if half of the map is stale.
+        if ( 2 * _num_stale > _map.size() )
+        {
+            build( exec_space, ids, size );
+            Kokkos::Profiling::popRegion();
+            return;
+        }
+
+        insert( exec_space, ids, begin, end );
+
+        // Invalidate the ids previously held past the new size which did not
+        // move into the changed range.
+        if ( size < _size )
+        {
+            auto map = _map;
+            auto local_ids = _local_ids;
+            int num_invalid = 0;
+            Kokkos::parallel_reduce(
+                "Cabana::ParticleIdIndex::invalidate_removed",
+                Kokkos::RangePolicy<ExecutionSpace>( exec_space, size, _size ),
+                KOKKOS_LAMBDA( const int p, int& invalid ) {
+                    auto i = map.find( local_ids( p ) );
+                    if ( map.valid_at( i ) && map.value_at( i ) == p )
+                    {
+                        map.value_at( i ) = -1;
+                        ++invalid;
+                    }
+                },
+                num_invalid );
+            _num_stale += num_invalid;
+        }
+        _size = size;
+
+        Kokkos::Profiling::popRegion();
+    }
+
+    /*!
+      \brief Update the index after the particles in a range have changed
+      local index.
+      \param ids The global ids of the local particles.
+      \param begin The first local index that changed.
+      \param end One past the last local index that changed.
+      \param size The number of local particles to index.
+    */
+    template <class IdSlice>
+    void update( const IdSlice& ids, const std::size_t begin,
+                 const std::size_t end, const std::size_t size )
+    {
+        update( execution_space{}, ids, begin, end, size );
+    }
+
+    /*!
+      \brief Update the index after the particles in the binned range have
+      been permuted. The ids are taken from the index itself.
+      \param exec_space The execution space to use.
+      \param binning_data The binning data used to permute the particles.
+    */
+    template <class ExecutionSpace, class BinningDataType>
+    void permute( ExecutionSpace exec_space,
+                  const BinningDataType& binning_data )
+    {
+        Kokkos::Profiling::pushRegion( "Cabana::ParticleIdIndex::permute" );
+
+        static_assert( is_binning_data<BinningDataType>::value, "" );
+
+        auto begin = binning_data.rangeBegin();
+        auto end = binning_data.rangeEnd();
+        assert( end <= _size );
+
+        // Gather the ids in their permuted order.
+        auto local_ids = _local_ids;
+        Kokkos::View<id_type*, memory_space> permuted_ids(
+            Kokkos::ViewAllocateWithoutInitializing( "permuted_ids" ),
+            end - begin );
+        Kokkos::parallel_for(
+            "Cabana::ParticleIdIndex::permute_ids",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, begin, end ),
+            KOKKOS_LAMBDA( const int p ) {
+                permuted_ids( p - begin ) =
+                    local_ids( binning_data.permutation( p - begin ) );
+            } );
+
+        // Reassign the permuted range. The range holds the same ids such
+        // that no entry is invalidated.
+        auto map = _map;
+        Kokkos::parallel_for(
+            "Cabana::ParticleIdIndex::permute",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, begin, end ),
+            KOKKOS_LAMBDA( const int p ) {
+                auto id = permuted_ids( p - begin );
+                local_ids( p ) = id;
+                auto i = map.find( id );
+                if ( map.valid_at( i ) )
+                    map.value_at( i ) = p;
+            } );
+        exec_space.fence();
+
+        Kokkos::Profiling::popRegion();
+    }
+
+    /*!
+      \brief Update the index after the local particles have been replaced by
+      a compacted subset of the previous local particles followed by new
+      particles, e.g. after migrate().
+
+      The particle at local index p in [0, num_kept) was previously at local
+      index kept(p). Its entry is reassigned from the id previously held
+      there. The entries of the previous particles which were not kept are
+      invalidated and the new particles in [num_kept, size) are inserted.
+
+      \param exec_space The execution space to use.
+      \param kept The previous local index of each kept particle.
+      \param num_kept The number of kept particles.
+      \param ids The global ids of the local particles.
+      \param size The number of local particles to index.
+    */
+    template <class ExecutionSpace, class KeptViewType, class IdSlice>
+    void compact( ExecutionSpace exec_space, const KeptViewType& kept,
+                  const std::size_t num_kept, const IdSlice& ids,
+                  const std::size_t size )
+    {
+        Kokkos::Profiling::pushRegion( "Cabana::ParticleIdIndex::compact" );
+
+        assert( num_kept <= size );
+
+        // Rebuild if half of the map is stale.
+        if ( 2 * _num_stale > _map.size() )
+        {
+            build( exec_space, ids, size );
+            Kokkos::Profiling::popRegion();
+            return;
+        }
+
+        // Reassign the kept particles.
+        auto map = _map;
+        auto prev_ids = _local_ids;
+        Kokkos::View<id_type*, memory_space> local_ids(
+            Kokkos::ViewAllocateWithoutInitializing( "local_ids" ), size );
+        Kokkos::parallel_for(
+            "Cabana::ParticleIdIndex::compact_kept",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_kept ),
+            KOKKOS_LAMBDA( const int p ) {
+                auto id = prev_ids( kept( p ) );
+                local_ids( p ) = id;
+                auto i = map.find( id );
+                if ( map.valid_at( i ) )
+                    map.value_at( i ) = p;
+            } );
+
+        // Invalidate the previous particles which were not kept. Their
+        // entries still point to their previous local index.
+        int num_invalid = 0;
+        Kokkos::parallel_reduce(
+            "Cabana::ParticleIdIndex::compact_invalidate",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, _size ),
+            KOKKOS_LAMBDA( const int q, int& invalid ) {
+                auto id = prev_ids( q );
+                auto i = map.find( id );
+                if ( map.valid_at( i ) && map.value_at( i ) == q &&
+                     !( static_cast<std::size_t>( q ) < num_kept &&
+                        local_ids( q ) == id ) )
+                {
+                    map.value_at( i ) = -1;
+                    ++invalid;
+                }
+            },
+            num_invalid );
+        _num_stale += num_invalid;
+        _local_ids = local_ids;
+        _size = num_kept;
+
+        // Insert the new particles.
+        insert( exec_space, ids, num_kept, size );
+
+        Kokkos::Profiling::popRegion();
+    }
+
+    /*!
+      \brief Find the local index of a particle.
+      \param id The global id of the particle.
+      \return The local index or -1 if the particle is not on this rank.
+    */
+    KOKKOS_INLINE_FUNCTION
+    int find( const id_type id ) const
+    {
+        auto i = _map.find( id );
+        return _map.valid_at( i ) ? _map.value_at( i ) : -1;
+    }
+
+    /*!
+      \brief Insert or reassign the local index of the particles in a range,
+      e.g. particles appended to the end of the local particles. The ids
+      previously held in the range are invalidated unless they moved within
+      the range. The map is grown if it is full.
+      \param exec_space The execution space to use.
+      \param ids The global ids of the local particles.
+      \param begin The first local index to insert.
+      \param end One past the last local index to insert.
+    */
+    template <class ExecutionSpace, class IdSlice>
+    void insert( ExecutionSpace exec_space, const IdSlice& ids,
+                 const std::size_t begin, const std::size_t end )
+    {
+        // Invalidate the ids previously held in the range. Ids which moved
+        // within the range are assigned again below.
+        long num_stale = _num_stale;
+        std::size_t replace_end = ( end < _size ) ? end : _size;
+        if ( begin < replace_end )
+        {
+            auto map = _map;
+            auto local_ids = _local_ids;
+            int num_invalid = 0;
+            Kokkos::parallel_reduce(
+                "Cabana::ParticleIdIndex::invalidate_replaced",
+                Kokkos::RangePolicy<ExecutionSpace>( exec_space, begin,
+                                                     replace_end ),
+                KOKKOS_LAMBDA( const int p, int& invalid ) {
+                    if ( local_ids( p ) == ids( p ) )
+                        return;
+                    auto i = map.find( local_ids( p ) );
+                    if ( map.valid_at( i ) && map.value_at( i ) == p )
+                    {
+                        map.value_at( i ) = -1;
+                        ++invalid;
+                    }
+                },
+                num_invalid );
+            num_stale += num_invalid;
+        }
+
+        if ( _map.capacity() < _map.size() + end - begin )
+            _map.rehash( _map.size() + end - begin );
+
+        do
+        {
+            if ( _map.failed_insert() )
+                _map.rehash( 2 * _map.capacity() );
+
+            // Count the invalidated entries assigned again.
+            auto map = _map;
+            int num_valid = 0;
+            Kokkos::parallel_reduce(
+                "Cabana::ParticleIdIndex::insert",
+                Kokkos::RangePolicy<ExecutionSpace>( exec_space, begin, end ),
+                KOKKOS_LAMBDA( const int p, int& valid ) {
+                    auto result = map.insert( ids( p ), p );
+                    if ( result.existing() )
+                    {
+                        if ( map.value_at( result.index() ) < 0 )
+                            ++valid;
+                        map.value_at( result.index() ) = p;
+                    }
+                },
+                num_valid );
+            num_stale -= num_valid;
+        } while ( _map.failed_insert() );
+        _num_stale = num_stale;
+
+        // Keep the ids now held in the range.
+        if ( _local_ids.extent( 0 ) < end )
+            Kokkos::resize( _local_ids, end );
+        if ( _size < end )
+            _size = end;
+        auto local_ids = _local_ids;
+        Kokkos::parallel_for(
+            "Cabana::ParticleIdIndex::local_ids",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, begin, end ),
+            KOKKOS_LAMBDA( const int p ) { local_ids( p ) = ids( p ); } );
+        exec_space.fence();
+    }
+
+    //! Get the number of entries in the map, including invalidated entries.
+    std::size_t size() const { return _map.size(); }
+
+    //! Get the capacity of the map.
+    std::size_t capacity() const { return _map.capacity(); }
+
+  private:
+    map_type _map;
+    std::size_t _num_stale;
+    std::size_t _size;
+    Kokkos::View<id_type*, memory_space> _local_ids;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Given binning data permute an AoSoA and update the particle id index
+  of its particles.
+
+  Only the entries of the binned range are reassigned, using the ids held by
+  the index before the permutation.
+
+  \param exec_space The execution space instance to use.
+  \param binning_data The binning data.
+  \param aosoa The AoSoA to permute.
+  \param index The particle id index of the AoSoA.
+*/
+template <class ExecutionSpace, class BinningDataType, class AoSoA_t,
+          class MemorySpace, class IdType>
+void permute(
+    const ExecutionSpace& exec_space, const BinningDataType& binning_data,
+    AoSoA_t& aosoa, ParticleIdIndex<MemorySpace, IdType>& index,
+    typename std::enable_if<( is_binning_data<BinningDataType>::value &&
+                              is_aosoa<AoSoA_t>::value ),
+                            int>::type* = 0 )
+{
+    permute( exec_space, binning_data, aosoa );
+    index.permute( exec_space, binning_data );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_PARTICLEIDINDEX_HPP
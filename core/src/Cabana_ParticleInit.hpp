@@ -137,7 +137,7 @@ int createParticles(
     Kokkos::RangePolicy<ExecutionSpace> exec_policy( exec_space, 0,
                                                      num_particles );
     Kokkos::parallel_for( exec_policy, random_coord_op );
-    Kokkos::fence();
+    exec_space.fence();
 
     auto count_host =
         Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), count );
@@ -226,7 +226,7 @@ void createParticles(
     Kokkos::RangePolicy<ExecutionSpace> exec_policy( exec_space, 0,
                                                      num_particles );
     Kokkos::parallel_for( exec_policy, random_coord_op );
-    Kokkos::fence();
+    exec_space.fence();
 }
 
 /*!
@@ -480,7 +480,7 @@ createRandomParticlesMinDistance( ExecutionSpace exec_space,
     Kokkos::RangePolicy<ExecutionSpace> exec_policy( exec_space, 0,
                                                      num_particles );
     Kokkos::parallel_for( exec_policy, random_coord_op );
-    Kokkos::fence();
+    exec_space.fence();
 }
 
 } // namespace Cabana
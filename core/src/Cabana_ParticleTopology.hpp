@@ -0,0 +1,410 @@
+/****************************************************************************
+ * Copyright (c) 2018-2023 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_ParticleTopology.hpp
+  \brief Bond, angle, and dihedral lists that follow their owning particles
+*/
+#ifndef CABANA_PARTICLETOPOLOGY_HPP
+#define CABANA_PARTICLETOPOLOGY_HPP
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_Distributor.hpp>
+#include <Cabana_Halo.hpp>
+#include <Cabana_LinkedCellList.hpp>
+#include <Cabana_ParticleIdDirectory.hpp>
+#include <Cabana_ParticleIdIndex.hpp>
+#include <Cabana_Slice.hpp>
+#include <Cabana_Sort.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_UnorderedMap.hpp>
+
+#include <mpi.h>
+
+#include <exception>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Cabana
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Topology entries (bonds, angles, dihedrals) referencing particles by
+  global id.
+
+  \tparam MemorySpace The Kokkos memory space in which the entries reside.
+  \tparam NumMember The number of particles in each entry (2 for bonds, 3 for
+  angles, 4 for dihedrals).
+  \tparam IdType The particle global id type.
+
+  Each entry stores the global ids of its member particles and their local
+  indices, or -1 for members which are not available on this rank. An entry
+  is owned by the rank owning its first member: migrate() moves the entries
+  with their owning particles using the particle distributor topology and
+  permute() remaps the local indices with the particle permutation, such that
+  the topology never needs to be rebuilt. The ghosts needed by the entries
+  are given by createTopologyHalo().
+*/
+template <class MemorySpace, int NumMember, class IdType = long>
+class ParticleTopology
+{
+  public:
+    static_assert( Kokkos::is_memory_space<MemorySpace>::value, "" );
+
+    //! Kokkos memory space.
+    using memory_space = MemorySpace;
+    //! Default execution space.
+    using execution_space = typename memory_space::execution_space;
+    //! Particle global id type.
+    using id_type = IdType;
+    //! Number of particles in each entry.
+    static constexpr int num_member = NumMember;
+    //! Entry member types: member global ids and member local indices.
+    using member_types = MemberTypes<id_type[NumMember], int[NumMember]>;
+    //! Entry AoSoA type.
+    using aosoa_type = AoSoA<member_types, memory_space>;
+
+    /*!
+      \brief Constructor.
+      \param label The entry label.
+      \param num_entry The number of entries.
+    */
+    ParticleTopology( const std::string& label = "topology",
+                      const std::size_t num_entry = 0 )
+        : _entries( label, num_entry )
+    {
+    }
+
+    //! Get the number of entries.
+    std::size_t size() const { return _entries.size(); }
+
+    //! Resize the entries.
+    void resize( const std::size_t num_entry ) { _entries.resize( num_entry ); }
+
+    //! Get the entries.
+    aosoa_type& entries() { return _entries; }
+
+    //! Get the entries.
+    const aosoa_type& entries() const { return _entries; }
+
+    //! Get the member global ids of the entries.
+    auto memberIds() const { return slice<0>( _entries, "member_ids" ); }
+
+    //! Get the member local indices of the entries.
+    auto localIndices() const { return slice<1>( _entries, "local_indices" ); }
+
+    /*!
+      \brief Resolve the local index of every member from the particle id
+      index, e.g. after a migration or after gathering ghosts.
+      \param exec_space The execution space to use.
+      \param index The particle id index of the local and ghosted particles.
+    */
+    template <class ExecutionSpace, class IndexType>
+    void resolve( ExecutionSpace exec_space, const IndexType& index )
+    {
+        auto ids = memberIds();
+        auto local = localIndices();
+        Kokkos::parallel_for(
+            "Cabana::ParticleTopology::resolve",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, size() ),
+            KOKKOS_LAMBDA( const int e ) {
+                for ( int m = 0; m < NumMember; ++m )
+                    local( e, m ) = index.find( ids( e, m ) );
+            } );
+        exec_space.fence();
+    }
+
+    /*!
+      \brief Remap the member local indices after the particles have been
+      permuted with the given binning data.
+      \param exec_space The execution space to use.
+      \param binning_data The binning data used to permute the particles.
+    */
+    template <class ExecutionSpace, class BinningDataType>
+    void permute(
+        ExecutionSpace exec_space, const BinningDataType& binning_data,
+        typename std::enable_if<( is_binning_data<BinningDataType>::value ),
+                                int>::type* = 0 )
+    {
+        Kokkos::Profiling::pushRegion( "Cabana::ParticleTopology::permute" );
+
+        // Invert the permutation of the binned range.
+        std::size_t begin = binning_data.rangeBegin();
+        std::size_t end = binning_data.rangeEnd();
+        Kokkos::View<int*, memory_space> new_index(
+            Kokkos::ViewAllocateWithoutInitializing( "new_index" ),
+            end - begin );
+        Kokkos::parallel_for(
+            "Cabana::ParticleTopology::invert_permutation",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, begin, end ),
+            KOKKOS_LAMBDA( const std::size_t i ) {
+                new_index( binning_data.permutation( i - begin ) - begin ) = i;
+            } );
+
+        // Remap the members in the binned range.
+        auto local = localIndices();
+        Kokkos::parallel_for(
+            "Cabana::ParticleTopology::remap",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, size() ),
+            KOKKOS_LAMBDA( const int e ) {
+                for ( int m = 0; m < NumMember; ++m )
+                {
+                    int p = local( e, m );
+                    if ( p >= static_cast<int>( begin ) &&
+                         p < static_cast<int>( end ) )
+                        local( e, m ) = new_index( p - begin );
+                }
+            } );
+        exec_space.fence();
+
+        Kokkos::Profiling::popRegion();
+    }
+
+    /*!
+      \brief Remap the member local indices after the particles have been
+      permuted with the given cell list.
+      \param exec_space The execution space to use.
+      \param cell_list The cell list used to permute the particles.
+    */
+    template <class ExecutionSpace>
+    void permute( ExecutionSpace exec_space,
+                  const LinkedCellList<memory_space>& cell_list )
+    {
+        permute( exec_space, cell_list.binningData() );
+    }
+
+    /*!
+      \brief Move the entries with their owning particles. Collective.
+
+      The entries are sent to the destination of their first member using the
+      neighbor topology of the particle distributor. Entries whose owning
+      particle is removed (destination -1) are removed. The topology must be
+      resolved: an exception is thrown on all ranks if the owning particle
+      of any entry is not local, e.g. when migrating twice without resolving
+      in between. The member local indices are invalid after migration; call
+      resolve() once the particle id index has been updated.
+
+      \param exec_space The execution space to use.
+      \param particle_distributor The distributor migrating the particles.
+      \param particle_export_ranks The destination ranks of the particles
+      used to create the particle distributor.
+    */
+    template <class ExecutionSpace, class Distributor_t, class RankViewType>
+    void migrate( ExecutionSpace exec_space,
+                  const Distributor_t& particle_distributor,
+                  const RankViewType& particle_export_ranks )
+    {
+        Kokkos::Profiling::pushRegion( "Cabana::ParticleTopology::migrate" );
+
+        static_assert( is_distributor<Distributor_t>::value, "" );
+
+        // Check that the owning particle of every entry is local such that no
+        // entry is dropped.
+        auto local = localIndices();
+        int num_unresolved = 0;
+        Kokkos::parallel_reduce(
+            "Cabana::ParticleTopology::check_resolved",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, size() ),
+            KOKKOS_LAMBDA( const int e, int& unresolved ) {
+                if ( local( e, 0 ) < 0 )
+                    ++unresolved;
+            },
+            num_unresolved );
+        MPI_Allreduce( MPI_IN_PLACE, &num_unresolved, 1, MPI_INT, MPI_SUM,
+                       particle_distributor.comm() );
+        if ( num_unresolved > 0 )
+        {
+            Kokkos::Profiling::popRegion();
+            throw std::runtime_error(
+                "Topology entries must be resolved before migration!" );
+        }
+
+        // Send each entry to the destination of its owning particle.
+        Kokkos::View<int*, memory_space> export_ranks(
+            Kokkos::ViewAllocateWithoutInitializing( "export_ranks" ),
+            size() );
+        Kokkos::parallel_for(
+            "Cabana::ParticleTopology::export_ranks",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, size() ),
+            KOKKOS_LAMBDA( const int e ) {
+                export_ranks( e ) = particle_export_ranks( local( e, 0 ) );
+            } );
+        exec_space.fence();
+
+        // The entries go to a subset of the particle destinations so the
+        // particle topology is reused.
+        std::vector<int> neighbor_ranks( particle_distributor.numNeighbor() );
+        for ( int n = 0; n < particle_distributor.numNeighbor(); ++n )
+            neighbor_ranks[n] = particle_distributor.neighborRank( n );
+        Distributor<memory_space> entry_distributor(
+            particle_distributor.comm(), export_ranks, neighbor_ranks );
+        Cabana::migrate( exec_space, entry_distributor, _entries );
+
+        // Invalidate the local indices until they are resolved.
+        local = localIndices();
+        Kokkos::parallel_for(
+            "Cabana::ParticleTopology::invalidate",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, size() ),
+            KOKKOS_LAMBDA( const int e ) {
+                for ( int m = 0; m < NumMember; ++m )
+                    local( e, m ) = -1;
+            } );
+        exec_space.fence();
+
+        Kokkos::Profiling::popRegion();
+    }
+
+  private:
+    aosoa_type _entries;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create the halo gathering the particles referenced by topology
+  entries which are not available on this rank. Collective.
+
+  The unique missing member ids are requested from their owning ranks, found
+  with the particle id directory, and the owners export the requested
+  particles. An exception is thrown on all ranks if any missing id is not
+  registered in the directory or not found in the particle id index of its
+  owning rank. After gathering, insert the ghost ids into the particle id
+  index and resolve() the topology.
+
+  \param exec_space The execution space to use.
+  \param comm The communicator over which the particles are distributed.
+  \param topology The topology entries, resolved against the local particles.
+  \param directory The particle id directory.
+  \param index The particle id index of the local particles.
+  \param num_local The number of local particles.
+  \return The halo of the topology ghosts.
+*/
+template <class ExecutionSpace, class MemorySpace, int NumMember,
+          class IdType>
+Halo<MemorySpace>
+createTopologyHalo( ExecutionSpace exec_space, MPI_Comm comm,
+                    const ParticleTopology<MemorySpace, NumMember, IdType>&
+                        topology,
+                    const ParticleIdDirectory<MemorySpace, IdType>& directory,
+                    const ParticleIdIndex<MemorySpace, IdType>& index,
+                    const std::size_t num_local )
+{
+    Kokkos::Profiling::pushRegion( "Cabana::createTopologyHalo" );
+
+    // Collect the unique ids of the members which are not local.
+    auto ids = topology.memberIds();
+    auto local = topology.localIndices();
+    Kokkos::UnorderedMap<IdType, void, MemorySpace> missing(
+        topology.size() * NumMember );
+    Kokkos::parallel_for(
+        "Cabana::createTopologyHalo::find_missing",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, topology.size() ),
+        KOKKOS_LAMBDA( const int e ) {
+            for ( int m = 0; m < NumMember; ++m )
+                if ( local( e, m ) < 0 )
+                    missing.insert( ids( e, m ) );
+        } );
+    exec_space.fence();
+    Kokkos::View<IdType*, MemorySpace> missing_ids(
+        Kokkos::ViewAllocateWithoutInitializing( "missing_ids" ),
+        missing.size() );
+    Kokkos::parallel_scan(
+        "Cabana::createTopologyHalo::compact_missing",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                             missing.capacity() ),
+        KOKKOS_LAMBDA( const int i, int& offset, const bool final_pass ) {
+            if ( missing.valid_at( i ) )
+            {
+                if ( final_pass )
+                    missing_ids( offset ) = missing.key_at( i );
+                ++offset;
+            }
+        } );
+    exec_space.fence();
+
+    // Send the requests to the owning ranks.
+    auto owners = directory.owner( exec_space, missing_ids );
+    int num_unregistered = 0;
+    Kokkos::parallel_reduce(
+        "Cabana::createTopologyHalo::check_owners",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, owners.size() ),
+        KOKKOS_LAMBDA( const int q, int& unregistered ) {
+            if ( owners( q ) < 0 )
+                ++unregistered;
+        },
+        num_unregistered );
+    MPI_Allreduce( MPI_IN_PLACE, &num_unregistered, 1, MPI_INT, MPI_SUM,
+                   comm );
+    if ( num_unregistered > 0 )
+    {
+        Kokkos::Profiling::popRegion();
+        throw std::runtime_error(
+            "Topology member ids not registered in the directory!" );
+    }
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    using request_types = MemberTypes<IdType, int>;
+    AoSoA<request_types, MemorySpace> requests( "requests",
+                                                missing_ids.size() );
+    auto q_id = slice<0>( requests );
+    auto q_rank = slice<1>( requests );
+    Kokkos::parallel_for(
+        "Cabana::createTopologyHalo::pack_requests",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                             missing_ids.size() ),
+        KOKKOS_LAMBDA( const int q ) {
+            q_id( q ) = missing_ids( q );
+            q_rank( q ) = comm_rank;
+        } );
+    exec_space.fence();
+    Distributor<MemorySpace> request_distributor( comm, owners );
+    AoSoA<request_types, MemorySpace> received(
+        "received", request_distributor.totalNumImport() );
+    migrate( exec_space, request_distributor, requests, received );
+
+    // Export the requested particles to the requesting ranks.
+    auto r_id = slice<0>( received );
+    auto r_rank = slice<1>( received );
+    Kokkos::View<int*, MemorySpace> export_ids(
+        Kokkos::ViewAllocateWithoutInitializing( "export_ids" ),
+        received.size() );
+    Kokkos::View<int*, MemorySpace> export_ranks(
+        Kokkos::ViewAllocateWithoutInitializing( "export_ranks" ),
+        received.size() );
+    int num_not_found = 0;
+    Kokkos::parallel_reduce(
+        "Cabana::createTopologyHalo::exports",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, received.size() ),
+        KOKKOS_LAMBDA( const int r, int& not_found ) {
+            export_ids( r ) = index.find( r_id( r ) );
+            export_ranks( r ) = r_rank( r );
+            if ( export_ids( r ) < 0 )
+                ++not_found;
+        },
+        num_not_found );
+    MPI_Allreduce( MPI_IN_PLACE, &num_not_found, 1, MPI_INT, MPI_SUM, comm );
+    if ( num_not_found > 0 )
+    {
+        Kokkos::Profiling::popRegion();
+        throw std::runtime_error(
+            "Requested topology members not found in the particle id index!" );
+    }
+
+    Kokkos::Profiling::popRegion();
+    return Halo<MemorySpace>( comm, num_local, export_ids, export_ranks );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_PARTICLETOPOLOGY_HPP
@@ -0,0 +1,149 @@
+/****************************************************************************
+ * Copyright (c) 2018-2023 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_PartitionedPipeline.hpp
+  \brief Run independent pipelines on partitioned execution space instances.
+*/
+#ifndef CABANA_PARTITIONEDPIPELINE_HPP
+#define CABANA_PARTITIONEDPIPELINE_HPP
+
+#include <Kokkos_Core.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Cabana
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Run several independent pipelines (e.g. one per particle species)
+  concurrently on partitions of an execution space.
+
+  Each pipeline is assigned its own execution space instance. Stages are
+  launched stage-major: a stage is issued for every pipeline before the next
+  stage begins. Cabana algorithms only fence the instance they are given, so
+  while one pipeline blocks in MPI communication the kernels already issued
+  for the other pipelines continue to execute.
+
+  \tparam ExecutionSpace Kokkos execution space.
+*/
+template <class ExecutionSpace>
+class PartitionedPipeline
+{
+  public:
+    //! Kokkos execution space.
+    using execution_space = ExecutionSpace;
+
+    /*!
+      \brief Constructor.
+      \param exec_space The execution space instance to partition.
+      \param weights The relative amount of resources to give each pipeline.
+      The number of weights is the number of pipelines.
+    */
+    template <class T>
+    PartitionedPipeline( const execution_space& exec_space,
+                         const std::vector<T>& weights )
+    {
+        if ( weights.empty() )
+            throw std::runtime_error(
+                "PartitionedPipeline requires at least one partition" );
+        std::vector<T> w( weights );
+        _spaces = Kokkos::Experimental::partition_space( exec_space, w );
+    }
+
+    /*!
+      \brief Constructor. Resources are divided evenly.
+      \param exec_space The execution space instance to partition.
+      \param num_pipeline The number of pipelines.
+    */
+    PartitionedPipeline( const execution_space& exec_space,
+                         const int num_pipeline )
+        : PartitionedPipeline( exec_space, std::vector<int>( num_pipeline, 1 ) )
+    {
+    }
+
+    //! Get the number of pipelines.
+    int numPipeline() const { return _spaces.size(); }
+
+    //! Get the execution space instance of a pipeline.
+    const execution_space& space( const int p ) const { return _spaces[p]; }
+
+    /*!
+      \brief Issue one stage for every pipeline.
+
+      The stage functor is called on the host as functor( exec_space, p ) for
+      every pipeline p in order, where exec_space is the instance of that
+      pipeline. The functor should enqueue its work on exec_space and only
+      fence that instance (e.g. before MPI communication).
+
+      \param label The stage label used for profiling.
+      \param functor The stage functor.
+      \return This pipeline so stages may be chained.
+    */
+    template <class StageFunctor>
+    PartitionedPipeline& stage( const std::string& label,
+                                const StageFunctor& functor )
+    {
+        Kokkos::Profiling::pushRegion( "Cabana::PartitionedPipeline::" +
+                                       label );
+        for ( int p = 0; p < numPipeline(); ++p )
+            functor( _spaces[p], p );
+        Kokkos::Profiling::popRegion();
+        return *this;
+    }
+
+    //! Wait for all work issued to every pipeline instance.
+    void fence() const
+    {
+        for ( auto& s : _spaces )
+            s.fence( "Cabana::PartitionedPipeline::fence" );
+    }
+
+  private:
+    std::vector<execution_space> _spaces;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a partitioned pipeline with evenly divided resources.
+  \param exec_space The execution space instance to partition.
+  \param num_pipeline The number of pipelines.
+  \return The partitioned pipeline.
+*/
+template <class ExecutionSpace>
+PartitionedPipeline<ExecutionSpace>
+createPartitionedPipeline( const ExecutionSpace& exec_space,
+                           const int num_pipeline )
+{
+    return PartitionedPipeline<ExecutionSpace>( exec_space, num_pipeline );
+}
+
+/*!
+  \brief Create a partitioned pipeline with weighted resources.
+  \param exec_space The execution space instance to partition.
+  \param weights The relative amount of resources to give each pipeline.
+  \return The partitioned pipeline.
+*/
+template <class ExecutionSpace, class T>
+PartitionedPipeline<ExecutionSpace>
+createPartitionedPipeline( const ExecutionSpace& exec_space,
+                           const std::vector<T>& weights )
+{
+    return PartitionedPipeline<ExecutionSpace>( exec_space, weights );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_PARTITIONEDPIPELINE_HPP
@@ -212,7 +212,6 @@ keyMinMax( KeyViewType keys, const std::size_t begin, const std::size_t end )
             }
         },
         reducer );
-    Kokkos::fence();
 
     Kokkos::Profiling::popRegion();
 
@@ -548,15 +547,20 @@ auto binByKey(
 /*!
   \brief Given binning data permute an AoSoA.
 
+  Kernels are enqueued on the given execution space instance and only that
+  instance is fenced.
+
+  \tparam ExecutionSpace Kokkos execution space.
   \tparam BinningDataType The binning data type.
   \tparam AoSoA_t The AoSoA type.
+  \param exec_space The execution space instance to use.
   \param binning_data The binning data.
   \param aosoa The AoSoA to permute.
  */
-template <class BinningDataType, class AoSoA_t,
-          class ExecutionSpace = typename BinningDataType::execution_space>
+template <class ExecutionSpace, class BinningDataType, class AoSoA_t>
 void permute(
-    const BinningDataType& binning_data, AoSoA_t& aosoa,
+    const ExecutionSpace& exec_space, const BinningDataType& binning_data,
+    AoSoA_t& aosoa,
     typename std::enable_if<( is_binning_data<BinningDataType>::value &&
                               is_aosoa<AoSoA_t>::value ),
                             int>::type* = 0 )
@@ -569,7 +573,6 @@ void permute(
     auto begin = binning_data.rangeBegin();
     auto end = binning_data.rangeEnd();
 
-    using memory_space = typename BinningDataType::memory_space;
     Kokkos::View<typename AoSoA_t::tuple_type*, memory_space> scratch_tuples(
         Kokkos::ViewAllocateWithoutInitializing( "scratch_tuples" ),
         end - begin );
@@ -579,37 +582,63 @@ void permute(
         scratch_tuples( i - begin ) =
             aosoa.getTuple( binning_data.permutation( i - begin ) );
     };
-    Kokkos::parallel_for( "Cabana::kokkosBinSort::permute_to_scratch",
-                          Kokkos::RangePolicy<ExecutionSpace>( begin, end ),
-                          permute_to_scratch );
-    Kokkos::fence();
+    Kokkos::parallel_for(
+        "Cabana::kokkosBinSort::permute_to_scratch",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, begin, end ),
+        permute_to_scratch );
 
+    // The copy back is ordered after the permutation on the same instance.
     auto copy_back = KOKKOS_LAMBDA( const std::size_t i )
     {
         aosoa.setTuple( i, scratch_tuples( i - begin ) );
     };
-    Kokkos::parallel_for( "Cabana::kokkosBinSort::copy_back",
-                          Kokkos::RangePolicy<ExecutionSpace>( begin, end ),
-                          copy_back );
-    Kokkos::fence();
+    Kokkos::parallel_for(
+        "Cabana::kokkosBinSort::copy_back",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, begin, end ),
+        copy_back );
+    exec_space.fence();
 
     Kokkos::Profiling::popRegion();
 }
 
+/*!
+  \brief Given binning data permute an AoSoA.
+
+  \tparam BinningDataType The binning data type.
+  \tparam AoSoA_t The AoSoA type.
+  \param binning_data The binning data.
+  \param aosoa The AoSoA to permute.
+ */
+template <class BinningDataType, class AoSoA_t,
+          class ExecutionSpace = typename BinningDataType::execution_space>
+void permute(
+    const BinningDataType& binning_data, AoSoA_t& aosoa,
+    typename std::enable_if<( is_binning_data<BinningDataType>::value &&
+                              is_aosoa<AoSoA_t>::value ),
+                            int>::type* = 0 )
+{
+    permute( ExecutionSpace(), binning_data, aosoa );
+}
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Given binning data permute a slice.
 
+  Kernels are enqueued on the given execution space instance and only that
+  instance is fenced.
+
+  \tparam ExecutionSpace Kokkos execution space.
   \tparam BinningDataType The binning data type.
   \tparam SliceType The slice type.
 
+  \param exec_space The execution space instance to use.
   \param binning_data The binning data.
   \param slice The slice to permute.
  */
-template <class BinningDataType, class SliceType,
-          class ExecutionSpace = typename BinningDataType::execution_space>
+template <class ExecutionSpace, class BinningDataType, class SliceType>
 void permute(
-    const BinningDataType& binning_data, SliceType& slice,
+    const ExecutionSpace& exec_space, const BinningDataType& binning_data,
+    SliceType& slice,
     typename std::enable_if<( is_binning_data<BinningDataType>::value &&
                               is_slice<SliceType>::value ),
                             int>::type* = 0 )
@@ -644,11 +673,12 @@ void permute(
             scratch_array( i - begin, n ) =
                 slice_data[slice_offset + SliceType::vector_length * n];
     };
-    Kokkos::parallel_for( "Cabana::kokkosBinSort::permute_to_scratch",
-                          Kokkos::RangePolicy<ExecutionSpace>( begin, end ),
-                          permute_to_scratch );
-    Kokkos::fence();
+    Kokkos::parallel_for(
+        "Cabana::kokkosBinSort::permute_to_scratch",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, begin, end ),
+        permute_to_scratch );
 
+    // The copy back is ordered after the permutation on the same instance.
     auto copy_back = KOKKOS_LAMBDA( const std::size_t i )
     {
         auto s = SliceType::index_type::s( i );
@@ -658,14 +688,35 @@ void permute(
             slice_data[slice_offset + SliceType::vector_length * n] =
                 scratch_array( i - begin, n );
     };
-    Kokkos::parallel_for( "Cabana::kokkosBinSort::copy_back",
-                          Kokkos::RangePolicy<ExecutionSpace>( begin, end ),
-                          copy_back );
-    Kokkos::fence();
+    Kokkos::parallel_for(
+        "Cabana::kokkosBinSort::copy_back",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, begin, end ),
+        copy_back );
+    exec_space.fence();
 
     Kokkos::Profiling::popRegion();
 }
 
+/*!
+  \brief Given binning data permute a slice.
+
+  \tparam BinningDataType The binning data type.
+  \tparam SliceType The slice type.
+
+  \param binning_data The binning data.
+  \param slice The slice to permute.
+ */
+template <class BinningDataType, class SliceType,
+          class ExecutionSpace = typename BinningDataType::execution_space>
+void permute(
+    const BinningDataType& binning_data, SliceType& slice,
+    typename std::enable_if<( is_binning_data<BinningDataType>::value &&
+                              is_slice<SliceType>::value ),
+                            int>::type* = 0 )
+{
+    permute( ExecutionSpace(), binning_data, slice );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Cabana
@@ -0,0 +1,559 @@
+/****************************************************************************
+ * Copyright (c) 2018-2023 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_SparseCellList.hpp
+  \brief Sparse cell list binning and sorting
+*/
+#ifndef CABANA_SPARSECELLLIST_HPP
+#define CABANA_SPARSECELLLIST_HPP
+
+#include <Cabana_Slice.hpp>
+#include <Cabana_Sort.hpp>
+#include <impl/Cabana_CartesianGrid.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <cassert>
+#include <cstdint>
+
+namespace Cabana
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Cell list over a 3d regular Cartesian grid storing only the occupied
+  cells.
+
+  Particles are sorted by the key of the cell containing them. Only the sorted
+  unique keys of the occupied cells, their offsets, and their sizes are
+  stored, so memory scales with the number of particles rather than the number
+  of cells in the grid. Bins are the occupied cells in cardinal index order.
+  Cells are looked up by ijk index with a binary search over the keys.
+*/
+template <class MemorySpace>
+class SparseCellList
+{
+  public:
+    //! Memory space.
+    using memory_space = MemorySpace;
+    static_assert( Kokkos::is_memory_space<MemorySpace>(), "" );
+
+    //! Default execution space.
+    using execution_space = typename memory_space::execution_space;
+    //! Memory space size type.
+    using size_type = typename memory_space::size_type;
+    //! Cell key type.
+    using key_type = std::uint64_t;
+
+    //! Binning view type.
+    using CountView = Kokkos::View<int*, memory_space>;
+    //! Offset view type.
+    using OffsetView = Kokkos::View<size_type*, memory_space>;
+    //! Cell key view type.
+    using KeyView = Kokkos::View<key_type*, memory_space>;
+
+    /*!
+      \brief Default constructor.
+    */
+    SparseCellList() {}
+
+    /*!
+      \brief Slice constructor
+
+      \tparam SliceType Slice type for positions.
+
+      \param positions Slice of positions.
+
+      \param grid_delta Grid sizes in each cardinal direction.
+
+      \param grid_min Grid minimum value in each direction.
+
+      \param grid_max Grid maximum value in each direction.
+    */
+    template <class SliceType>
+    SparseCellList(
+        SliceType positions, const typename SliceType::value_type grid_delta[3],
+        const typename SliceType::value_type grid_min[3],
+        const typename SliceType::value_type grid_max[3],
+        typename std::enable_if<( is_slice<SliceType>::value ), int>::type* =
+            0 )
+        : _grid( grid_min[0], grid_min[1], grid_min[2], grid_max[0],
+                 grid_max[1], grid_max[2], grid_delta[0], grid_delta[1],
+                 grid_delta[2] )
+    {
+        build( positions, 0, positions.size() );
+    }
+
+    /*!
+      \brief Slice range constructor
+
+      \tparam SliceType Slice type for positions.
+
+      \param positions Slice of positions.
+
+      \param begin The beginning index of the AoSoA range to sort.
+
+      \param end The end index of the AoSoA range to sort.
+
+      \param grid_delta Grid sizes in each cardinal direction.
+
+      \param grid_min Grid minimum value in each direction.
+
+      \param grid_max Grid maximum value in each direction.
+    */
+    template <class SliceType>
+    SparseCellList(
+        SliceType positions, const std::size_t begin, const std::size_t end,
+        const typename SliceType::value_type grid_delta[3],
+        const typename SliceType::value_type grid_min[3],
+        const typename SliceType::value_type grid_max[3],
+        typename std::enable_if<( is_slice<SliceType>::value ), int>::type* =
+            0 )
+        : _grid( grid_min[0], grid_min[1], grid_min[2], grid_max[0],
+                 grid_max[1], grid_max[2], grid_delta[0], grid_delta[1],
+                 grid_delta[2] )
+    {
+        build( positions, begin, end );
+    }
+
+    /*!
+      \brief Get the number of occupied bins.
+      \return The number of occupied bins.
+    */
+    KOKKOS_INLINE_FUNCTION
+    int numOccupiedBin() const { return _cell_keys.extent( 0 ); }
+
+    /*!
+      \brief Get the number of cells of the grid in a given dimension.
+      \param dim The dimension to get the number of cells for.
+      \return The number of cells.
+    */
+    KOKKOS_INLINE_FUNCTION
+    int numBin( const int dim ) const { return _grid.numBin( dim ); }
+
+    /*!
+      \brief Get the cell size in a given dimension.
+      \param dim The dimension to get the cell size for.
+      \return The cell size.
+    */
+    KOKKOS_INLINE_FUNCTION
+    double binDelta( const int dim ) const
+    {
+        return ( 0 == dim ) ? _grid._dx : ( 1 == dim ) ? _grid._dy : _grid._dz;
+    }
+
+    /*!
+      \brief Get the cell in which a point is located.
+      \param xp, yp, zp The point coordinates.
+      \param i, j, k The cell indices. Points outside the grid give indices
+      outside the range of cells.
+    */
+    KOKKOS_INLINE_FUNCTION
+    void locatePoint( const double xp, const double yp, const double zp,
+                      int& i, int& j, int& k ) const
+    {
+        _grid.locatePoint( xp, yp, zp, i, j, k );
+    }
+
+    /*!
+      \brief Given the ijk index of a cell get its key.
+      \param i The i cell index (x).
+      \param j The j cell index (y).
+      \param k The k cell index (z).
+      \return The cell key.
+    */
+    KOKKOS_INLINE_FUNCTION
+    key_type cellKey( const int i, const int j, const int k ) const
+    {
+        return ( static_cast<key_type>( i ) * _grid._ny + j ) * _grid._nz + k;
+    }
+
+    /*!
+      \brief Given an occupied bin get the ijk indices of its cell.
+      \param bin The occupied bin index.
+      \param i The i cell index (x).
+      \param j The j cell index (y).
+      \param k The k cell index (z).
+    */
+    KOKKOS_INLINE_FUNCTION
+    void ijkBinIndex( const int bin, int& i, int& j, int& k ) const
+    {
+        key_type key = _cell_keys( bin );
+        key_type nyz = static_cast<key_type>( _grid._ny ) * _grid._nz;
+        i = key / nyz;
+        j = ( key / _grid._nz ) % _grid._ny;
+        k = key % _grid._nz;
+    }
+
+    /*!
+      \brief Given the ijk index of a cell find its occupied bin.
+      \param i The i cell index (x).
+      \param j The j cell index (y).
+      \param k The k cell index (z).
+      \return The occupied bin index or -1 if the cell is empty.
+    */
+    KOKKOS_INLINE_FUNCTION
+    int findBin( const int i, const int j, const int k ) const
+    {
+        key_type key = cellKey( i, j, k );
+        int lo = 0;
+        int hi = _cell_keys.extent( 0 );
+        while ( lo < hi )
+        {
+            int mid = lo + ( hi - lo ) / 2;
+            if ( _cell_keys( mid ) < key )
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return ( lo < static_cast<int>( _cell_keys.extent( 0 ) ) &&
+                 _cell_keys( lo ) == key )
+                   ? lo
+                   : -1;
+    }
+
+    /*!
+      \brief Given a cell get the number of particles it contains.
+      \param i The i cell index (x).
+      \param j The j cell index (y).
+      \param k The k cell index (z).
+      \return The number of particles in the cell.
+    */
+    KOKKOS_INLINE_FUNCTION
+    int binSize( const int i, const int j, const int k ) const
+    {
+        int bin = findBin( i, j, k );
+        return ( bin < 0 ) ? 0 : _bin_data.binSize( bin );
+    }
+
+    /*!
+      \brief Given a cell get the particle index at which it sorts.
+      \param i The i cell index (x).
+      \param j The j cell index (y).
+      \param k The k cell index (z).
+      \return The starting particle index of the cell. Empty cells have no
+      particles and return zero.
+    */
+    KOKKOS_INLINE_FUNCTION
+    size_type binOffset( const int i, const int j, const int k ) const
+    {
+        int bin = findBin( i, j, k );
+        return ( bin < 0 ) ? 0 : _bin_data.binOffset( bin );
+    }
+
+    /*!
+      \brief Given a local particle id in the binned layout, get the id of the
+      particle in the old (unbinned) layout.
+      \param particle_id The id of the particle in the binned layout.
+      \return The particle id in the old (unbinned) layout.
+    */
+    KOKKOS_INLINE_FUNCTION
+    size_type permutation( const int particle_id ) const
+    {
+        return _bin_data.permutation( particle_id );
+    }
+
+    /*!
+      \brief The beginning particle index binned by the cell list.
+    */
+    KOKKOS_INLINE_FUNCTION
+    std::size_t rangeBegin() const { return _bin_data.rangeBegin(); }
+
+    /*!
+      \brief The ending particle index binned by the cell list.
+    */
+    KOKKOS_INLINE_FUNCTION
+    std::size_t rangeEnd() const { return _bin_data.rangeEnd(); }
+
+    /*!
+      \brief Get the 1d bin data. Bins are the occupied cells.
+      \return The 1d bin data.
+    */
+    BinningData<MemorySpace> binningData() const { return _bin_data; }
+
+    /*!
+      \brief Build the cell list with a subset of particles.
+
+      \tparam ExecutionSpace Kokkos execution space.
+      \tparam SliceType Slice type for positions.
+
+      \param exec_space The execution space instance to use.
+      \param positions Slice of positions.
+      \param begin The beginning index of the slice range to sort.
+      \param end The end index of the slice range to sort.
+    */
+    template <class ExecutionSpace, class SliceType>
+    void build( ExecutionSpace exec_space, SliceType positions,
+                const std::size_t begin, const std::size_t end )
+    {
+        Kokkos::Profiling::pushRegion( "Cabana::SparseCellList::build" );
+
+        static_assert( is_accessible_from<memory_space, ExecutionSpace>{}, "" );
+        assert( end >= begin );
+        assert( end <= positions.size() );
+
+        std::size_t nparticles = end - begin;
+        Kokkos::RangePolicy<ExecutionSpace> particle_range( exec_space, 0,
+                                                            nparticles );
+
+        // Compute the cell key of each particle.
+        KeyView keys(
+            Kokkos::view_alloc( Kokkos::WithoutInitializing, "keys" ),
+            nparticles );
+        auto grid = _grid;
+        Kokkos::parallel_for(
+            "Cabana::SparseCellList::build::cell_keys", particle_range,
+            KOKKOS_LAMBDA( const std::size_t p ) {
+                int i, j, k;
+                grid.locatePoint( positions( begin + p, 0 ),
+                                  positions( begin + p, 1 ),
+                                  positions( begin + p, 2 ), i, j, k );
+                keys( p ) =
+                    ( static_cast<key_type>( i ) * grid._ny + j ) * grid._nz +
+                    k;
+            } );
+
+        // Sort the particles by key.
+        OffsetView permutes(
+            Kokkos::view_alloc( Kokkos::WithoutInitializing, "permutes" ),
+            nparticles );
+        KeyView sorted_keys(
+            Kokkos::view_alloc( Kokkos::WithoutInitializing, "sorted_keys" ),
+            nparticles );
+        if ( nparticles > 1 )
+        {
+            exec_space.fence();
+            auto key_sort = sortByKey<KeyView, ExecutionSpace>( keys );
+            Kokkos::parallel_for(
+                "Cabana::SparseCellList::build::permute", particle_range,
+                KOKKOS_LAMBDA( const std::size_t p ) {
+                    auto s = key_sort.permutation( p );
+                    permutes( p ) = begin + s;
+                    sorted_keys( p ) = keys( s );
+                } );
+        }
+        else
+        {
+            Kokkos::parallel_for(
+                "Cabana::SparseCellList::build::permute", particle_range,
+                KOKKOS_LAMBDA( const std::size_t p ) {
+                    permutes( p ) = begin + p;
+                    sorted_keys( p ) = keys( p );
+                } );
+        }
+
+        // Find the first particle of each occupied cell.
+        OffsetView cell_starts(
+            Kokkos::view_alloc( Kokkos::WithoutInitializing, "cell_starts" ),
+            nparticles );
+        int num_cell = 0;
+        Kokkos::parallel_scan(
+            "Cabana::SparseCellList::build::cell_scan", particle_range,
+            KOKKOS_LAMBDA( const std::size_t p, int& update,
+                           const bool final_pass ) {
+                if ( 0 == p || sorted_keys( p ) != sorted_keys( p - 1 ) )
+                {
+                    if ( final_pass )
+                        cell_starts( update ) = p;
+                    ++update;
+                }
+            },
+            num_cell );
+
+        // Store the unique keys, offsets, and sizes of the occupied cells.
+        _cell_keys = KeyView(
+            Kokkos::view_alloc( Kokkos::WithoutInitializing, "cell_keys" ),
+            num_cell );
+        CountView counts(
+            Kokkos::view_alloc( Kokkos::WithoutInitializing, "counts" ),
+            num_cell );
+        OffsetView offsets(
+            Kokkos::view_alloc( Kokkos::WithoutInitializing, "offsets" ),
+            num_cell );
+        auto cell_keys = _cell_keys;
+        Kokkos::parallel_for(
+            "Cabana::SparseCellList::build::cells",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_cell ),
+            KOKKOS_LAMBDA( const int c ) {
+                auto cell_begin = cell_starts( c );
+                auto cell_end = ( c + 1 < num_cell ) ? cell_starts( c + 1 )
+                                                     : size_type( nparticles );
+                cell_keys( c ) = sorted_keys( cell_begin );
+                offsets( c ) = cell_begin;
+                counts( c ) = cell_end - cell_begin;
+            } );
+        exec_space.fence();
+
+        // Create the binning data.
+        _bin_data =
+            BinningData<MemorySpace>( begin, end, counts, offsets, permutes );
+
+        Kokkos::Profiling::popRegion();
+    }
+
+    /*!
+      \brief Build the cell list with a subset of particles.
+
+      \tparam SliceType Slice type for positions.
+
+      \param positions Slice of positions.
+      \param begin The beginning index of the slice range to sort.
+      \param end The end index of the slice range to sort.
+    */
+    template <class SliceType>
+    void build( SliceType positions, const std::size_t begin,
+                const std::size_t end )
+    {
+        // Use the default execution space.
+        build( execution_space{}, positions, begin, end );
+    }
+
+    /*!
+      \brief Build the cell list with all particles.
+
+      \tparam SliceType Slice type for positions.
+
+      \param positions Slice of positions.
+    */
+    template <class SliceType>
+    void build( SliceType positions )
+    {
+        build( positions, 0, positions.size() );
+    }
+
+  private:
+    BinningData<MemorySpace> _bin_data;
+    Impl::CartesianGrid<double> _grid;
+    KeyView _cell_keys;
+};
+
+//---------------------------------------------------------------------------//
+//! \cond Impl
+template <typename>
+struct is_sparse_cell_list_impl : public std::false_type
+{
+};
+
+template <typename MemorySpace>
+struct is_sparse_cell_list_impl<SparseCellList<MemorySpace>>
+    : public std::true_type
+{
+};
+//! \endcond
+
+//! SparseCellList static type checker.
+template <class T>
+struct is_sparse_cell_list
+    : public is_sparse_cell_list_impl<typename std::remove_cv<T>::type>::type
+{
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Given a sparse cell list permute an AoSoA.
+
+  \tparam ExecutionSpace Kokkos execution space.
+
+  \tparam CellListType The sparse cell list type.
+
+  \tparam AoSoA_t The AoSoA type.
+
+  \param exec_space The execution space instance to use.
+
+  \param cell_list The sparse cell list to permute the AoSoA with.
+
+  \param aosoa The AoSoA to permute.
+ */
+template <class ExecutionSpace, class CellListType, class AoSoA_t>
+void permute(
+    const ExecutionSpace& exec_space, const CellListType& cell_list,
+    AoSoA_t& aosoa,
+    typename std::enable_if<( is_sparse_cell_list<CellListType>::value &&
+                              is_aosoa<AoSoA_t>::value ),
+                            int>::type* = 0 )
+{
+    permute( exec_space, cell_list.binningData(), aosoa );
+}
+
+/*!
+  \brief Given a sparse cell list permute an AoSoA.
+
+  \tparam CellListType The sparse cell list type.
+
+  \tparam AoSoA_t The AoSoA type.
+
+  \param cell_list The sparse cell list to permute the AoSoA with.
+
+  \param aosoa The AoSoA to permute.
+ */
+template <class CellListType, class AoSoA_t>
+void permute(
+    const CellListType& cell_list, AoSoA_t& aosoa,
+    typename std::enable_if<( is_sparse_cell_list<CellListType>::value &&
+                              is_aosoa<AoSoA_t>::value ),
+                            int>::type* = 0 )
+{
+    permute( cell_list.binningData(), aosoa );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Given a sparse cell list permute a slice.
+
+  \tparam ExecutionSpace Kokkos execution space.
+
+  \tparam CellListType The sparse cell list type.
+
+  \tparam SliceType The slice type.
+
+  \param exec_space The execution space instance to use.
+
+  \param cell_list The sparse cell list to permute the slice with.
+
+  \param slice The slice to permute.
+ */
+template <class ExecutionSpace, class CellListType, class SliceType>
+void permute(
+    const ExecutionSpace& exec_space, const CellListType& cell_list,
+    SliceType& slice,
+    typename std::enable_if<( is_sparse_cell_list<CellListType>::value &&
+                              is_slice<SliceType>::value ),
+                            int>::type* = 0 )
+{
+    permute( exec_space, cell_list.binningData(), slice );
+}
+
+/*!
+  \brief Given a sparse cell list permute a slice.
+
+  \tparam CellListType The sparse cell list type.
+
+  \tparam SliceType The slice type.
+
+  \param cell_list The sparse cell list to permute the slice with.
+
+  \param slice The slice to permute.
+ */
+template <class CellListType, class SliceType>
+void permute(
+    const CellListType& cell_list, SliceType& slice,
+    typename std::enable_if<( is_sparse_cell_list<CellListType>::value &&
+                              is_slice<SliceType>::value ),
+                            int>::type* = 0 )
+{
+    permute( cell_list.binningData(), slice );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_SPARSECELLLIST_HPP
@@ -0,0 +1,994 @@
+/****************************************************************************
+ * Copyright (c) 2018-2023 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_TreeCode.hpp
+  \brief Barnes-Hut tree code for open boundary long-range interactions
+*/
+#ifndef CABANA_TREECODE_HPP
+#define CABANA_TREECODE_HPP
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_Halo.hpp>
+#include <Cabana_Slice.hpp>
+#include <Cabana_Sort.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace Cabana
+{
+namespace Experimental
+{
+namespace Impl
+{
+//! \cond Impl
+// Maximum depth of the tree. Morton codes use 21 bits per dimension.
+constexpr int tree_max_depth = 21;
+
+// Spread the lower 21 bits of an integer such that there are two zero bits
+// between each bit.
+KOKKOS_INLINE_FUNCTION std::uint64_t mortonExpandBits( std::uint64_t v )
+{
+    v &= 0x1fffff;
+    v = ( v | v << 32 ) & 0x1f00000000ffff;
+    v = ( v | v << 16 ) & 0x1f0000ff0000ff;
+    v = ( v | v << 8 ) & 0x100f00f00f00f00f;
+    v = ( v | v << 4 ) & 0x10c30c30c30c30c3;
+    v = ( v | v << 2 ) & 0x1249249249249249;
+    return v;
+}
+
+// Octant of a Morton code below a node at the given level.
+KOKKOS_INLINE_FUNCTION int mortonOctant( const std::uint64_t code,
+                                         const int level )
+{
+    return ( code >> ( 3 * ( tree_max_depth - 1 - level ) ) ) & 7;
+}
+
+// Find the first code in [begin,end) with an octant of at least the given
+// octant. Codes in a node are sorted so octants are non-decreasing.
+template <class CodeViewType>
+KOKKOS_INLINE_FUNCTION int mortonOctantBound( const CodeViewType& codes,
+                                              int begin, int end,
+                                              const int level,
+                                              const int octant )
+{
+    while ( begin < end )
+    {
+        int mid = begin + ( end - begin ) / 2;
+        if ( mortonOctant( codes( mid ), level ) < octant )
+            begin = mid + 1;
+        else
+            end = mid;
+    }
+    return begin;
+}
+
+// Add the field of a multipole expansion (charge, dipole, and raw second
+// moment about the expansion center) at separation r from the center.
+KOKKOS_INLINE_FUNCTION void multipoleField( const double r[3],
+                                            const double charge,
+                                            const double dipole[3],
+                                            const double second[6],
+                                            double e[3] )
+{
+    double r2 = r[0] * r[0] + r[1] * r[1] + r[2] * r[2];
+    double inv_r = 1.0 / Kokkos::sqrt( r2 );
+    double inv_r2 = inv_r * inv_r;
+    double inv_r3 = inv_r2 * inv_r;
+    double inv_r5 = inv_r3 * inv_r2;
+    double inv_r7 = inv_r5 * inv_r2;
+
+    // Traceless quadrupole.
+    double trace = second[0] + second[3] + second[5];
+    double quad[3][3] = {
+        { 3.0 * second[0] - trace, 3.0 * second[1], 3.0 * second[2] },
+        { 3.0 * second[1], 3.0 * second[3] - trace, 3.0 * second[4] },
+        { 3.0 * second[2], 3.0 * second[4], 3.0 * second[5] - trace } };
+
+    double d_dot_r = 0.0;
+    double quad_r[3];
+    double r_quad_r = 0.0;
+    for ( int a = 0; a < 3; ++a )
+    {
+        d_dot_r += dipole[a] * r[a];
+        quad_r[a] = 0.0;
+        for ( int b = 0; b < 3; ++b )
+            quad_r[a] += quad[a][b] * r[b];
+        r_quad_r += r[a] * quad_r[a];
+    }
+
+    for ( int a = 0; a < 3; ++a )
+        e[a] += charge * r[a] * inv_r3 + 3.0 * d_dot_r * r[a] * inv_r5 -
+                dipole[a] * inv_r3 - quad_r[a] * inv_r5 +
+                2.5 * r_quad_r * r[a] * inv_r7;
+}
+//! \endcond
+} // namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Barnes-Hut tree code for 1/r interactions with open boundaries.
+
+  The local particles are sorted along a Morton curve and an octree is built
+  over the sorted particles level by level. Charge, dipole, and quadrupole
+  moments of every node are computed bottom-up from the children. The field at
+  each particle is evaluated with the opening criterion size / distance <
+  theta.
+
+  In the distributed case every rank exports the locally essential tree for
+  each other rank: the coarsest nodes satisfying the opening criterion with
+  respect to the bounding box of the other rank, and the particles of leaves
+  that do not. These are exchanged with a Cabana::Halo and evaluated as
+  multipoles.
+
+  The force on particle i is coupling * q_i * sum_j q_j (x_i - x_j) / r^3,
+  e.g. coupling = -G with masses for gravity or the Coulomb constant with
+  charges for electrostatics.
+
+  \tparam MemorySpace Kokkos memory space in which the tree is stored.
+*/
+template <class MemorySpace>
+class TreeCode
+{
+  public:
+    //! Kokkos memory space.
+    using memory_space = MemorySpace;
+    static_assert( Kokkos::is_memory_space<MemorySpace>(),
+                   "TreeCode requires a Kokkos memory space" );
+    //! Default execution space.
+    using execution_space = typename memory_space::execution_space;
+
+    //! Multipole member types: center, charge, dipole, raw second moment.
+    using multipole_member_types =
+        MemberTypes<double[3], double, double[3], double[6]>;
+    //! Multipole container type.
+    using multipole_aosoa_type = AoSoA<multipole_member_types, memory_space>;
+
+    /*!
+      \brief Constructor.
+      \param comm The MPI communicator over which particles are distributed.
+      \param theta The opening angle. A node is accepted if its size divided by
+      the distance to its expansion center is less than theta. Zero gives the
+      direct sum.
+      \param leaf_size The maximum number of particles in a leaf.
+    */
+    TreeCode( MPI_Comm comm, const double theta, const int leaf_size = 8 )
+        : _comm( comm )
+        , _theta( theta )
+        , _leaf_size( leaf_size )
+        , _num_particle( 0 )
+        , _num_node( 0 )
+        , _num_remote( 0 )
+    {
+        if ( leaf_size < 1 )
+            throw std::runtime_error( "TreeCode leaf size must be positive" );
+    }
+
+    //! Get the number of local tree nodes.
+    int numNode() const { return _num_node; }
+
+    //! Get the number of tree levels.
+    int numLevel() const { return _level_offsets.size() - 1; }
+
+    //! Get the number of remote multipoles received from other ranks.
+    int numRemote() const { return _num_remote; }
+
+    /*!
+      \brief Build the local tree and exchange the locally essential trees.
+      \param exec_space The execution space instance.
+      \param positions Particle positions.
+      \param charges Particle charges (or masses).
+      \param num_particle The number of local particles.
+    */
+    template <class ExecutionSpace, class PositionSliceType,
+              class ChargeSliceType>
+    void build( const ExecutionSpace& exec_space,
+                const PositionSliceType& positions,
+                const ChargeSliceType& charges,
+                const std::size_t num_particle )
+    {
+        Kokkos::Profiling::pushRegion( "Cabana::TreeCode::build" );
+
+        _num_particle = num_particle;
+        sortParticles( exec_space, positions, charges );
+        buildNodes( exec_space );
+        computeLeafNodes( exec_space );
+        computeMoments( exec_space );
+        exchangeEssentialTrees( exec_space );
+
+        Kokkos::Profiling::popRegion();
+    }
+
+    /*!
+      \brief Add the tree forces to the particles used to build the tree.
+      \param exec_space The execution space instance.
+      \param forces Particle forces.
+      \param coupling The interaction coupling constant.
+    */
+    template <class ExecutionSpace, class ForceSliceType>
+    void computeForces( const ExecutionSpace& exec_space,
+                        const ForceSliceType& forces,
+                        const double coupling ) const
+    {
+        Kokkos::Profiling::pushRegion( "Cabana::TreeCode::computeForces" );
+
+        auto x = _x;
+        auto q = _q;
+        auto perm = _perm;
+        auto node_begin = _node_begin;
+        auto node_end = _node_end;
+        auto child_begin = _node_child_begin;
+        auto child_end = _node_child_end;
+        auto node_level = _node_level;
+        auto node_center = _node_center;
+        auto node_charge = _node_charge;
+        auto node_abs_charge = _node_abs_charge;
+        auto node_dipole = _node_dipole;
+        auto node_second = _node_second;
+        auto remote_center = slice<0>( _remote );
+        auto remote_charge = slice<1>( _remote );
+        auto remote_dipole = slice<2>( _remote );
+        auto remote_second = slice<3>( _remote );
+        int remote_begin = _remote.size() - _num_remote;
+        int remote_end = _remote.size();
+        double root_size = _root_size;
+        double theta2 = _theta * _theta;
+        bool has_tree = ( _num_node > 0 );
+
+        Kokkos::parallel_for(
+            "Cabana::TreeCode::computeForces",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                                 _num_particle ),
+            KOKKOS_LAMBDA( const int i ) {
+                double e[3] = { 0.0, 0.0, 0.0 };
+                double r[3];
+
+                // Traverse the local tree.
+                int stack[8 * ( Impl::tree_max_depth + 1 )];
+                int top = 0;
+                if ( has_tree )
+                    stack[top++] = 0;
+                while ( top > 0 )
+                {
+                    int n = stack[--top];
+                    if ( node_abs_charge( n ) == 0.0 )
+                        continue;
+
+                    double r2 = 0.0;
+                    for ( int d = 0; d < 3; ++d )
+                    {
+                        r[d] = x( i, d ) - node_center( n, d );
+                        r2 += r[d] * r[d];
+                    }
+                    double size = root_size / ( 1 << node_level( n ) );
+                    bool contains = node_begin( n ) <= i && i < node_end( n );
+
+                    // Accept the node as a multipole.
+                    if ( !contains && size * size < theta2 * r2 )
+                    {
+                        double dipole[3] = { node_dipole( n, 0 ),
+                                             node_dipole( n, 1 ),
+                                             node_dipole( n, 2 ) };
+                        double second[6];
+                        for ( int m = 0; m < 6; ++m )
+                            second[m] = node_second( n, m );
+                        Impl::multipoleField( r, node_charge( n ), dipole,
+                                              second, e );
+                    }
+
+                    // Direct sum over the particles of a leaf.
+                    else if ( child_begin( n ) == child_end( n ) )
+                    {
+                        for ( int j = node_begin( n ); j < node_end( n ); ++j )
+                        {
+                            if ( j == i )
+                                continue;
+                            double rj2 = 0.0;
+                            for ( int d = 0; d < 3; ++d )
+                            {
+                                r[d] = x( i, d ) - x( j, d );
+                                rj2 += r[d] * r[d];
+                            }
+                            double inv_r = 1.0 / Kokkos::sqrt( rj2 );
+                            double s = q( j ) * inv_r * inv_r * inv_r;
+                            for ( int d = 0; d < 3; ++d )
+                                e[d] += s * r[d];
+                        }
+                    }
+
+                    // Open the node.
+                    else
+                    {
+                        for ( int c = child_begin( n ); c < child_end( n );
+                              ++c )
+                            stack[top++] = c;
+                    }
+                }
+
+                // Add the remote locally essential trees.
+                for ( int m = remote_begin; m < remote_end; ++m )
+                {
+                    double dipole[3];
+                    double second[6];
+                    for ( int d = 0; d < 3; ++d )
+                    {
+                        r[d] = x( i, d ) - remote_center( m, d );
+                        dipole[d] = remote_dipole( m, d );
+                    }
+                    for ( int c = 0; c < 6; ++c )
+                        second[c] = remote_second( m, c );
+                    Impl::multipoleField( r, remote_charge( m ), dipole,
+                                          second, e );
+                }
+
+                int p = perm( i );
+                for ( int d = 0; d < 3; ++d )
+                    forces( p, d ) += coupling * q( i ) * e[d];
+            } );
+
+        Kokkos::Profiling::popRegion();
+    }
+
+  private:
+    // Sort the particles along a Morton curve over a cube enclosing them.
+    template <class ExecutionSpace, class PositionSliceType,
+              class ChargeSliceType>
+    void sortParticles( const ExecutionSpace& exec_space,
+                        const PositionSliceType& positions,
+                        const ChargeSliceType& charges )
+    {
+        int n = _num_particle;
+
+        // Compute the bounding box.
+        for ( int d = 0; d < 3; ++d )
+        {
+            Kokkos::MinMaxScalar<double> bounds;
+            Kokkos::parallel_reduce(
+                "Cabana::TreeCode::bounds",
+                Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, n ),
+                KOKKOS_LAMBDA( const int p,
+                               Kokkos::MinMaxScalar<double>& result ) {
+                    double v = positions( p, d );
+                    if ( v < result.min_val )
+                        result.min_val = v;
+                    if ( v > result.max_val )
+                        result.max_val = v;
+                },
+                Kokkos::MinMax<double>( bounds ) );
+            _box_lo[d] = ( n > 0 ) ? bounds.min_val : 0.0;
+            _box_hi[d] = ( n > 0 ) ? bounds.max_val : 0.0;
+        }
+
+        // The root cell is a cube slightly larger than the bounding box so
+        // every particle maps to a valid Morton code.
+        _root_size = 0.0;
+        for ( int d = 0; d < 3; ++d )
+            _root_size = Kokkos::max( _root_size, _box_hi[d] - _box_lo[d] );
+        _root_size = ( _root_size > 0.0 ) ? 1.0001 * _root_size : 1.0;
+
+        // Compute the Morton codes.
+        Kokkos::View<std::uint64_t*, memory_space> codes(
+            Kokkos::ViewAllocateWithoutInitializing( "tree_codes" ), n );
+        auto root_lo = _box_lo;
+        double inv_size = ( 1 << Impl::tree_max_depth ) / _root_size;
+        Kokkos::parallel_for(
+            "Cabana::TreeCode::mortonCodes",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, n ),
+            KOKKOS_LAMBDA( const int p ) {
+                std::uint64_t code = 0;
+                for ( int d = 0; d < 3; ++d )
+                {
+                    std::int64_t c =
+                        ( positions( p, d ) - root_lo[d] ) * inv_size;
+                    c = ( c < 0 ) ? 0 : c;
+                    c = ( c >= ( 1 << Impl::tree_max_depth ) )
+                            ? ( 1 << Impl::tree_max_depth ) - 1
+                            : c;
+                    code |= Impl::mortonExpandBits( c ) << ( 2 - d );
+                }
+                codes( p ) = code;
+            } );
+
+        // Sort the particles by code.
+        _perm = Kokkos::View<int*, memory_space>(
+            Kokkos::ViewAllocateWithoutInitializing( "tree_permutation" ), n );
+        auto perm = _perm;
+        if ( n > 1 )
+        {
+            exec_space.fence();
+            auto bin_data =
+                sortByKey<decltype( codes ), ExecutionSpace>( codes );
+            Kokkos::parallel_for(
+                "Cabana::TreeCode::permutation",
+                Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, n ),
+                KOKKOS_LAMBDA( const int p ) {
+                    perm( p ) = bin_data.permutation( p );
+                } );
+        }
+        else
+        {
+            Kokkos::deep_copy( exec_space, perm, 0 );
+        }
+
+        // Copy the sorted data.
+        _codes = Kokkos::View<std::uint64_t*, memory_space>(
+            Kokkos::ViewAllocateWithoutInitializing( "tree_sorted_codes" ),
+            n );
+        _x = Kokkos::View<double* [3], memory_space>(
+            Kokkos::ViewAllocateWithoutInitializing( "tree_positions" ), n );
+        _q = Kokkos::View<double*, memory_space>(
+            Kokkos::ViewAllocateWithoutInitializing( "tree_charges" ), n );
+        auto sorted_codes = _codes;
+        auto x = _x;
+        auto q = _q;
+        Kokkos::parallel_for(
+            "Cabana::TreeCode::copySorted",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, n ),
+            KOKKOS_LAMBDA( const int p ) {
+                int s = perm( p );
+                sorted_codes( p ) = codes( s );
+                for ( int d = 0; d < 3; ++d )
+                    x( p, d ) = positions( s, d );
+                q( p ) = charges( s );
+            } );
+    }
+
+    // Resize the node arrays preserving their contents.
+    void resizeNodes( const int num_node )
+    {
+        Kokkos::resize( _node_begin, num_node );
+        Kokkos::resize( _node_end, num_node );
+        Kokkos::resize( _node_child_begin, num_node );
+        Kokkos::resize( _node_child_end, num_node );
+        Kokkos::resize( _node_parent, num_node );
+        Kokkos::resize( _node_level, num_node );
+        Kokkos::resize( _node_cell_lo, num_node );
+    }
+
+    // Build the octree level by level over the sorted particles.
+    template <class ExecutionSpace>
+    void buildNodes( const ExecutionSpace& exec_space )
+    {
+        _level_offsets.assign( 1, 0 );
+        _num_node = 0;
+        if ( _num_particle == 0 )
+        {
+            resizeNodes( 0 );
+            return;
+        }
+
+        // Create the root.
+        resizeNodes( 1 );
+        _num_node = 1;
+        _level_offsets.push_back( 1 );
+        auto node_begin = _node_begin;
+        auto node_end = _node_end;
+        auto child_begin = _node_child_begin;
+        auto child_end = _node_child_end;
+        auto node_parent = _node_parent;
+        auto node_level = _node_level;
+        auto cell_lo = _node_cell_lo;
+        int num_particle = _num_particle;
+        auto root_lo = _box_lo;
+        Kokkos::parallel_for(
+            "Cabana::TreeCode::root",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, 1 ),
+            KOKKOS_LAMBDA( const int n ) {
+                node_begin( n ) = 0;
+                node_end( n ) = num_particle;
+                child_begin( n ) = 0;
+                child_end( n ) = 0;
+                node_parent( n ) = -1;
+                node_level( n ) = 0;
+                for ( int d = 0; d < 3; ++d )
+                    cell_lo( n, d ) = root_lo[d];
+            } );
+
+        // Refine every node with too many particles.
+        auto codes = _codes;
+        int leaf_size = _leaf_size;
+        double root_size = _root_size;
+        for ( int level = 0; level < Impl::tree_max_depth; ++level )
+        {
+            int level_begin = _level_offsets[level];
+            int num_parent = _level_offsets[level + 1] - level_begin;
+
+            // Count the children of each node in this level.
+            Kokkos::View<int*, memory_space> offsets(
+                Kokkos::ViewAllocateWithoutInitializing( "tree_offsets" ),
+                num_parent );
+            Kokkos::parallel_for(
+                "Cabana::TreeCode::countChildren",
+                Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                                     num_parent ),
+                KOKKOS_LAMBDA( const int p ) {
+                    int n = level_begin + p;
+                    int count = 0;
+                    if ( node_end( n ) - node_begin( n ) > leaf_size )
+                    {
+                        for ( int o = 0; o < 8; ++o )
+                        {
+                            int b = Impl::mortonOctantBound(
+                                codes, node_begin( n ), node_end( n ), level,
+                                o );
+                            int e = Impl::mortonOctantBound(
+                                codes, node_begin( n ), node_end( n ), level,
+                                o + 1 );
+                            if ( e > b )
+                                ++count;
+                        }
+                    }
+                    offsets( p ) = count;
+                } );
+            int num_child = 0;
+            Kokkos::parallel_scan(
+                "Cabana::TreeCode::childOffsets",
+                Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                                     num_parent ),
+                KOKKOS_LAMBDA( const int p, int& update, const bool final ) {
+                    int count = offsets( p );
+                    if ( final )
+                        offsets( p ) = update;
+                    update += count;
+                },
+                num_child );
+            if ( 0 == num_child )
+                break;
+
+            // Create the children.
+            int level_end = _level_offsets[level + 1];
+            resizeNodes( level_end + num_child );
+            node_begin = _node_begin;
+            node_end = _node_end;
+            child_begin = _node_child_begin;
+            child_end = _node_child_end;
+            node_parent = _node_parent;
+            node_level = _node_level;
+            cell_lo = _node_cell_lo;
+            double child_size = root_size / ( 1 << ( level + 1 ) );
+            Kokkos::parallel_for(
+                "Cabana::TreeCode::createChildren",
+                Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                                     num_parent ),
+                KOKKOS_LAMBDA( const int p ) {
+                    int n = level_begin + p;
+                    int c = level_end + offsets( p );
+                    child_begin( n ) = c;
+                    if ( node_end( n ) - node_begin( n ) > leaf_size )
+                    {
+                        for ( int o = 0; o < 8; ++o )
+                        {
+                            int b = Impl::mortonOctantBound(
+                                codes, node_begin( n ), node_end( n ), level,
+                                o );
+                            int e = Impl::mortonOctantBound(
+                                codes, node_begin( n ), node_end( n ), level,
+                                o + 1 );
+                            if ( e > b )
+                            {
+                                node_begin( c ) = b;
+                                node_end( c ) = e;
+                                child_begin( c ) = 0;
+                                child_end( c ) = 0;
+                                node_parent( c ) = n;
+                                node_level( c ) = level + 1;
+                                for ( int d = 0; d < 3; ++d )
+                                    cell_lo( c, d ) =
+                                        cell_lo( n, d ) +
+                                        ( ( o >> ( 2 - d ) ) & 1 ) *
+                                            child_size;
+                                ++c;
+                            }
+                        }
+                    }
+                    child_end( n ) = c;
+                } );
+            _num_node = level_end + num_child;
+            _level_offsets.push_back( _num_node );
+        }
+    }
+
+    // Compute the node moments from the leaves up.
+    template <class ExecutionSpace>
+    void computeMoments( const ExecutionSpace& exec_space )
+    {
+        _node_center = Kokkos::View<double* [3], memory_space>(
+            Kokkos::ViewAllocateWithoutInitializing( "tree_center" ),
+            _num_node );
+        _node_charge = Kokkos::View<double*, memory_space>(
+            Kokkos::ViewAllocateWithoutInitializing( "tree_charge" ),
+            _num_node );
+        _node_abs_charge = Kokkos::View<double*, memory_space>(
+            Kokkos::ViewAllocateWithoutInitializing( "tree_abs_charge" ),
+            _num_node );
+        _node_dipole = Kokkos::View<double* [3], memory_space>(
+            Kokkos::ViewAllocateWithoutInitializing( "tree_dipole" ),
+            _num_node );
+        _node_second = Kokkos::View<double* [6], memory_space>(
+            Kokkos::ViewAllocateWithoutInitializing( "tree_second" ),
+            _num_node );
+
+        for ( int level = numLevel() - 1; level >= 0; --level )
+            computeLevelMoments( exec_space, _level_offsets[level],
+                                 _level_offsets[level + 1] );
+    }
+
+    // Compute the moments of the nodes in one level. Leaves are computed from
+    // their particles and all other nodes from their children.
+    template <class ExecutionSpace>
+    void computeLevelMoments( const ExecutionSpace& exec_space,
+                              const int begin, const int end )
+    {
+        auto x = _x;
+        auto q = _q;
+        auto node_begin = _node_begin;
+        auto node_end = _node_end;
+        auto child_begin = _node_child_begin;
+        auto child_end = _node_child_end;
+        auto node_level = _node_level;
+        auto cell_lo = _node_cell_lo;
+        auto center = _node_center;
+        auto charge = _node_charge;
+        auto abs_charge = _node_abs_charge;
+        auto dipole = _node_dipole;
+        auto second = _node_second;
+        double root_size = _root_size;
+
+        Kokkos::parallel_for(
+            "Cabana::TreeCode::moments",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, begin, end ),
+            KOKKOS_LAMBDA( const int n ) {
+                bool leaf = ( child_begin( n ) == child_end( n ) );
+
+                // Expansion center weighted by the charge magnitude.
+                double a_sum = 0.0;
+                double q_sum = 0.0;
+                double c[3] = { 0.0, 0.0, 0.0 };
+                if ( leaf )
+                {
+                    for ( int j = node_begin( n ); j < node_end( n ); ++j )
+                    {
+                        double a = Kokkos::abs( q( j ) );
+                        a_sum += a;
+                        q_sum += q( j );
+                        for ( int d = 0; d < 3; ++d )
+                            c[d] += a * x( j, d );
+                    }
+                }
+                else
+                {
+                    for ( int m = child_begin( n ); m < child_end( n ); ++m )
+                    {
+                        a_sum += abs_charge( m );
+                        q_sum += charge( m );
+                        for ( int d = 0; d < 3; ++d )
+                            c[d] += abs_charge( m ) * center( m, d );
+                    }
+                }
+                double size = root_size / ( 1 << node_level( n ) );
+                for ( int d = 0; d < 3; ++d )
+                    c[d] = ( a_sum > 0.0 ) ? c[d] / a_sum
+                                           : cell_lo( n, d ) + 0.5 * size;
+
+                // Dipole and raw second moment about the center.
+                double dp[3] = { 0.0, 0.0, 0.0 };
+                double sm[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+                if ( leaf )
+                {
+                    for ( int j = node_begin( n ); j < node_end( n ); ++j )
+                    {
+                        double t[3];
+                        for ( int d = 0; d < 3; ++d )
+                        {
+                            t[d] = x( j, d ) - c[d];
+                            dp[d] += q( j ) * t[d];
+                        }
+                        sm[0] += q( j ) * t[0] * t[0];
+                        sm[1] += q( j ) * t[0] * t[1];
+                        sm[2] += q( j ) * t[0] * t[2];
+                        sm[3] += q( j ) * t[1] * t[1];
+                        sm[4] += q( j ) * t[1] * t[2];
+                        sm[5] += q( j ) * t[2] * t[2];
+                    }
+                }
+                else
+                {
+                    // Shift the child moments to the parent center.
+                    for ( int m = child_begin( n ); m < child_end( n ); ++m )
+                    {
+                        double t[3];
+                        double cd[3];
+                        for ( int d = 0; d < 3; ++d )
+                        {
+                            t[d] = center( m, d ) - c[d];
+                            cd[d] = dipole( m, d );
+                            dp[d] += cd[d] + charge( m ) * t[d];
+                        }
+                        int ab = 0;
+                        for ( int a = 0; a < 3; ++a )
+                            for ( int b = a; b < 3; ++b, ++ab )
+                                sm[ab] += second( m, ab ) + cd[a] * t[b] +
+                                          t[a] * cd[b] +
+                                          charge( m ) * t[a] * t[b];
+                    }
+                }
+
+                abs_charge( n ) = a_sum;
+                charge( n ) = q_sum;
+                for ( int d = 0; d < 3; ++d )
+                {
+                    center( n, d ) = c[d];
+                    dipole( n, d ) = dp[d];
+                }
+                for ( int m = 0; m < 6; ++m )
+                    second( n, m ) = sm[m];
+            } );
+    }
+
+    // Send every other rank the part of the local tree it needs.
+    template <class ExecutionSpace>
+    void exchangeEssentialTrees( const ExecutionSpace& exec_space )
+    {
+        int comm_rank;
+        int comm_size;
+        MPI_Comm_rank( _comm, &comm_rank );
+        MPI_Comm_size( _comm, &comm_size );
+
+        // Gather the bounding box of every rank.
+        std::vector<double> local_box( 7 );
+        for ( int d = 0; d < 3; ++d )
+        {
+            local_box[d] = _box_lo[d];
+            local_box[3 + d] = _box_hi[d];
+        }
+        local_box[6] = _num_particle;
+        std::vector<double> boxes( 7 * comm_size );
+        MPI_Allgather( local_box.data(), 7, MPI_DOUBLE, boxes.data(), 7,
+                       MPI_DOUBLE, _comm );
+
+        // Fill the local sources: every node followed by every particle.
+        int num_node = _num_node;
+        int num_source = num_node + _num_particle;
+        _remote = multipole_aosoa_type( "tree_sources", num_source );
+        auto source_center = slice<0>( _remote );
+        auto source_charge = slice<1>( _remote );
+        auto source_dipole = slice<2>( _remote );
+        auto source_second = slice<3>( _remote );
+        auto x = _x;
+        auto q = _q;
+        auto center = _node_center;
+        auto charge = _node_charge;
+        auto dipole = _node_dipole;
+        auto second = _node_second;
+        Kokkos::parallel_for(
+            "Cabana::TreeCode::fillSources",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_source ),
+            KOKKOS_LAMBDA( const int s ) {
+                bool is_node = s < num_node;
+                int j = s - num_node;
+                for ( int d = 0; d < 3; ++d )
+                {
+                    source_center( s, d ) =
+                        is_node ? center( s, d ) : x( j, d );
+                    source_dipole( s, d ) = is_node ? dipole( s, d ) : 0.0;
+                }
+                source_charge( s ) = is_node ? charge( s ) : q( j );
+                for ( int m = 0; m < 6; ++m )
+                    source_second( s, m ) = is_node ? second( s, m ) : 0.0;
+            } );
+
+        // Count the exports to every other rank.
+        std::vector<int> export_counts( comm_size, 0 );
+        int num_export = 0;
+        for ( int r = 0; r < comm_size; ++r )
+        {
+            if ( r != comm_rank && boxes[7 * r + 6] > 0 )
+            {
+                auto is_export = essentialPredicate( boxes.data() + 7 * r );
+                int count = 0;
+                Kokkos::parallel_reduce(
+                    "Cabana::TreeCode::countExports",
+                    Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                                         num_source ),
+                    KOKKOS_LAMBDA( const int s, int& result ) {
+                        if ( is_export( s ) )
+                            ++result;
+                    },
+                    count );
+                export_counts[r] = count;
+                num_export += count;
+            }
+        }
+
+        // Fill the exports.
+        Kokkos::View<int*, memory_space> export_ids(
+            Kokkos::ViewAllocateWithoutInitializing( "tree_export_ids" ),
+            num_export );
+        Kokkos::View<int*, memory_space> export_ranks(
+            Kokkos::ViewAllocateWithoutInitializing( "tree_export_ranks" ),
+            num_export );
+        int offset = 0;
+        for ( int r = 0; r < comm_size; ++r )
+        {
+            if ( export_counts[r] > 0 )
+            {
+                auto is_export = essentialPredicate( boxes.data() + 7 * r );
+                Kokkos::parallel_scan(
+                    "Cabana::TreeCode::fillExports",
+                    Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                                         num_source ),
+                    KOKKOS_LAMBDA( const int s, int& update,
+                                   const bool final ) {
+                        if ( is_export( s ) )
+                        {
+                            if ( final )
+                            {
+                                export_ids( offset + update ) = s;
+                                export_ranks( offset + update ) = r;
+                            }
+                            ++update;
+                        }
+                    } );
+                offset += export_counts[r];
+            }
+        }
+        exec_space.fence();
+
+        // Gather the remote trees.
+        Halo<memory_space> halo( _comm, num_source, export_ids,
+                                 export_ranks );
+        _remote.resize( halo.numLocal() + halo.numGhost() );
+        gather( exec_space, halo, _remote );
+        _num_remote = halo.numGhost();
+    }
+
+    // Predicate selecting the locally essential sources for a remote box.
+    struct EssentialPredicate
+    {
+        Kokkos::View<int*, memory_space> node_parent;
+        Kokkos::View<int*, memory_space> node_level;
+        Kokkos::View<double* [3], memory_space> cell_lo;
+        Kokkos::View<int*, memory_space> leaf_node;
+        Kokkos::Array<double, 3> box_lo;
+        Kokkos::Array<double, 3> box_hi;
+        double root_size;
+        double theta2;
+        int num_node;
+
+        // Accept a node if it is far enough from every point in the box.
+        KOKKOS_INLINE_FUNCTION bool accept( const int n ) const
+        {
+            double size = root_size / ( 1 << node_level( n ) );
+            double dist2 = 0.0;
+            for ( int d = 0; d < 3; ++d )
+            {
+                double gap = Kokkos::max( box_lo[d] - cell_lo( n, d ) - size,
+                                          cell_lo( n, d ) - box_hi[d] );
+                if ( gap > 0.0 )
+                    dist2 += gap * gap;
+            }
+            return size * size < theta2 * dist2;
+        }
+
+        KOKKOS_INLINE_FUNCTION bool operator()( const int s ) const
+        {
+            // Export the coarsest accepted nodes.
+            if ( s < num_node )
+                return accept( s ) &&
+                       ( node_parent( s ) < 0 || !accept( node_parent( s ) ) );
+
+            // Export the particles of leaves which are not accepted.
+            return !accept( leaf_node( s - num_node ) );
+        }
+    };
+
+    // Create the essential source predicate for a remote bounding box.
+    EssentialPredicate essentialPredicate( const double* box )
+    {
+        EssentialPredicate predicate;
+        predicate.node_parent = _node_parent;
+        predicate.node_level = _node_level;
+        predicate.cell_lo = _node_cell_lo;
+        predicate.leaf_node = _leaf_node;
+        for ( int d = 0; d < 3; ++d )
+        {
+            predicate.box_lo[d] = box[d];
+            predicate.box_hi[d] = box[3 + d];
+        }
+        predicate.root_size = _root_size;
+        predicate.theta2 = _theta * _theta;
+        predicate.num_node = _num_node;
+        return predicate;
+    }
+
+    // Compute the leaf node of every sorted particle.
+    template <class ExecutionSpace>
+    void computeLeafNodes( const ExecutionSpace& exec_space )
+    {
+        _leaf_node = Kokkos::View<int*, memory_space>(
+            Kokkos::ViewAllocateWithoutInitializing( "tree_leaf_node" ),
+            _num_particle );
+        auto leaf_node = _leaf_node;
+        auto node_begin = _node_begin;
+        auto node_end = _node_end;
+        auto child_begin = _node_child_begin;
+        auto child_end = _node_child_end;
+        Kokkos::parallel_for(
+            "Cabana::TreeCode::leafNodes",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, _num_node ),
+            KOKKOS_LAMBDA( const int n ) {
+                if ( child_begin( n ) == child_end( n ) )
+                    for ( int j = node_begin( n ); j < node_end( n ); ++j )
+                        leaf_node( j ) = n;
+            } );
+    }
+
+    MPI_Comm _comm;
+    double _theta;
+    int _leaf_size;
+    std::size_t _num_particle;
+    int _num_node;
+    int _num_remote;
+    Kokkos::Array<double, 3> _box_lo;
+    Kokkos::Array<double, 3> _box_hi;
+    double _root_size;
+    std::vector<int> _level_offsets;
+
+    Kokkos::View<int*, memory_space> _perm;
+    Kokkos::View<std::uint64_t*, memory_space> _codes;
+    Kokkos::View<double* [3], memory_space> _x;
+    Kokkos::View<double*, memory_space> _q;
+    Kokkos::View<int*, memory_space> _leaf_node;
+
+    Kokkos::View<int*, memory_space> _node_begin;
+    Kokkos::View<int*, memory_space> _node_end;
+    Kokkos::View<int*, memory_space> _node_child_begin;
+    Kokkos::View<int*, memory_space> _node_child_end;
+    Kokkos::View<int*, memory_space> _node_parent;
+    Kokkos::View<int*, memory_space> _node_level;
+    Kokkos::View<double* [3], memory_space> _node_cell_lo;
+    Kokkos::View<double* [3], memory_space> _node_center;
+    Kokkos::View<double*, memory_space> _node_charge;
+    Kokkos::View<double*, memory_space> _node_abs_charge;
+    Kokkos::View<double* [3], memory_space> _node_dipole;
+    Kokkos::View<double* [6], memory_space> _node_second;
+
+    multipole_aosoa_type _remote;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a tree code.
+  \param comm The MPI communicator over which particles are distributed.
+  \param theta The opening angle.
+  \param leaf_size The maximum number of particles in a leaf.
+  \return Shared pointer to a TreeCode.
+*/
+template <class MemorySpace>
+auto createTreeCode( MPI_Comm comm, const double theta,
+                     const int leaf_size = 8 )
+{
+    return std::make_shared<TreeCode<MemorySpace>>( comm, theta, leaf_size );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Experimental
+} // end namespace Cabana
+
+#endif // end CABANA_TREECODE_HPP
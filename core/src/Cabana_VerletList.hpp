@@ -19,11 +19,16 @@
 #include <Cabana_LinkedCellList.hpp>
 #include <Cabana_NeighborList.hpp>
 #include <Cabana_Parallel.hpp>
+#include <Cabana_SparseCellList.hpp>
 #include <impl/Cabana_CartesianGrid.hpp>
+#include <impl/Cabana_Index.hpp>
+#include <impl/Cabana_PerformanceTraits.hpp>
 
 #include <Kokkos_Core.hpp>
 
+#include <array>
 #include <cassert>
+#include <string>
 
 namespace Cabana
 {
@@ -40,6 +45,18 @@ struct VerletLayout2D
 {
 };
 
+/*!
+  \brief Blocked 2D array neighbor list layout.
+
+  Neighbors are stored AoSoA-style as (particle block, neighbor, lane) with
+  blocks of the preferred vector length of the memory space, such that the
+  n-th neighbor of a whole vector of particles is contiguous. This matches
+  the (struct, array) indexing of simd_parallel_for.
+*/
+struct VerletLayoutAoSoA
+{
+};
+
 //---------------------------------------------------------------------------//
 // Verlet List Data.
 //---------------------------------------------------------------------------//
@@ -76,6 +93,23 @@ struct VerletListData<MemorySpace, VerletLayoutCSR>
     {
         neighbors( offsets( pid ) + nid ) = new_id;
     }
+
+    //! Get a neighbor in the list.
+    KOKKOS_INLINE_FUNCTION
+    int getNeighbor( const int pid, const int nid ) const
+    {
+        return neighbors( offsets( pid ) + nid );
+    }
+
+    //! Get the pair index of a neighbor in the list.
+    KOKKOS_INLINE_FUNCTION
+    std::size_t pairIndex( const int pid, const int nid ) const
+    {
+        return offsets( pid ) + nid;
+    }
+
+    //! Get the number of pair entries in the list.
+    std::size_t numPair() const { return neighbors.extent( 0 ); }
 };
 
 //! Store the VerletList 2D neighbor data.
@@ -106,6 +140,160 @@ struct VerletListData<MemorySpace, VerletLayout2D>
     {
         neighbors( pid, nid ) = new_id;
     }
+
+    //! Get a neighbor in the list.
+    KOKKOS_INLINE_FUNCTION
+    int getNeighbor( const int pid, const int nid ) const
+    {
+        return neighbors( pid, nid );
+    }
+
+    //! Get the pair index of a neighbor in the list.
+    KOKKOS_INLINE_FUNCTION
+    std::size_t pairIndex( const int pid, const int nid ) const
+    {
+        return pid * neighbors.extent( 1 ) + nid;
+    }
+
+    //! Get the number of pair entries in the list.
+    std::size_t numPair() const
+    {
+        return neighbors.extent( 0 ) * neighbors.extent( 1 );
+    }
+};
+
+//! Store the VerletList blocked 2D neighbor data.
+template <class MemorySpace>
+struct VerletListData<MemorySpace, VerletLayoutAoSoA>
+{
+    //! Kokkos memory space.
+    using memory_space = MemorySpace;
+
+    //! Number of particles in a neighbor block.
+    static constexpr int vector_length = Impl::PerformanceTraits<
+        typename memory_space::execution_space>::vector_length;
+
+    //! Particle index type.
+    using index_type = Impl::Index<vector_length>;
+
+    //! Number of neighbors per particle.
+    Kokkos::View<int*, memory_space> counts;
+
+    //! Neighbor list indexed as (particle block, neighbor, lane).
+    Kokkos::View<int***, Kokkos::LayoutRight, memory_space> neighbors;
+
+    //! Add a neighbor to the list.
+    KOKKOS_INLINE_FUNCTION
+    void addNeighbor( const int pid, const int nid ) const
+    {
+        std::size_t count = Kokkos::atomic_fetch_add( &counts( pid ), 1 );
+        if ( count < neighbors.extent( 1 ) )
+            neighbors( index_type::s( pid ), count, index_type::a( pid ) ) =
+                nid;
+    }
+
+    //! Modify a neighbor in the list.
+    KOKKOS_INLINE_FUNCTION
+    void setNeighbor( const int pid, const int nid, const int new_id ) const
+    {
+        neighbors( index_type::s( pid ), nid, index_type::a( pid ) ) = new_id;
+    }
+
+    //! Get a neighbor in the list.
+    KOKKOS_INLINE_FUNCTION
+    int getNeighbor( const int pid, const int nid ) const
+    {
+        return neighbors( index_type::s( pid ), nid, index_type::a( pid ) );
+    }
+
+    //! Get the pair index of a neighbor in the list.
+    KOKKOS_INLINE_FUNCTION
+    std::size_t pairIndex( const int pid, const int nid ) const
+    {
+        return ( index_type::s( pid ) * neighbors.extent( 1 ) + nid ) *
+                   vector_length +
+               index_type::a( pid );
+    }
+
+    //! Get the number of pair entries in the list.
+    std::size_t numPair() const
+    {
+        return neighbors.extent( 0 ) * neighbors.extent( 1 ) *
+               neighbors.extent( 2 );
+    }
+};
+
+//---------------------------------------------------------------------------//
+// Verlet List Pair Data.
+//---------------------------------------------------------------------------//
+/*!
+  \brief Per-pair values stored alongside the VerletList neighbor data.
+
+  Values are stored as structure-of-arrays: value v of every pair is
+  contiguous in memory. Pair entries are indexed by
+  VerletListData::pairIndex() so the layout matches the neighbor list.
+
+  \tparam MemorySpace The Kokkos memory space for storing the pair data.
+  \tparam NumValue The number of values stored per pair.
+*/
+template <class MemorySpace, int NumValue>
+struct VerletPairData
+{
+    //! Kokkos memory space.
+    using memory_space = MemorySpace;
+
+    //! Number of values per pair.
+    static constexpr int num_value = NumValue;
+
+    //! Values of a single pair.
+    using pair_type = Kokkos::Array<double, NumValue>;
+
+    //! Pair values.
+    Kokkos::View<double**, Kokkos::LayoutLeft, memory_space> values;
+
+    //! Get the values of a pair.
+    KOKKOS_INLINE_FUNCTION
+    pair_type get( const std::size_t pair ) const
+    {
+        pair_type v;
+        for ( int n = 0; n < NumValue; ++n )
+            v[n] = values( pair, n );
+        return v;
+    }
+
+    //! Set the values of a pair.
+    KOKKOS_INLINE_FUNCTION
+    void set( const std::size_t pair, const pair_type& v ) const
+    {
+        for ( int n = 0; n < NumValue; ++n )
+            values( pair, n ) = v[n];
+    }
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Pair functor computing the pair geometry (dx, dy, dz, r) with
+  dx = x_i - x_j.
+*/
+template <class PositionSlice>
+struct VerletPairGeometry
+{
+    //! Number of values per pair.
+    static constexpr int num_value = 4;
+
+    //! Particle positions.
+    PositionSlice x;
+
+    //! Compute the pair values of particle i and neighbor j.
+    KOKKOS_INLINE_FUNCTION
+    void operator()( const int i, const int j,
+                     Kokkos::Array<double, num_value>& v ) const
+    {
+        v[0] = x( i, 0 ) - x( j, 0 );
+        v[1] = x( i, 1 ) - x( j, 1 );
+        v[2] = x( i, 2 ) - x( j, 2 );
+        v[3] = Kokkos::sqrt( v[0] * v[0] + v[1] * v[1] + v[2] * v[2] );
+    }
 };
 
 //---------------------------------------------------------------------------//
@@ -208,6 +396,31 @@ struct LinkedCellStencil
     }
 };
 
+//---------------------------------------------------------------------------//
+// Allocate 2D neighbor storage for a maximum number of neighbors.
+template <class MemorySpace>
+void allocateNeighbors( VerletListData<MemorySpace, VerletLayout2D>& data,
+                        const std::size_t max_neigh )
+{
+    data.neighbors = Kokkos::View<int**, MemorySpace>(
+        Kokkos::ViewAllocateWithoutInitializing( "neighbors" ),
+        data.counts.size(), max_neigh );
+}
+
+// Allocate blocked 2D neighbor storage for a maximum number of neighbors.
+template <class MemorySpace>
+void allocateNeighbors( VerletListData<MemorySpace, VerletLayoutAoSoA>& data,
+                        const std::size_t max_neigh )
+{
+    using data_type = VerletListData<MemorySpace, VerletLayoutAoSoA>;
+    std::size_t num_block =
+        ( data.counts.size() + data_type::vector_length - 1 ) /
+        data_type::vector_length;
+    data.neighbors = Kokkos::View<int***, Kokkos::LayoutRight, MemorySpace>(
+        Kokkos::ViewAllocateWithoutInitializing( "neighbors" ), num_block,
+        max_neigh, data_type::vector_length );
+}
+
 //---------------------------------------------------------------------------//
 // Verlet List Builder
 //---------------------------------------------------------------------------//
@@ -248,8 +461,8 @@ struct VerletListBuilder
     std::size_t max_n;
 
     // Constructor.
-    VerletListBuilder( PositionSlice slice, const std::size_t begin,
-                       const std::size_t end,
+    VerletListBuilder( execution_space exec_space, PositionSlice slice,
+                       const std::size_t begin, const std::size_t end,
                        const PositionValueType neighborhood_radius,
                        const PositionValueType cell_size_ratio,
                        const PositionValueType grid_min[3],
@@ -280,8 +493,8 @@ struct VerletListBuilder
         // treated as candidates for neighbors.
         double grid_size = cell_size_ratio * neighborhood_radius;
         PositionValueType grid_delta[3] = { grid_size, grid_size, grid_size };
-        linked_cell_list = LinkedCellList<memory_space>( position, grid_delta,
-                                                         grid_min, grid_max );
+        linked_cell_list = LinkedCellList<memory_space>(
+            exec_space, position, grid_delta, grid_min, grid_max );
         bin_data_1d = linked_cell_list.binningData();
 
         // We will use the square of the distance for neighbor determination.
@@ -436,19 +649,17 @@ struct VerletListBuilder
 
     void initCounts( VerletLayoutCSR ) {}
 
-    void initCounts( VerletLayout2D )
+    template <class DenseLayoutTag>
+    void initCounts( DenseLayoutTag )
     {
         if ( max_n > 0 )
         {
             count = false;
-
-            _data.neighbors = Kokkos::View<int**, memory_space>(
-                Kokkos::ViewAllocateWithoutInitializing( "neighbors" ),
-                _data.counts.size(), max_n );
+            allocateNeighbors( _data, max_n );
         }
     }
 
-    void processCounts( VerletLayoutCSR )
+    void processCounts( execution_space exec_space, VerletLayoutCSR )
     {
         // Allocate offsets.
         _data.offsets = Kokkos::View<int*, memory_space>(
@@ -461,10 +672,9 @@ struct VerletListBuilder
         offset_op.offsets = _data.offsets;
         int total_num_neighbor;
         Kokkos::RangePolicy<execution_space> range_policy(
-            0, _data.counts.extent( 0 ) );
+            exec_space, 0, _data.counts.extent( 0 ) );
         Kokkos::parallel_scan( "Cabana::VerletListBuilder::offset_scan",
                                range_policy, offset_op, total_num_neighbor );
-        Kokkos::fence();
 
         // Allocate the neighbor list.
         _data.neighbors = Kokkos::View<int*, memory_space>(
@@ -472,12 +682,13 @@ struct VerletListBuilder
             total_num_neighbor );
 
         // Reset the counts. We count again when we fill.
-        Kokkos::deep_copy( _data.counts, 0 );
+        Kokkos::deep_copy( exec_space, _data.counts, 0 );
     }
 
     // Process 2D counts by computing the maximum number of neighbors and
     // reallocating the 2D data structure if needed.
-    void processCounts( VerletLayout2D )
+    template <class DenseLayoutTag>
+    void processCounts( execution_space exec_space, DenseLayoutTag )
     {
         // Calculate the maximum number of neighbors.
         auto counts = _data.counts;
@@ -485,23 +696,21 @@ struct VerletListBuilder
         Kokkos::Max<int> max_reduce( max_num_neighbor );
         Kokkos::parallel_reduce(
             "Cabana::VerletListBuilder::reduce_max",
-            Kokkos::RangePolicy<execution_space>( 0, _data.counts.size() ),
+            Kokkos::RangePolicy<execution_space>( exec_space, 0,
+                                                  _data.counts.size() ),
             KOKKOS_LAMBDA( const int i, int& value ) {
                 if ( counts( i ) > value )
                     value = counts( i );
             },
             max_reduce );
-        Kokkos::fence();
 
         // Reallocate the neighbor list if previous size is exceeded.
         if ( count or ( std::size_t )
                               max_num_neighbor > _data.neighbors.extent( 1 ) )
         {
             refill = true;
-            Kokkos::deep_copy( _data.counts, 0 );
-            _data.neighbors = Kokkos::View<int**, memory_space>(
-                Kokkos::ViewAllocateWithoutInitializing( "neighbors" ),
-                _data.counts.size(), max_num_neighbor );
+            Kokkos::deep_copy( exec_space, _data.counts, 0 );
+            allocateNeighbors( _data, max_num_neighbor );
         }
     }
 
@@ -628,6 +837,153 @@ struct VerletListBuilder
     }
 };
 
+//---------------------------------------------------------------------------//
+// Per-particle neighbor search fill. The search functor holds the list data
+// and a count flag: when counting it only increments the neighbor counts.
+//---------------------------------------------------------------------------//
+// Count the neighbors, compute the offsets, and fill the CSR list.
+template <class ExecutionSpace, class SearchType>
+void fillNeighbors( ExecutionSpace exec_space,
+                    const Kokkos::RangePolicy<ExecutionSpace>& policy,
+                    SearchType& search, const std::size_t, VerletLayoutCSR )
+{
+    using memory_space = typename SearchType::memory_space;
+
+    search.count = true;
+    Kokkos::parallel_for( "Cabana::NeighborSearch::count_neighbors", policy,
+                          search );
+
+    auto counts = search.data.counts;
+    search.data.offsets = Kokkos::View<int*, memory_space>(
+        Kokkos::ViewAllocateWithoutInitializing( "neighbor_offsets" ),
+        counts.size() );
+    auto offsets = search.data.offsets;
+    int total_num_neighbor = 0;
+    Kokkos::parallel_scan(
+        "Cabana::NeighborSearch::offset_scan",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, counts.size() ),
+        KOKKOS_LAMBDA( const int i, int& update, const bool final_pass ) {
+            if ( final_pass )
+                offsets( i ) = update;
+            update += counts( i );
+        },
+        total_num_neighbor );
+
+    search.data.neighbors = Kokkos::View<int*, memory_space>(
+        Kokkos::ViewAllocateWithoutInitializing( "neighbors" ),
+        total_num_neighbor );
+    Kokkos::deep_copy( exec_space, counts, 0 );
+
+    search.count = false;
+    Kokkos::parallel_for( "Cabana::NeighborSearch::fill_neighbors", policy,
+                          search );
+    exec_space.fence();
+}
+
+// Fill the 2D list with a guess for the maximum number of neighbors and
+// refill it if the guess was exceeded.
+template <class ExecutionSpace, class SearchType, class DenseLayoutTag>
+void fillNeighbors( ExecutionSpace exec_space,
+                    const Kokkos::RangePolicy<ExecutionSpace>& policy,
+                    SearchType& search, const std::size_t max_neigh,
+                    DenseLayoutTag )
+{
+    search.count = false;
+    allocateNeighbors( search.data, max_neigh );
+    Kokkos::parallel_for( "Cabana::NeighborSearch::fill_neighbors", policy,
+                          search );
+
+    auto counts = search.data.counts;
+    int max_num_neighbor = 0;
+    Kokkos::parallel_reduce(
+        "Cabana::NeighborSearch::reduce_max", policy,
+        KOKKOS_LAMBDA( const int i, int& value ) {
+            if ( counts( i ) > value )
+                value = counts( i );
+        },
+        Kokkos::Max<int>( max_num_neighbor ) );
+
+    if ( static_cast<std::size_t>( max_num_neighbor ) >
+         search.data.neighbors.extent( 1 ) )
+    {
+        Kokkos::deep_copy( exec_space, counts, 0 );
+        allocateNeighbors( search.data, max_num_neighbor );
+        Kokkos::parallel_for( "Cabana::NeighborSearch::fill_neighbors",
+                              policy, search );
+    }
+    exec_space.fence();
+}
+
+//---------------------------------------------------------------------------//
+// Search the occupied cells of a sparse cell list for the neighbors of each
+// particle. Empty cells of the stencil are skipped with a key lookup.
+template <class MemorySpace, class AlgorithmTag, class LayoutTag,
+          class PositionSlice>
+struct SparseVerletListSearch
+{
+    using memory_space = MemorySpace;
+
+    VerletListData<MemorySpace, LayoutTag> data;
+    SparseCellList<MemorySpace> cells;
+    BinningData<MemorySpace> bins;
+    typename PositionSlice::random_access_slice position;
+    double rsqr;
+    Kokkos::Array<int, 3> range;
+    Kokkos::Array<int, 3> num_bin;
+    bool count;
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()( const int pid ) const
+    {
+        double xp[3] = { position( pid, 0 ), position( pid, 1 ),
+                         position( pid, 2 ) };
+
+        int ijk[3];
+        cells.locatePoint( xp[0], xp[1], xp[2], ijk[0], ijk[1], ijk[2] );
+        int lo[3];
+        int hi[3];
+        for ( int d = 0; d < 3; ++d )
+        {
+            lo[d] = Kokkos::max( ijk[d] - range[d], 0 );
+            hi[d] = Kokkos::min( ijk[d] + range[d], num_bin[d] - 1 );
+        }
+
+        for ( int i = lo[0]; i <= hi[0]; ++i )
+            for ( int j = lo[1]; j <= hi[1]; ++j )
+                for ( int k = lo[2]; k <= hi[2]; ++k )
+                {
+                    int bin = cells.findBin( i, j, k );
+                    if ( bin < 0 )
+                        continue;
+
+                    auto offset = bins.binOffset( bin );
+                    int size = bins.binSize( bin );
+                    for ( int b = 0; b < size; ++b )
+                    {
+                        int nid = bins.permutation( offset + b );
+                        double xn[3] = { position( nid, 0 ),
+                                         position( nid, 1 ),
+                                         position( nid, 2 ) };
+                        if ( !NeighborDiscriminator<AlgorithmTag>::isValid(
+                                 pid, xp[0], xp[1], xp[2], nid, xn[0], xn[1],
+                                 xn[2] ) )
+                            continue;
+
+                        double r2 = 0.0;
+                        for ( int d = 0; d < 3; ++d )
+                            r2 += ( xp[d] - xn[d] ) * ( xp[d] - xn[d] );
+                        if ( r2 <= rsqr )
+                        {
+                            if ( count )
+                                ++data.counts( pid );
+                            else
+                                data.addNeighbor( pid, nid );
+                        }
+                    }
+                }
+    }
+};
+
 //---------------------------------------------------------------------------//
 
 //! \endcond
@@ -643,7 +999,8 @@ struct VerletListBuilder
   \tparam AlgorithmTag Tag indicating whether to build a full or half neighbor
   list.
 
-  \tparam LayoutTag Tag indicating whether to use a CSR or 2D data layout.
+  \tparam LayoutTag Tag indicating whether to use a CSR, 2D, or blocked 2D
+  (AoSoA) data layout.
 
   \tparam BuildTag Tag indicating whether to use hierarchical team or team
   vector parallelism when building neighbor lists.
@@ -720,6 +1077,65 @@ class VerletList
                grid_max, max_neigh );
     }
 
+    /*!
+      \brief VerletList constructor. Given a list of particle positions and
+      a neighborhood radius calculate the neighbor list, pre-allocating 2D
+      layouts from the neighbor statistics of a previous list.
+
+      \param x The slice containing the particle positions
+      \param begin The beginning particle index to compute neighbors for.
+      \param end The end particle index to compute neighbors for.
+      \param neighborhood_radius The radius of the neighborhood.
+      \param cell_size_ratio The ratio of the cell size in the Cartesian grid
+      to the neighborhood radius.
+      \param grid_min The minimum value of the grid containing the particles
+      in each dimension.
+      \param grid_max The maximum value of the grid containing the particles
+      in each dimension.
+      \param stats Neighbor statistics used to pick the maximum number of
+      neighbors per particle.
+      \param headroom Relative extra capacity added to the maximum number of
+      neighbors in the statistics.
+    */
+    template <class PositionSlice>
+    VerletList( PositionSlice x, const std::size_t begin, const std::size_t end,
+                const typename PositionSlice::value_type neighborhood_radius,
+                const typename PositionSlice::value_type cell_size_ratio,
+                const typename PositionSlice::value_type grid_min[3],
+                const typename PositionSlice::value_type grid_max[3],
+                const NeighborStatistics& stats, const double headroom = 0.0,
+                typename std::enable_if<( is_slice<PositionSlice>::value ),
+                                        int>::type* = 0 )
+    {
+        build( x, begin, end, neighborhood_radius, cell_size_ratio, grid_min,
+               grid_max, stats.suggestedMaxNeighbor( headroom ) );
+    }
+
+    /*!
+      \brief VerletList constructor. Given particles binned in a sparse cell
+      list and a neighborhood radius calculate the neighbor list.
+
+      \param cell_list The sparse cell list binning the candidate neighbors.
+      \param x The slice containing the particle positions used to build the
+      cell list.
+      \param begin The beginning particle index to compute neighbors for.
+      \param end The end particle index to compute neighbors for.
+      \param neighborhood_radius The radius of the neighborhood.
+      \param max_neigh Optional maximum number of neighbors per particle to
+      pre-allocate the neighbor list. Potentially avoids recounting with 2D
+      layouts only.
+    */
+    template <class PositionSlice>
+    VerletList( const SparseCellList<memory_space>& cell_list, PositionSlice x,
+                const std::size_t begin, const std::size_t end,
+                const typename PositionSlice::value_type neighborhood_radius,
+                const std::size_t max_neigh = 0,
+                typename std::enable_if<( is_slice<PositionSlice>::value ),
+                                        int>::type* = 0 )
+    {
+        build( cell_list, x, begin, end, neighborhood_radius, max_neigh );
+    }
+
     /*!
       \brief Given a list of particle positions and a neighborhood radius
       calculate the neighbor list.
@@ -741,8 +1157,8 @@ class VerletList
       calculate the neighbor list.
     */
     template <class PositionSlice, class ExecutionSpace>
-    void build( ExecutionSpace, PositionSlice x, const std::size_t begin,
-                const std::size_t end,
+    void build( ExecutionSpace exec_space, PositionSlice x,
+                const std::size_t begin, const std::size_t end,
                 const typename PositionSlice::value_type neighborhood_radius,
                 const typename PositionSlice::value_type cell_size_ratio,
                 const typename PositionSlice::value_type grid_min[3],
@@ -762,7 +1178,7 @@ class VerletList
         using builder_type =
             Impl::VerletListBuilder<device_type, PositionSlice, AlgorithmTag,
                                     LayoutTag, BuildTag>;
-        builder_type builder( x, begin, end, neighborhood_radius,
+        builder_type builder( exec_space, x, begin, end, neighborhood_radius,
                               cell_size_ratio, grid_min, grid_max, max_neigh );
 
         // For each particle in the range check each neighboring bin for
@@ -773,25 +1189,25 @@ class VerletList
         // count and fill at the same time, unless the array size is exceeded,
         // at which point only counting is continued to reallocate and refill.
         typename builder_type::FillNeighborsPolicy fill_policy(
-            builder.bin_data_1d.numBin(), Kokkos::AUTO, 4 );
+            exec_space, builder.bin_data_1d.numBin(), Kokkos::AUTO, 4 );
         if ( builder.count )
         {
             typename builder_type::CountNeighborsPolicy count_policy(
-                builder.bin_data_1d.numBin(), Kokkos::AUTO, 4 );
+                exec_space, builder.bin_data_1d.numBin(), Kokkos::AUTO, 4 );
             Kokkos::parallel_for( "Cabana::VerletList::count_neighbors",
                                   count_policy, builder );
         }
         else
         {
-            builder.processCounts( LayoutTag() );
+            builder.processCounts( exec_space, LayoutTag() );
             Kokkos::parallel_for( "Cabana::VerletList::fill_neighbors",
                                   fill_policy, builder );
         }
-        Kokkos::fence();
+        exec_space.fence();
 
         // Process the counts by computing offsets and allocating the neighbor
         // list, if needed.
-        builder.processCounts( LayoutTag() );
+        builder.processCounts( exec_space, LayoutTag() );
 
         // For each particle in the range fill (or refill) its part of the
         // neighbor list.
@@ -799,7 +1215,7 @@ class VerletList
         {
             Kokkos::parallel_for( "Cabana::VerletList::fill_neighbors",
                                   fill_policy, builder );
-            Kokkos::fence();
+            exec_space.fence();
         }
 
         // Get the data from the builder.
@@ -808,6 +1224,85 @@ class VerletList
         Kokkos::Profiling::popRegion();
     }
 
+    /*!
+      \brief Given particles binned in a sparse cell list and a neighborhood
+      radius calculate the neighbor list.
+    */
+    template <class PositionSlice>
+    void build( const SparseCellList<memory_space>& cell_list,
+                PositionSlice x, const std::size_t begin,
+                const std::size_t end,
+                const typename PositionSlice::value_type neighborhood_radius,
+                const std::size_t max_neigh = 0 )
+    {
+        // Use the default execution space.
+        build( execution_space{}, cell_list, x, begin, end,
+               neighborhood_radius, max_neigh );
+    }
+
+    /*!
+      \brief Given particles binned in a sparse cell list and a neighborhood
+      radius calculate the neighbor list.
+
+      Each particle in the range searches the cells within the neighborhood
+      radius of its own cell. Only the occupied cells are stored in the cell
+      list, so empty cells are skipped with a key lookup and the memory of the
+      search scales with the number of particles rather than with the volume
+      of the grid. The particles binned in the cell list are the candidate
+      neighbors. The build tag is not used as the search is per particle.
+
+      \param exec_space The execution space to use.
+      \param cell_list The sparse cell list binning the candidate neighbors.
+      \param x The slice containing the particle positions used to build the
+      cell list.
+      \param begin The beginning particle index to compute neighbors for.
+      \param end The end particle index to compute neighbors for.
+      \param neighborhood_radius The radius of the neighborhood.
+      \param max_neigh Optional maximum number of neighbors per particle to
+      pre-allocate the neighbor list. Potentially avoids recounting with 2D
+      layouts only.
+    */
+    template <class ExecutionSpace, class PositionSlice>
+    void build( ExecutionSpace exec_space,
+                const SparseCellList<memory_space>& cell_list,
+                PositionSlice x, const std::size_t begin,
+                const std::size_t end,
+                const typename PositionSlice::value_type neighborhood_radius,
+                const std::size_t max_neigh = 0 )
+    {
+        Kokkos::Profiling::pushRegion( "Cabana::VerletList::build" );
+
+        static_assert( is_accessible_from<memory_space, ExecutionSpace>{}, "" );
+
+        assert( end >= begin );
+        assert( end <= x.size() );
+
+        Impl::SparseVerletListSearch<memory_space, AlgorithmTag, LayoutTag,
+                                     PositionSlice>
+            search;
+        search.data.counts =
+            Kokkos::View<int*, memory_space>( "num_neighbors", x.size() );
+        search.cells = cell_list;
+        search.bins = cell_list.binningData();
+        search.position = x;
+        search.rsqr = neighborhood_radius * neighborhood_radius;
+        for ( int d = 0; d < 3; ++d )
+        {
+            search.range[d] = static_cast<int>(
+                std::ceil( neighborhood_radius / cell_list.binDelta( d ) ) );
+            search.num_bin[d] = cell_list.numBin( d );
+        }
+
+        Kokkos::RangePolicy<ExecutionSpace> policy( exec_space, begin, end );
+        Impl::fillNeighbors( exec_space, policy, search, max_neigh,
+                             LayoutTag() );
+
+        // Get the data from the search.
+        _data = search.data;
+
+        Kokkos::Profiling::popRegion();
+    }
+
     //! Modify a neighbor in the list; for example, mark it as a broken bond.
     KOKKOS_INLINE_FUNCTION
     void setNeighbor( const std::size_t particle_index,
@@ -818,6 +1313,227 @@ class VerletList
     }
 };
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Fill (or refresh) per-pair data for every neighbor in a VerletList.
+
+  The pair data is reallocated if the list size has changed, e.g. after a
+  rebuild. Otherwise, after a position update with the same list, this only
+  recomputes the pair values.
+
+  \param exec_space The execution space instance.
+  \param list The neighbor list.
+  \param pair_functor Functor called as pair_functor( i, j, values ) which
+  fills a Kokkos::Array of NumValue values for particle i and neighbor j.
+  \param pair_data The pair data to fill.
+*/
+template <class ExecutionSpace, class MemorySpace, class AlgorithmTag,
+          class LayoutTag, class BuildTag, class PairFunctor, int NumValue>
+void updatePairData(
+    const ExecutionSpace& exec_space,
+    const VerletList<MemorySpace, AlgorithmTag, LayoutTag, BuildTag>& list,
+    const PairFunctor& pair_functor,
+    VerletPairData<MemorySpace, NumValue>& pair_data )
+{
+    Kokkos::Profiling::pushRegion( "Cabana::updatePairData" );
+
+    static_assert( is_accessible_from<MemorySpace, ExecutionSpace>{}, "" );
+
+    auto data = list._data;
+    if ( pair_data.values.extent( 0 ) != data.numPair() )
+        pair_data.values =
+            Kokkos::View<double**, Kokkos::LayoutLeft, MemorySpace>(
+                Kokkos::ViewAllocateWithoutInitializing( "pair_data" ),
+                data.numPair(), NumValue );
+
+    auto values = pair_data;
+    Kokkos::parallel_for(
+        "Cabana::updatePairData",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                             data.counts.extent( 0 ) ),
+        KOKKOS_LAMBDA( const int i ) {
+            for ( int n = 0; n < data.counts( i ); ++n )
+            {
+                Kokkos::Array<double, NumValue> v;
+                pair_functor( i, data.getNeighbor( i, n ), v );
+                values.set( data.pairIndex( i, n ), v );
+            }
+        } );
+
+    Kokkos::Profiling::popRegion();
+}
+
+/*!
+  \brief Create per-pair data for every neighbor in a VerletList.
+  \param exec_space The execution space instance.
+  \param list The neighbor list.
+  \param pair_functor Pair functor with a static num_value member.
+  \return The pair data.
+*/
+template <class ExecutionSpace, class ListType, class PairFunctor>
+auto createPairData( const ExecutionSpace& exec_space, const ListType& list,
+                     const PairFunctor& pair_functor )
+{
+    VerletPairData<typename ListType::memory_space, PairFunctor::num_value>
+        pair_data;
+    updatePairData( exec_space, list, pair_functor, pair_data );
+    return pair_data;
+}
+
+/*!
+  \brief Create pair geometry (dx, dy, dz, r) for every neighbor in a
+  VerletList.
+  \param exec_space The execution space instance.
+  \param list The neighbor list.
+  \param x The particle positions used to build the list.
+  \return The pair data.
+*/
+template <class ExecutionSpace, class ListType, class PositionSlice>
+auto createPairGeometry( const ExecutionSpace& exec_space,
+                         const ListType& list, const PositionSlice& x )
+{
+    return createPairData( exec_space, list,
+                           VerletPairGeometry<PositionSlice>{ x } );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Derive neighbor lists with smaller cutoffs from an existing
+  VerletList by compaction.
+
+  Each inner list only holds the neighbors of the outer list within its
+  radius, so lists for several cutoffs (e.g. for multiple time step
+  integrators) are built with one binned search at the largest cutoff
+  followed by a single count pass and a single fill pass over the outer list.
+
+  \param exec_space The execution space instance.
+  \param list The outer neighbor list.
+  \param x The particle positions used to build the outer list.
+  \param radii The neighborhood radius of each inner list. Each radius should
+  be less than or equal to the radius of the outer list.
+  \return The inner lists, in CSR layout, in the same order as the radii.
+*/
+template <class ExecutionSpace, class MemorySpace, class AlgorithmTag,
+          class LayoutTag, class BuildTag, class PositionSlice,
+          std::size_t NumList>
+std::array<VerletList<MemorySpace, AlgorithmTag, VerletLayoutCSR, BuildTag>,
+           NumList>
+filterNeighborList(
+    const ExecutionSpace& exec_space,
+    const VerletList<MemorySpace, AlgorithmTag, LayoutTag, BuildTag>& list,
+    const PositionSlice& x, const std::array<double, NumList>& radii )
+{
+    Kokkos::Profiling::pushRegion( "Cabana::filterNeighborList" );
+
+    static_assert( is_accessible_from<MemorySpace, ExecutionSpace>{}, "" );
+
+    using data_type = VerletListData<MemorySpace, VerletLayoutCSR>;
+    auto outer = list._data;
+    const int num_particle = outer.counts.extent( 0 );
+    Kokkos::RangePolicy<ExecutionSpace> policy( exec_space, 0, num_particle );
+
+    Kokkos::Array<data_type, NumList> inner;
+    Kokkos::Array<double, NumList> rsqr;
+    for ( std::size_t l = 0; l < NumList; ++l )
+    {
+        inner[l].counts =
+            Kokkos::View<int*, MemorySpace>( "num_neighbors", num_particle );
+        inner[l].offsets = Kokkos::View<int*, MemorySpace>(
+            Kokkos::ViewAllocateWithoutInitializing( "neighbor_offsets" ),
+            num_particle );
+        rsqr[l] = radii[l] * radii[l];
+    }
+
+    // Count the neighbors of every inner list in one pass over the outer
+    // list.
+    Kokkos::parallel_for(
+        "Cabana::filterNeighborList::count", policy,
+        KOKKOS_LAMBDA( const int i ) {
+            for ( int n = 0; n < outer.counts( i ); ++n )
+            {
+                int j = outer.getNeighbor( i, n );
+                double dist_sqr = 0.0;
+                for ( int d = 0; d < 3; ++d )
+                    dist_sqr += ( x( i, d ) - x( j, d ) ) *
+                                ( x( i, d ) - x( j, d ) );
+                for ( std::size_t l = 0; l < NumList; ++l )
+                    if ( dist_sqr <= rsqr[l] )
+                        ++inner[l].counts( i );
+            }
+        } );
+
+    // Compute the offsets and allocate the inner lists.
+    for ( std::size_t l = 0; l < NumList; ++l )
+    {
+        auto counts = inner[l].counts;
+        auto offsets = inner[l].offsets;
+        int total_num_neighbor = 0;
+        Kokkos::parallel_scan(
+            "Cabana::filterNeighborList::offset_scan", policy,
+            KOKKOS_LAMBDA( const int i, int& update, const bool final_pass ) {
+                if ( final_pass )
+                    offsets( i ) = update;
+                update += counts( i );
+            },
+            total_num_neighbor );
+        inner[l].neighbors = Kokkos::View<int*, MemorySpace>(
+            Kokkos::ViewAllocateWithoutInitializing( "neighbors" ),
+            total_num_neighbor );
+    }
+
+    // Fill every inner list in one pass over the outer list, keeping the
+    // order of the outer list.
+    Kokkos::parallel_for(
+        "Cabana::filterNeighborList::fill", policy,
+        KOKKOS_LAMBDA( const int i ) {
+            Kokkos::Array<int, NumList> c;
+            for ( std::size_t l = 0; l < NumList; ++l )
+                c[l] = 0;
+            for ( int n = 0; n < outer.counts( i ); ++n )
+            {
+                int j = outer.getNeighbor( i, n );
+                double dist_sqr = 0.0;
+                for ( int d = 0; d < 3; ++d )
+                    dist_sqr += ( x( i, d ) - x( j, d ) ) *
+                                ( x( i, d ) - x( j, d ) );
+                for ( std::size_t l = 0; l < NumList; ++l )
+                    if ( dist_sqr <= rsqr[l] )
+                        inner[l].setNeighbor( i, c[l]++, j );
+            }
+        } );
+    exec_space.fence();
+
+    std::array<VerletList<MemorySpace, AlgorithmTag, VerletLayoutCSR, BuildTag>,
+               NumList>
+        lists;
+    for ( std::size_t l = 0; l < NumList; ++l )
+        lists[l]._data = inner[l];
+
+    Kokkos::Profiling::popRegion();
+    return lists;
+}
+
+/*!
+  \brief Derive a neighbor list with a smaller cutoff from an existing
+  VerletList by compaction.
+  \param exec_space The execution space instance.
+  \param list The outer neighbor list.
+  \param x The particle positions used to build the outer list.
+  \param radius The neighborhood radius of the inner list.
+  \return The inner list in CSR layout.
+*/
+template <class ExecutionSpace, class MemorySpace, class AlgorithmTag,
+          class LayoutTag, class BuildTag, class PositionSlice>
+VerletList<MemorySpace, AlgorithmTag, VerletLayoutCSR, BuildTag>
+filterNeighborList(
+    const ExecutionSpace& exec_space,
+    const VerletList<MemorySpace, AlgorithmTag, LayoutTag, BuildTag>& list,
+    const PositionSlice& x, const double radius )
+{
+    return filterNeighborList( exec_space, list, x,
+                               std::array<double, 1>{ radius } )[0];
+}
+
 //---------------------------------------------------------------------------//
 // Neighbor list interface implementation.
 //---------------------------------------------------------------------------//
@@ -899,6 +1615,175 @@ class NeighborList<
     }
 };
 
+//---------------------------------------------------------------------------//
+//! Blocked 2D VerletList NeighborList interface.
+template <class MemorySpace, class AlgorithmTag, class BuildTag>
+class NeighborList<
+    VerletList<MemorySpace, AlgorithmTag, VerletLayoutAoSoA, BuildTag>>
+{
+  public:
+    //! Kokkos memory space.
+    using memory_space = MemorySpace;
+    //! Neighbor list type.
+    using list_type =
+        VerletList<MemorySpace, AlgorithmTag, VerletLayoutAoSoA, BuildTag>;
+
+    //! Get the maximum number of neighbors per particle.
+    KOKKOS_INLINE_FUNCTION
+    static std::size_t maxNeighbor( const list_type& list )
+    {
+        return list._data.neighbors.extent( 1 );
+    }
+
+    //! Get the number of neighbors for a given particle index.
+    KOKKOS_INLINE_FUNCTION
+    static std::size_t numNeighbor( const list_type& list,
+                                    const std::size_t particle_index )
+    {
+        return list._data.counts( particle_index );
+    }
+
+    //! Get the id for a neighbor for a given particle index and the index of
+    //! the neighbor relative to the particle.
+    KOKKOS_INLINE_FUNCTION
+    static std::size_t getNeighbor( const list_type& list,
+                                    const std::size_t particle_index,
+                                    const std::size_t neighbor_index )
+    {
+        return list._data.getNeighbor( particle_index, neighbor_index );
+    }
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Execute functor in parallel according to the execution policy over
+  particles with a thread-local serial loop over particle first neighbors,
+  passing the precomputed pair data of each neighbor.
+
+  \param exec_policy The policy over which to execute the functor.
+  \param functor The functor to execute in parallel. It is called as
+  functor( i, j, pair ) where pair is a Kokkos::Array of the pair values.
+  \param list The neighbor list over which to execute the neighbor operations.
+  \param pair_data The pair data of the neighbor list.
+  \param FirstNeighborsTag Tag indicating operations over particle first
+  neighbors.
+  \param SerialOpTag Tag indicating a serial loop strategy over neighbors.
+  \param str Optional name for the functor.
+*/
+template <class FunctorType, class MemorySpace, class AlgorithmTag,
+          class LayoutTag, class BuildTag, int NumValue,
+          class... ExecParameters>
+inline void neighbor_parallel_for(
+    const Kokkos::RangePolicy<ExecParameters...>& exec_policy,
+    const FunctorType& functor,
+    const VerletList<MemorySpace, AlgorithmTag, LayoutTag, BuildTag>& list,
+    const VerletPairData<MemorySpace, NumValue>& pair_data,
+    const FirstNeighborsTag, const SerialOpTag, const std::string& str = "" )
+{
+    Kokkos::Profiling::pushRegion( "Cabana::neighbor_parallel_for" );
+
+    using work_tag = typename Kokkos::RangePolicy<ExecParameters...>::work_tag;
+
+    using execution_space =
+        typename Kokkos::RangePolicy<ExecParameters...>::execution_space;
+
+    using index_type =
+        typename Kokkos::RangePolicy<ExecParameters...>::index_type;
+
+    using linear_policy_type = Kokkos::RangePolicy<execution_space, void, void>;
+    linear_policy_type linear_exec_policy(
+        exec_policy.space(), exec_policy.begin(), exec_policy.end() );
+
+    static_assert( is_accessible_from<MemorySpace, execution_space>{}, "" );
+
+    auto data = list._data;
+    auto neigh_func = KOKKOS_LAMBDA( const index_type i )
+    {
+        for ( index_type n = 0; n < data.counts( i ); ++n )
+        {
+            auto pair = pair_data.get( data.pairIndex( i, n ) );
+            Impl::functorTagDispatch<work_tag>(
+                functor, i,
+                static_cast<index_type>( data.getNeighbor( i, n ) ), pair );
+        }
+    };
+    if ( str.empty() )
+        Kokkos::parallel_for( linear_exec_policy, neigh_func );
+    else
+        Kokkos::parallel_for( str, linear_exec_policy, neigh_func );
+
+    Kokkos::Profiling::popRegion();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Execute functor in parallel according to the execution policy over
+  particles with team parallelism over particle first neighbors, passing the
+  precomputed pair data of each neighbor.
+
+  \param exec_policy The policy over which to execute the functor.
+  \param functor The functor to execute in parallel. It is called as
+  functor( i, j, pair ) where pair is a Kokkos::Array of the pair values.
+  \param list The neighbor list over which to execute the neighbor operations.
+  \param pair_data The pair data of the neighbor list.
+  \param FirstNeighborsTag Tag indicating operations over particle first
+  neighbors.
+  \param TeamOpTag Tag indicating a team parallel strategy over neighbors.
+  \param str Optional name for the functor.
+*/
+template <class FunctorType, class MemorySpace, class AlgorithmTag,
+          class LayoutTag, class BuildTag, int NumValue,
+          class... ExecParameters>
+inline void neighbor_parallel_for(
+    const Kokkos::RangePolicy<ExecParameters...>& exec_policy,
+    const FunctorType& functor,
+    const VerletList<MemorySpace, AlgorithmTag, LayoutTag, BuildTag>& list,
+    const VerletPairData<MemorySpace, NumValue>& pair_data,
+    const FirstNeighborsTag, const TeamOpTag, const std::string& str = "" )
+{
+    Kokkos::Profiling::pushRegion( "Cabana::neighbor_parallel_for" );
+
+    using work_tag = typename Kokkos::RangePolicy<ExecParameters...>::work_tag;
+
+    using execution_space =
+        typename Kokkos::RangePolicy<ExecParameters...>::execution_space;
+
+    using kokkos_policy =
+        Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Dynamic>>;
+    kokkos_policy team_policy( exec_policy.space(),
+                               exec_policy.end() - exec_policy.begin(),
+                               Kokkos::AUTO );
+
+    using index_type = typename kokkos_policy::index_type;
+
+    static_assert( is_accessible_from<MemorySpace, execution_space>{}, "" );
+
+    const auto range_begin = exec_policy.begin();
+
+    auto data = list._data;
+    auto neigh_func =
+        KOKKOS_LAMBDA( const typename kokkos_policy::member_type& team )
+    {
+        index_type i = team.league_rank() + range_begin;
+        Kokkos::parallel_for(
+            Kokkos::TeamThreadRange( team, data.counts( i ) ),
+            [&]( const index_type n )
+            {
+                auto pair = pair_data.get( data.pairIndex( i, n ) );
+                Impl::functorTagDispatch<work_tag>(
+                    functor, i,
+                    static_cast<index_type>( data.getNeighbor( i, n ) ),
+                    pair );
+            } );
+    };
+    if ( str.empty() )
+        Kokkos::parallel_for( team_policy, neigh_func );
+    else
+        Kokkos::parallel_for( str, team_policy, neigh_func );
+
+    Kokkos::Profiling::popRegion();
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Cabana
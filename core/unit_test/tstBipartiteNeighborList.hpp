@@ -0,0 +1,156 @@
+/****************************************************************************
+ * Copyright (c) 2018-2023 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_BipartiteNeighborList.hpp>
+#include <Cabana_DeepCopy.hpp>
+#include <Cabana_LinkedCellList.hpp>
+#include <Cabana_NeighborList.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+// Check the list of every target in a range against a brute force search.
+template <class ListType, class SourceHostSlice, class TargetHostSlice>
+void checkBipartiteList( const ListType& list, const SourceHostSlice& source,
+                         const TargetHostSlice& target, const int begin,
+                         const int end, const double radius )
+{
+    // Copy the neighbors of each target to the host.
+    int num_target = target.size();
+    int max_n = source.size();
+    Kokkos::View<int*, TEST_MEMSPACE> counts( "counts", num_target );
+    Kokkos::View<int**, TEST_MEMSPACE> neighbors( "neighbors", num_target,
+                                                  max_n );
+    Kokkos::parallel_for(
+        "copy_neighbors", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_target ),
+        KOKKOS_LAMBDA( const int t ) {
+            counts( t ) =
+                Cabana::NeighborList<ListType>::numNeighbor( list, t );
+            for ( int n = 0; n < counts( t ); ++n )
+                neighbors( t, n ) =
+                    Cabana::NeighborList<ListType>::getNeighbor( list, t, n );
+        } );
+    Kokkos::fence();
+    auto counts_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), counts );
+    auto neighbors_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), neighbors );
+
+    double rsqr = radius * radius;
+    for ( int t = 0; t < num_target; ++t )
+    {
+        std::vector<int> expected;
+        if ( t >= begin && t < end )
+            for ( std::size_t s = 0; s < source.size(); ++s )
+            {
+                double r2 = 0.0;
+                for ( int d = 0; d < 3; ++d )
+                    r2 += ( target( t, d ) - source( s, d ) ) *
+                          ( target( t, d ) - source( s, d ) );
+                if ( r2 <= rsqr )
+                    expected.push_back( s );
+            }
+        std::vector<int> actual( counts_host( t ) );
+        for ( int n = 0; n < counts_host( t ); ++n )
+            actual[n] = neighbors_host( t, n );
+        std::sort( actual.begin(), actual.end() );
+        EXPECT_EQ( actual, expected );
+    }
+}
+
+//---------------------------------------------------------------------------//
+template <class LayoutTag>
+void testBipartiteNeighborList()
+{
+    // Create a small set of source particles in the unit box and a larger
+    // set of target particles, some of which are outside of the box.
+    int num_source = 200;
+    int num_target = 1000;
+    using data_types = Cabana::MemberTypes<double[3]>;
+    Cabana::AoSoA<data_types, Kokkos::HostSpace> source_host( "source",
+                                                              num_source );
+    Cabana::AoSoA<data_types, Kokkos::HostSpace> target_host( "target",
+                                                              num_target );
+    auto xs_host = Cabana::slice<0>( source_host );
+    auto xt_host = Cabana::slice<0>( target_host );
+    std::mt19937 gen( 4329 );
+    std::uniform_real_distribution<double> inside( 0.0, 1.0 );
+    std::uniform_real_distribution<double> around( -0.2, 1.2 );
+    for ( int s = 0; s < num_source; ++s )
+        for ( int d = 0; d < 3; ++d )
+            xs_host( s, d ) = inside( gen );
+    for ( int t = 0; t < num_target; ++t )
+        for ( int d = 0; d < 3; ++d )
+            xt_host( t, d ) = around( gen );
+    auto source =
+        Cabana::create_mirror_view_and_copy( TEST_MEMSPACE(), source_host );
+    auto target =
+        Cabana::create_mirror_view_and_copy( TEST_MEMSPACE(), target_host );
+    auto xs = Cabana::slice<0>( source );
+    auto xt = Cabana::slice<0>( target );
+
+    // Bin the sources once with bins smaller than the radius.
+    double radius = 0.15;
+    double grid_delta[3] = { 0.1, 0.1, 0.1 };
+    double grid_min[3] = { 0.0, 0.0, 0.0 };
+    double grid_max[3] = { 1.0, 1.0, 1.0 };
+    Cabana::LinkedCellList<TEST_MEMSPACE> source_cells( xs, grid_delta,
+                                                        grid_min, grid_max );
+
+    // Search all targets.
+    using list_type = Cabana::BipartiteNeighborList<TEST_MEMSPACE, LayoutTag>;
+    list_type list( source_cells, xs, xt, 0, num_target, radius );
+    checkBipartiteList( list, xs_host, xt_host, 0, num_target, radius );
+
+    // Move the targets and search a subset again without rebinning the
+    // sources, starting from a small guess for the number of neighbors.
+    for ( int t = 0; t < num_target; ++t )
+        for ( int d = 0; d < 3; ++d )
+            xt_host( t, d ) = around( gen );
+    Cabana::deep_copy( target, target_host );
+    list.build( TEST_EXECSPACE(), source_cells, xs, xt, 100, 700, radius, 2 );
+    checkBipartiteList( list, xs_host, xt_host, 100, 700, radius );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+#ifndef KOKKOS_ENABLE_OPENMPTARGET // FIXME_OPENMPTARGET
+TEST( TEST_CATEGORY, bipartite_csr_test )
+{
+    testBipartiteNeighborList<Cabana::VerletLayoutCSR>();
+}
+#endif
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, bipartite_2d_test )
+{
+    testBipartiteNeighborList<Cabana::VerletLayout2D>();
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, bipartite_aosoa_test )
+{
+    testBipartiteNeighborList<Cabana::VerletLayoutAoSoA>();
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
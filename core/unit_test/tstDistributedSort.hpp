@@ -0,0 +1,113 @@
+/****************************************************************************
+ * Copyright (c) 2018-2023 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
+#include <Cabana_DistributedSort.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <vector>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+void testSampleSort( const int num_local )
+{
+    int comm_rank;
+    int comm_size;
+    MPI_Comm_rank( MPI_COMM_WORLD, &comm_rank );
+    MPI_Comm_size( MPI_COMM_WORLD, &comm_size );
+
+    // Create particles with scrambled keys, including duplicates, and a
+    // unique global id.
+    using data_types = Cabana::MemberTypes<long, long>;
+    Cabana::AoSoA<data_types, TEST_MEMSPACE> aosoa( "aosoa", num_local );
+    auto keys = Cabana::slice<0>( aosoa );
+    auto ids = Cabana::slice<1>( aosoa );
+    Kokkos::parallel_for(
+        "fill", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_local ),
+        KOKKOS_LAMBDA( const int p ) {
+            long id = comm_rank * num_local + p;
+            ids( p ) = id;
+            keys( p ) = ( id * 7919 ) % 1009;
+        } );
+    Kokkos::fence();
+
+    Cabana::sampleSort<0>( TEST_EXECSPACE(), MPI_COMM_WORLD, aosoa );
+
+    // Check that the keys are sorted on this rank.
+    auto aosoa_host =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), aosoa );
+    auto keys_host = Cabana::slice<0>( aosoa_host );
+    auto ids_host = Cabana::slice<1>( aosoa_host );
+    int num_sorted = aosoa_host.size();
+    for ( int p = 1; p < num_sorted; ++p )
+        EXPECT_LE( keys_host( p - 1 ), keys_host( p ) );
+
+    // Check that the elements are conserved and each key still belongs to
+    // its element.
+    int num_global = 0;
+    MPI_Allreduce( &num_sorted, &num_global, 1, MPI_INT, MPI_SUM,
+                   MPI_COMM_WORLD );
+    EXPECT_EQ( num_global, num_local * comm_size );
+    long id_sum = 0;
+    for ( int p = 0; p < num_sorted; ++p )
+    {
+        EXPECT_EQ( keys_host( p ), ( ids_host( p ) * 7919 ) % 1009 );
+        id_sum += ids_host( p );
+    }
+    long global_id_sum = 0;
+    MPI_Allreduce( &id_sum, &global_id_sum, 1, MPI_LONG, MPI_SUM,
+                   MPI_COMM_WORLD );
+    long num_id = static_cast<long>( num_local ) * comm_size;
+    EXPECT_EQ( global_id_sum, num_id * ( num_id - 1 ) / 2 );
+
+    // Check that the ranks hold consecutive key ranges.
+    long bounds[2] = { 0, 0 };
+    int has_elements = ( num_sorted > 0 ) ? 1 : 0;
+    if ( has_elements )
+    {
+        bounds[0] = keys_host( 0 );
+        bounds[1] = keys_host( num_sorted - 1 );
+    }
+    std::vector<long> all_bounds( 2 * comm_size );
+    std::vector<int> all_has_elements( comm_size );
+    MPI_Allgather( bounds, 2, MPI_LONG, all_bounds.data(), 2, MPI_LONG,
+                   MPI_COMM_WORLD );
+    MPI_Allgather( &has_elements, 1, MPI_INT, all_has_elements.data(), 1,
+                   MPI_INT, MPI_COMM_WORLD );
+    long prev_max = -1;
+    for ( int r = 0; r < comm_size; ++r )
+    {
+        if ( !all_has_elements[r] )
+            continue;
+        EXPECT_LE( prev_max, all_bounds[2 * r] );
+        prev_max = all_bounds[2 * r + 1];
+    }
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, sample_sort_test ) { testSampleSort( 1000 ); }
+
+TEST( TEST_CATEGORY, sample_sort_small_test ) { testSampleSort( 3 ); }
+
+TEST( TEST_CATEGORY, sample_sort_empty_test ) { testSampleSort( 0 ); }
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
@@ -475,13 +475,13 @@ void testHalo( TestTag tag, const bool use_topology )
     auto slice_int = Cabana::slice<0>( data );
     auto slice_dbl = Cabana::slice<1>( data );
     Cabana::scatter( *halo, slice_int );
-    Cabana::scatter( *halo, slice_dbl );
+    Cabana::scatter( TEST_EXECSPACE(), *halo, slice_dbl );
     Cabana::deep_copy( data_host, data );
     checkScatter( tag, data_host, my_size, my_rank, num_local );
 
     // Gather again, this time with slices.
     Cabana::gather( *halo, slice_int );
-    Cabana::gather( *halo, slice_dbl );
+    Cabana::gather( TEST_EXECSPACE(), *halo, slice_dbl );
     Cabana::deep_copy( data_host, data );
     checkGatherSlice( tag, data_host, my_size, my_rank, num_local );
 }
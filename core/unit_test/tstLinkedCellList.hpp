@@ -15,6 +15,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <random>
+
 namespace Test
 {
 struct LCLTestData
@@ -318,6 +321,167 @@ void testLinkedListSlice()
     }
 }
 
+//---------------------------------------------------------------------------//
+void testLinkedListStable()
+{
+    LCLTestData test_data;
+    auto pos = Cabana::slice<LCLTestData::Position>( test_data.aosoa );
+
+    // Use large cells so that every cell contains many particles.
+    double dx = 5.0;
+    double grid_delta[3] = { dx, dx, dx };
+    Cabana::LinkedCellList<TEST_MEMSPACE> cell_list(
+        pos, test_data.begin, test_data.end, grid_delta, test_data.grid_min,
+        test_data.grid_max, true );
+    EXPECT_TRUE( cell_list.stableOrder() );
+
+    // Check the build and a rebuild. Particles within a cell are ordered by
+    // their original index.
+    for ( int b = 0; b < 2; ++b )
+    {
+        int nx = cell_list.numBin( 0 );
+        int num_bin = cell_list.totalBins();
+        int num_p = test_data.end - test_data.begin;
+        Kokkos::View<int*, TEST_MEMSPACE> bin_size( "bin_size", num_bin );
+        Kokkos::View<int*, TEST_MEMSPACE> bin_offset( "bin_offset", num_bin );
+        Kokkos::View<int*, TEST_MEMSPACE> permutation( "permutation", num_p );
+        Kokkos::View<int*, TEST_MEMSPACE> cell_index( "cell_index", num_p );
+        Kokkos::parallel_for(
+            "copy bins", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_bin ),
+            KOKKOS_LAMBDA( const int c ) {
+                int i, j, k;
+                cell_list.ijkBinIndex( c, i, j, k );
+                bin_size( c ) = cell_list.binSize( i, j, k );
+                bin_offset( c ) = cell_list.binOffset( i, j, k );
+            } );
+        Kokkos::parallel_for(
+            "copy permutation", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_p ),
+            KOKKOS_LAMBDA( const int p ) {
+                permutation( p ) = cell_list.permutation( p );
+                cell_index( p ) = cell_list.cellIndex( p );
+            } );
+        Kokkos::fence();
+        auto bin_size_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), bin_size );
+        auto bin_offset_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), bin_offset );
+        auto permutation_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), permutation );
+        auto cell_index_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), cell_index );
+
+        EXPECT_EQ( nx, 2 );
+        for ( int c = 0; c < num_bin; ++c )
+        {
+            EXPECT_GT( bin_size_host( c ), 1 );
+            for ( int n = 1; n < bin_size_host( c ); ++n )
+            {
+                int o = bin_offset_host( c ) + n;
+                EXPECT_LT( permutation_host( o - 1 ), permutation_host( o ) );
+            }
+            for ( int n = 0; n < bin_size_host( c ); ++n )
+            {
+                int p = permutation_host( bin_offset_host( c ) + n );
+                EXPECT_EQ( cell_index_host( p - test_data.begin ), c );
+            }
+        }
+
+        cell_list.build( pos, test_data.begin, test_data.end );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Pair functor with an antisymmetric vector contribution.
+template <class PositionSlice>
+struct ColoredPairFunctor
+{
+    PositionSlice x;
+
+    KOKKOS_INLINE_FUNCTION Kokkos::Array<double, 3>
+    operator()( const int i, const int j ) const
+    {
+        Kokkos::Array<double, 3> f;
+        double r2 = 0.0;
+        for ( int d = 0; d < 3; ++d )
+        {
+            f[d] = x( i, d ) - x( j, d );
+            r2 += f[d] * f[d];
+        }
+        for ( int d = 0; d < 3; ++d )
+            f[d] /= ( 1.0 + r2 );
+        return f;
+    }
+};
+
+//---------------------------------------------------------------------------//
+void testLinkedCellParallelFor()
+{
+    // Create random particles in a box.
+    int num_p = 400;
+    double box = 5.0;
+    using data_types = Cabana::MemberTypes<double[3], double[3]>;
+    Cabana::AoSoA<data_types, Kokkos::HostSpace> aosoa_host( "aosoa", num_p );
+    auto x_host = Cabana::slice<0>( aosoa_host );
+    auto f_host = Cabana::slice<1>( aosoa_host );
+    std::mt19937 gen( 2712 );
+    std::uniform_real_distribution<double> position( 0.0, box );
+    for ( int p = 0; p < num_p; ++p )
+        for ( int d = 0; d < 3; ++d )
+        {
+            x_host( p, d ) = position( gen );
+            f_host( p, d ) = 0.0;
+        }
+    auto aosoa =
+        Cabana::create_mirror_view_and_copy( TEST_MEMSPACE(), aosoa_host );
+    auto x = Cabana::slice<0>( aosoa );
+    auto f = Cabana::slice<1>( aosoa );
+
+    // Bin with cells the size of the neighborhood radius.
+    double radius = 1.0;
+    double grid_delta[3] = { radius, radius, radius };
+    double grid_min[3] = { 0.0, 0.0, 0.0 };
+    double grid_max[3] = { box, box, box };
+    Cabana::LinkedCellList<TEST_MEMSPACE> cell_list(
+        x, grid_delta, grid_min, grid_max, true );
+
+    // Accumulate the pair contributions twice.
+    ColoredPairFunctor<decltype( x )> functor{ x };
+    Cabana::linked_cell_parallel_for( TEST_EXECSPACE(), functor, cell_list, x,
+                                      radius, f );
+    Cabana::deep_copy( aosoa_host, aosoa );
+    Cabana::AoSoA<data_types, Kokkos::HostSpace> first( "first", num_p );
+    Cabana::deep_copy( first, aosoa_host );
+    auto f_first = Cabana::slice<1>( first );
+    Cabana::deep_copy( f, 0.0 );
+    Cabana::linked_cell_parallel_for( TEST_EXECSPACE(), functor, cell_list, x,
+                                      radius, f );
+    Cabana::deep_copy( aosoa_host, aosoa );
+
+    // Check against a direct sum and check the result is reproducible.
+    for ( int i = 0; i < num_p; ++i )
+    {
+        double expected[3] = { 0.0, 0.0, 0.0 };
+        for ( int j = 0; j < num_p; ++j )
+        {
+            double r[3];
+            double r2 = 0.0;
+            for ( int d = 0; d < 3; ++d )
+            {
+                r[d] = x_host( i, d ) - x_host( j, d );
+                r2 += r[d] * r[d];
+            }
+            if ( i != j && r2 <= radius * radius )
+                for ( int d = 0; d < 3; ++d )
+                    expected[d] += r[d] / ( 1.0 + r2 );
+        }
+        for ( int d = 0; d < 3; ++d )
+        {
+            EXPECT_NEAR( f_host( i, d ), expected[d], 1.0e-12 );
+            EXPECT_EQ( f_host( i, d ), f_first( i, d ) );
+        }
+    }
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
@@ -326,6 +490,15 @@ TEST( TEST_CATEGORY, linked_list_test ) { testLinkedList(); }
 //---------------------------------------------------------------------------//
 TEST( TEST_CATEGORY, linked_list_slice_test ) { testLinkedListSlice(); }
 
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, linked_list_stable_test ) { testLinkedListStable(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, linked_cell_parallel_for_test )
+{
+    testLinkedCellParallelFor();
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
@@ -12,6 +12,7 @@
 #include <Cabana_AoSoA.hpp>
 #include <Cabana_NeighborList.hpp>
 #include <Cabana_Parallel.hpp>
+#include <Cabana_SparseCellList.hpp>
 #include <Cabana_VerletList.hpp>
 
 #include <Kokkos_Core.hpp>
@@ -20,6 +21,9 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
+
 namespace Test
 {
 //---------------------------------------------------------------------------//
@@ -219,6 +223,57 @@ void testVerletListFullPartialRange()
                                        test_data.num_ignore );
 }
 
+//---------------------------------------------------------------------------//
+template <class AlgorithmTag, class LayoutTag>
+void testVerletListSparse()
+{
+    // Create the AoSoA and fill with random particle positions.
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+
+    // Create the dense neighbor list to check against.
+    Cabana::VerletList<TEST_MEMSPACE, AlgorithmTag, LayoutTag,
+                       Cabana::TeamOpTag>
+        dense( position, 0, position.size(), test_data.test_radius,
+               test_data.cell_size_ratio, test_data.grid_min,
+               test_data.grid_max );
+    auto dense_copy =
+        copyListToHost( dense, test_data.num_particle,
+                        test_data.N2_list_copy.neighbors.extent( 1 ) );
+
+    // Bin the particles in a sparse cell list with the same cell size.
+    double dx = test_data.cell_size_ratio * test_data.test_radius;
+    double grid_delta[3] = { dx, dx, dx };
+    Cabana::SparseCellList<TEST_MEMSPACE> cell_list(
+        position, grid_delta, test_data.grid_min, test_data.grid_max );
+
+    // Build from the sparse cell list and compare to the dense build.
+    Cabana::VerletList<TEST_MEMSPACE, AlgorithmTag, LayoutTag,
+                       Cabana::TeamOpTag>
+        sparse( cell_list, position, 0, position.size(),
+                test_data.test_radius );
+    checkFullNeighborList( sparse, dense_copy, test_data.num_particle );
+
+    // Rebuild with an explicit execution space and a small allocation size
+    // (refill).
+    sparse.build( TEST_EXECSPACE{}, cell_list, position, 0, position.size(),
+                  test_data.test_radius, 2 );
+    checkFullNeighborList( sparse, dense_copy, test_data.num_particle );
+
+    // Check a partial range against the dense build of the same range.
+    Cabana::VerletList<TEST_MEMSPACE, AlgorithmTag, LayoutTag,
+                       Cabana::TeamOpTag>
+        dense_range( position, 0, test_data.num_ignore, test_data.test_radius,
+                     test_data.cell_size_ratio, test_data.grid_min,
+                     test_data.grid_max );
+    auto dense_range_copy =
+        copyListToHost( dense_range, test_data.num_particle,
+                        test_data.N2_list_copy.neighbors.extent( 1 ) );
+    sparse.build( TEST_EXECSPACE{}, cell_list, position, 0,
+                  test_data.num_ignore, test_data.test_radius );
+    checkFullNeighborList( sparse, dense_range_copy, test_data.num_particle );
+}
+
 //---------------------------------------------------------------------------//
 template <class LayoutTag>
 void testNeighborParallelFor()
@@ -323,6 +378,304 @@ void testModifyNeighbors()
                 EXPECT_EQ( list_copy.neighbors( p, n ), new_id );
     }
 }
+//---------------------------------------------------------------------------//
+template <class LayoutTag>
+void testNeighborStatistics()
+{
+    // Create the AoSoA and fill with random particle positions.
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+
+    // Create the neighbor list and compute its statistics.
+    using ListType = Cabana::VerletList<TEST_MEMSPACE, Cabana::FullNeighborTag,
+                                        LayoutTag, Cabana::TeamOpTag>;
+    ListType nlist( position, 0, position.size(), test_data.test_radius,
+                    test_data.cell_size_ratio, test_data.grid_min,
+                    test_data.grid_max );
+    auto stats = Cabana::neighborStatistics( TEST_EXECSPACE(), nlist, 0,
+                                             position.size() );
+
+    // Check against the N^2 list.
+    std::size_t min_n = test_data.N2_list_copy.counts( 0 );
+    std::size_t max_n = 0;
+    std::size_t total_n = 0;
+    Kokkos::Array<std::size_t, Cabana::NeighborStatistics::num_histogram_bin>
+        histogram = {};
+    for ( int p = 0; p < test_data.num_particle; ++p )
+    {
+        std::size_t count = test_data.N2_list_copy.counts( p );
+        min_n = std::min( min_n, count );
+        max_n = std::max( max_n, count );
+        total_n += count;
+        int bin = 0;
+        while ( ( std::size_t( 1 ) << bin ) <= count )
+            ++bin;
+        histogram[bin] += 1;
+    }
+    EXPECT_EQ( stats.num_particle,
+               static_cast<std::size_t>( test_data.num_particle ) );
+    EXPECT_EQ( stats.min_neighbor, min_n );
+    EXPECT_EQ( stats.max_neighbor, max_n );
+    EXPECT_EQ( stats.total_neighbor, total_n );
+    EXPECT_DOUBLE_EQ( stats.meanNeighbor(),
+                      static_cast<double>( total_n ) / test_data.num_particle );
+    for ( int b = 0; b < Cabana::NeighborStatistics::num_histogram_bin; ++b )
+        EXPECT_EQ( stats.histogram[b], histogram[b] );
+
+    // Check the memory forecasts.
+    EXPECT_EQ( stats.csrBytes(),
+               ( 2 * test_data.num_particle + total_n ) * sizeof( int ) );
+    EXPECT_EQ( stats.denseBytes(),
+               ( test_data.num_particle * ( 1 + max_n ) ) * sizeof( int ) );
+    EXPECT_GE( stats.denseBytes( 16 ), stats.denseBytes() );
+    EXPECT_EQ( stats.suggestedMaxNeighbor(), max_n );
+    EXPECT_GE( stats.suggestedMaxNeighbor( 0.1 ), max_n );
+
+    // Rebuild a 2D list pre-allocated from the statistics.
+    Cabana::VerletList<TEST_MEMSPACE, Cabana::FullNeighborTag,
+                       Cabana::VerletLayout2D, Cabana::TeamOpTag>
+        nlist_2d( position, 0, position.size(), test_data.test_radius,
+                  test_data.cell_size_ratio, test_data.grid_min,
+                  test_data.grid_max, stats );
+    EXPECT_EQ( nlist_2d._data.neighbors.extent( 1 ), max_n );
+    checkFullNeighborList( nlist_2d, test_data.N2_list_copy,
+                           test_data.num_particle );
+}
+
+//---------------------------------------------------------------------------//
+void testNeighborSimdParallelFor()
+{
+    // Create the AoSoA and fill with random particle positions.
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+
+    // Create the blocked neighbor list.
+    using ListType = Cabana::VerletList<TEST_MEMSPACE, Cabana::FullNeighborTag,
+                                        Cabana::VerletLayoutAoSoA>;
+    ListType nlist( position, 0, position.size(), test_data.test_radius,
+                    test_data.cell_size_ratio, test_data.grid_min,
+                    test_data.grid_max );
+
+    // Sum the neighbor ids of each particle with a vectorized loop over
+    // neighbor blocks.
+    constexpr int vector_length = decltype( nlist._data )::vector_length;
+    Kokkos::View<int*, TEST_MEMSPACE> id_sum( "id_sum", position.size() );
+    auto data = nlist._data;
+    Cabana::SimdPolicy<vector_length, TEST_EXECSPACE> policy(
+        0, position.size() );
+    Cabana::simd_parallel_for(
+        policy,
+        KOKKOS_LAMBDA( const int s, const int a ) {
+            int p = s * vector_length + a;
+            for ( int n = 0; n < data.counts( p ); ++n )
+                id_sum( p ) += data.neighbors( s, n, a );
+        },
+        "test_simd_neighbors" );
+    Kokkos::fence();
+
+    // Check against the N^2 list.
+    auto id_sum_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), id_sum );
+    for ( int p = 0; p < test_data.num_particle; ++p )
+    {
+        int expected = 0;
+        for ( int n = 0; n < test_data.N2_list_copy.counts( p ); ++n )
+            expected += test_data.N2_list_copy.neighbors( p, n );
+        EXPECT_EQ( id_sum_host( p ), expected );
+    }
+}
+
+//---------------------------------------------------------------------------//
+template <class LayoutTag, class OpTag>
+void testPairData()
+{
+    // Create the AoSoA and fill with random particle positions.
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+
+    // Create the neighbor list and its pair geometry.
+    using ListType = Cabana::VerletList<TEST_MEMSPACE, Cabana::FullNeighborTag,
+                                        LayoutTag, Cabana::TeamOpTag>;
+    ListType nlist( position, 0, position.size(), test_data.test_radius,
+                    test_data.cell_size_ratio, test_data.grid_min,
+                    test_data.grid_max );
+    auto pair_data = Cabana::createPairGeometry( TEST_EXECSPACE(), nlist,
+                                                 position );
+
+    // Move the particles and refresh the pair data with the same list.
+    Kokkos::parallel_for(
+        "move", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, position.size() ),
+        KOKKOS_LAMBDA( const int p ) {
+            for ( int d = 0; d < 3; ++d )
+                position( p, d ) *= 1.01;
+        } );
+    Cabana::updatePairData( TEST_EXECSPACE(), nlist,
+                            Cabana::VerletPairGeometry<decltype( position )>{
+                                position },
+                            pair_data );
+
+    // Count the neighbors and check the pair data against the positions.
+    Kokkos::View<int*, TEST_MEMSPACE> counts( "counts", position.size() );
+    Kokkos::View<double, TEST_MEMSPACE> max_error( "max_error" );
+    auto pair_op = KOKKOS_LAMBDA( const int i, const int j,
+                                  const Kokkos::Array<double, 4>& pair )
+    {
+        Kokkos::atomic_increment( &counts( i ) );
+        double r2 = 0.0;
+        for ( int d = 0; d < 3; ++d )
+        {
+            double dx = position( i, d ) - position( j, d );
+            Kokkos::atomic_max( &max_error(), fabs( dx - pair[d] ) );
+            r2 += dx * dx;
+        }
+        Kokkos::atomic_max( &max_error(),
+                            fabs( Kokkos::sqrt( r2 ) - pair[3] ) );
+    };
+    Kokkos::RangePolicy<TEST_EXECSPACE> policy( 0, position.size() );
+    Cabana::neighbor_parallel_for( policy, pair_op, nlist, pair_data,
+                                   Cabana::FirstNeighborsTag(), OpTag(),
+                                   "test_pair_data" );
+    Kokkos::fence();
+
+    auto counts_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), counts );
+    auto max_error_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), max_error );
+    for ( int p = 0; p < test_data.num_particle; ++p )
+        EXPECT_EQ( counts_host( p ), test_data.N2_list_copy.counts( p ) );
+    EXPECT_LT( max_error_host(), 1.0e-12 );
+}
+
+//---------------------------------------------------------------------------//
+template <class LayoutTag, class OpTag, class... Duplication>
+void testNeighborScatter()
+{
+    // Create the AoSoA and fill with random particle positions.
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+
+    // Create the half neighbor list.
+    using ListType = Cabana::VerletList<TEST_MEMSPACE, Cabana::HalfNeighborTag,
+                                        LayoutTag, Cabana::TeamOpTag>;
+    ListType nlist( position, 0, position.size(), test_data.test_radius,
+                    test_data.cell_size_ratio, test_data.grid_min,
+                    test_data.grid_max );
+
+    // Accumulate vector and scalar pair contributions.
+    using OutputTypes = Cabana::MemberTypes<double[3], double>;
+    Cabana::AoSoA<OutputTypes, TEST_MEMSPACE> output( "output",
+                                                      position.size() );
+    auto vector_out = Cabana::slice<0>( output );
+    auto scalar_out = Cabana::slice<1>( output );
+    Cabana::deep_copy( vector_out, 0.0 );
+    Cabana::deep_copy( scalar_out, 0.0 );
+
+    auto vector_op = KOKKOS_LAMBDA( const int i, const int j )
+    {
+        Kokkos::Array<double, 3> f;
+        for ( int d = 0; d < 3; ++d )
+            f[d] = position( i, d ) - position( j, d );
+        return f;
+    };
+    auto scalar_op = KOKKOS_LAMBDA( const int i, const int j )
+    {
+        return position( i, 0 ) - position( j, 0 );
+    };
+    Kokkos::RangePolicy<TEST_EXECSPACE> policy( 0, position.size() );
+    Cabana::neighbor_parallel_for( policy, vector_op, nlist, vector_out,
+                                   Cabana::FirstNeighborsTag(), OpTag(),
+                                   Duplication()... );
+    Cabana::neighbor_parallel_for( policy, scalar_op, nlist, scalar_out,
+                                   Cabana::FirstNeighborsTag(), OpTag(),
+                                   Duplication()..., "test_scatter" );
+    Kokkos::fence();
+
+    // Each particle gets the sum over its full list of neighbors.
+    auto position_host = Cabana::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), test_data.aosoa );
+    auto x = Cabana::slice<0>( position_host );
+    auto output_host =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), output );
+    auto vector_host = Cabana::slice<0>( output_host );
+    auto scalar_host = Cabana::slice<1>( output_host );
+    for ( int p = 0; p < test_data.num_particle; ++p )
+    {
+        double expected[3] = { 0.0, 0.0, 0.0 };
+        for ( int n = 0; n < test_data.N2_list_copy.counts( p ); ++n )
+        {
+            int j = test_data.N2_list_copy.neighbors( p, n );
+            for ( int d = 0; d < 3; ++d )
+                expected[d] += x( p, d ) - x( j, d );
+        }
+        for ( int d = 0; d < 3; ++d )
+            EXPECT_NEAR( vector_host( p, d ), expected[d], 1.0e-10 );
+        EXPECT_NEAR( scalar_host( p ), expected[0], 1.0e-10 );
+    }
+
+    // Accumulate twice more with storage reused across calls.
+    auto vector_scatter = Cabana::createNeighborScatterBuffer(
+        TEST_EXECSPACE(), vector_out, Duplication()... );
+    auto scalar_scatter = Cabana::createNeighborScatterBuffer(
+        TEST_EXECSPACE(), scalar_out, Duplication()... );
+    for ( int step = 0; step < 2; ++step )
+    {
+        Cabana::neighbor_parallel_for( policy, vector_op, nlist, vector_out,
+                                       Cabana::FirstNeighborsTag(), OpTag(),
+                                       vector_scatter );
+        Cabana::neighbor_parallel_for( policy, scalar_op, nlist, scalar_out,
+                                       Cabana::FirstNeighborsTag(), OpTag(),
+                                       scalar_scatter, "test_scatter" );
+    }
+    Kokkos::fence();
+
+    auto output_host_2 =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), output );
+    auto vector_host_2 = Cabana::slice<0>( output_host_2 );
+    auto scalar_host_2 = Cabana::slice<1>( output_host_2 );
+    for ( int p = 0; p < test_data.num_particle; ++p )
+    {
+        for ( int d = 0; d < 3; ++d )
+            EXPECT_NEAR( vector_host_2( p, d ), 3.0 * vector_host( p, d ),
+                         1.0e-10 );
+        EXPECT_NEAR( scalar_host_2( p ), 3.0 * scalar_host( p ), 1.0e-10 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+template <class LayoutTag>
+void testFilterNeighborList()
+{
+    // Create the AoSoA and fill with random particle positions.
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+
+    // Create the outer neighbor list.
+    Cabana::VerletList<TEST_MEMSPACE, Cabana::FullNeighborTag, LayoutTag,
+                       Cabana::TeamOpTag>
+        outer( position, 0, position.size(), test_data.test_radius,
+               test_data.cell_size_ratio, test_data.grid_min,
+               test_data.grid_max );
+
+    // Filtering at the outer radius keeps every neighbor.
+    auto same = Cabana::filterNeighborList( TEST_EXECSPACE{}, outer, position,
+                                            test_data.test_radius );
+    checkFullNeighborList( same, test_data.N2_list_copy,
+                           test_data.num_particle );
+
+    // Derive two inner lists in one pass and compare to brute force.
+    std::array<double, 2> radii = { 0.5 * test_data.test_radius,
+                                    0.75 * test_data.test_radius };
+    auto inner =
+        Cabana::filterNeighborList( TEST_EXECSPACE{}, outer, position, radii );
+    for ( std::size_t l = 0; l < radii.size(); ++l )
+    {
+        auto N2_list_copy = createTestListHostCopy(
+            computeFullNeighborList( position, radii[l] ) );
+        checkFullNeighborList( inner[l], N2_list_copy,
+                               test_data.num_particle );
+    }
+}
+
 //---------------------------------------------------------------------------//
 // TESTS
 //---------------------------------------------------------------------------//
@@ -340,6 +693,9 @@ TEST( TEST_CATEGORY, verlet_list_full_test )
     testVerletListFull<Cabana::VerletLayoutCSR, Cabana::TeamVectorOpTag>();
 #endif
     testVerletListFull<Cabana::VerletLayout2D, Cabana::TeamVectorOpTag>();
+
+    testVerletListFull<Cabana::VerletLayoutAoSoA, Cabana::TeamOpTag>();
+    testVerletListFull<Cabana::VerletLayoutAoSoA, Cabana::TeamVectorOpTag>();
 }
 
 //---------------------------------------------------------------------------//
@@ -354,6 +710,9 @@ TEST( TEST_CATEGORY, verlet_list_half_test )
     testVerletListHalf<Cabana::VerletLayoutCSR, Cabana::TeamVectorOpTag>();
 #endif
     testVerletListHalf<Cabana::VerletLayout2D, Cabana::TeamVectorOpTag>();
+
+    testVerletListHalf<Cabana::VerletLayoutAoSoA, Cabana::TeamOpTag>();
+    testVerletListHalf<Cabana::VerletLayoutAoSoA, Cabana::TeamVectorOpTag>();
 }
 
 //---------------------------------------------------------------------------//
@@ -373,6 +732,18 @@ TEST( TEST_CATEGORY, verlet_list_full_range_test )
                                    Cabana::TeamVectorOpTag>();
 }
 
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, verlet_list_sparse_test )
+{
+#ifndef KOKKOS_ENABLE_OPENMPTARGET // FIXME_OPENMPTARGET
+    testVerletListSparse<Cabana::FullNeighborTag, Cabana::VerletLayoutCSR>();
+    testVerletListSparse<Cabana::HalfNeighborTag, Cabana::VerletLayoutCSR>();
+#endif
+    testVerletListSparse<Cabana::FullNeighborTag, Cabana::VerletLayout2D>();
+    testVerletListSparse<Cabana::HalfNeighborTag, Cabana::VerletLayout2D>();
+    testVerletListSparse<Cabana::FullNeighborTag, Cabana::VerletLayoutAoSoA>();
+}
+
 //---------------------------------------------------------------------------//
 TEST( TEST_CATEGORY, parallel_for_test )
 {
@@ -380,8 +751,21 @@ TEST( TEST_CATEGORY, parallel_for_test )
     testNeighborParallelFor<Cabana::VerletLayoutCSR>();
 #endif
     testNeighborParallelFor<Cabana::VerletLayout2D>();
+    testNeighborParallelFor<Cabana::VerletLayoutAoSoA>();
 }
 
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, neighbor_statistics_test )
+{
+#ifndef KOKKOS_ENABLE_OPENMPTARGET // FIXME_OPENMPTARGET
+    testNeighborStatistics<Cabana::VerletLayoutCSR>();
+#endif
+    testNeighborStatistics<Cabana::VerletLayout2D>();
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, simd_parallel_for_test ) { testNeighborSimdParallelFor(); }
+
 //---------------------------------------------------------------------------//
 TEST( TEST_CATEGORY, parallel_reduce_test )
 {
@@ -399,6 +783,46 @@ TEST( TEST_CATEGORY, modify_list_test )
 #endif
     testModifyNeighbors<Cabana::VerletLayout2D>();
 }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, neighbor_scatter_test )
+{
+#ifndef KOKKOS_ENABLE_OPENMPTARGET // FIXME_OPENMPTARGET
+    testNeighborScatter<Cabana::VerletLayoutCSR, Cabana::SerialOpTag>();
+    testNeighborScatter<Cabana::VerletLayoutCSR, Cabana::TeamOpTag>();
+#endif
+    testNeighborScatter<Cabana::VerletLayout2D, Cabana::SerialOpTag>();
+    testNeighborScatter<Cabana::VerletLayout2D, Cabana::TeamOpTag,
+                        Kokkos::Experimental::ScatterNonDuplicated>();
+
+    // Thread duplication is only meant for host backends.
+    if constexpr ( Kokkos::SpaceAccessibility<Kokkos::HostSpace,
+                                              TEST_MEMSPACE>::accessible )
+        testNeighborScatter<Cabana::VerletLayout2D, Cabana::SerialOpTag,
+                            Kokkos::Experimental::ScatterDuplicated>();
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, filter_neighbor_list_test )
+{
+#ifndef KOKKOS_ENABLE_OPENMPTARGET // FIXME_OPENMPTARGET
+    testFilterNeighborList<Cabana::VerletLayoutCSR>();
+    testFilterNeighborList<Cabana::VerletLayout2D>();
+    testFilterNeighborList<Cabana::VerletLayoutAoSoA>();
+#endif
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, pair_data_test )
+{
+#ifndef KOKKOS_ENABLE_OPENMPTARGET // FIXME_OPENMPTARGET
+    testPairData<Cabana::VerletLayoutCSR, Cabana::SerialOpTag>();
+    testPairData<Cabana::VerletLayoutCSR, Cabana::TeamOpTag>();
+#endif
+    testPairData<Cabana::VerletLayout2D, Cabana::SerialOpTag>();
+    testPairData<Cabana::VerletLayout2D, Cabana::TeamOpTag>();
+    testPairData<Cabana::VerletLayoutAoSoA, Cabana::SerialOpTag>();
+}
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
@@ -175,6 +175,25 @@ void testArborXListFullPartialRange()
     }
 }
 
+//---------------------------------------------------------------------------//
+void testArborXFilterList()
+{
+    // Create the AoSoA and fill with random particle positions.
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+
+    // Derive an inner list from the outer list and compare to brute force.
+    auto const outer = Cabana::Experimental::makeNeighborList(
+        Cabana::FullNeighborTag{}, position, 0, position.size(),
+        test_data.test_radius );
+    double inner_radius = 0.6 * test_data.test_radius;
+    auto const inner = Cabana::Experimental::filterNeighborList(
+        TEST_EXECSPACE{}, outer, position, inner_radius );
+    auto N2_list_copy = createTestListHostCopy(
+        computeFullNeighborList( position, inner_radius ) );
+    checkFullNeighborList( inner, N2_list_copy, test_data.num_particle );
+}
+
 //---------------------------------------------------------------------------//
 void testNeighborArborXParallelFor()
 {
@@ -301,6 +320,9 @@ TEST( TEST_CATEGORY, verlet_list_full_range_test )
     testArborXListFullPartialRange();
 }
 
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, filter_list_test ) { testArborXFilterList(); }
+
 //---------------------------------------------------------------------------//
 TEST( TEST_CATEGORY, parallel_for_test ) { testNeighborArborXParallelFor(); }
 
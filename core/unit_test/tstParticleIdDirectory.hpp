@@ -0,0 +1,106 @@
+/****************************************************************************
+ * Copyright (c) 2018-2023 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
+#include <Cabana_Distributor.hpp>
+#include <Cabana_ParticleIdDirectory.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+// Query the owner of every global id and compare to the expected owner.
+template <class DirectoryType, class OwnerFunc>
+void checkOwners( const DirectoryType& directory, const int num_global,
+                  const OwnerFunc& expected_owner )
+{
+    Kokkos::View<long*, TEST_MEMSPACE> query( "query", num_global );
+    Kokkos::parallel_for(
+        "fill_query", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_global ),
+        KOKKOS_LAMBDA( const int i ) { query( i ) = i; } );
+    Kokkos::fence();
+    auto owners = directory.owner( TEST_EXECSPACE(), query );
+    auto owners_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), owners );
+    for ( int i = 0; i < num_global; ++i )
+        EXPECT_EQ( owners_host( i ), expected_owner( i ) );
+}
+
+//---------------------------------------------------------------------------//
+void testParticleIdDirectory()
+{
+    int comm_rank;
+    int comm_size;
+    MPI_Comm_rank( MPI_COMM_WORLD, &comm_rank );
+    MPI_Comm_size( MPI_COMM_WORLD, &comm_size );
+
+    // Create particles with contiguous global ids on each rank.
+    int num_local = 100;
+    int num_global = num_local * comm_size;
+    using data_types = Cabana::MemberTypes<long>;
+    Cabana::AoSoA<data_types, TEST_MEMSPACE> particles( "particles",
+                                                        num_local );
+    auto ids = Cabana::slice<0>( particles );
+    Kokkos::parallel_for(
+        "fill_ids", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_local ),
+        KOKKOS_LAMBDA( const int p ) {
+            ids( p ) = comm_rank * num_local + p;
+        } );
+    Kokkos::fence();
+
+    // Build the directory and find every id.
+    Cabana::ParticleIdDirectory<TEST_MEMSPACE> directory( MPI_COMM_WORLD );
+    directory.build( TEST_EXECSPACE(), ids, num_local );
+    checkOwners( directory, num_global,
+                 [=]( const int i ) { return i / num_local; } );
+
+    // Send every particle to the next rank and register only the imports.
+    int next_rank = ( comm_rank + 1 ) % comm_size;
+    Kokkos::View<int*, TEST_MEMSPACE> export_ranks( "export_ranks",
+                                                    num_local );
+    Kokkos::deep_copy( export_ranks, next_rank );
+    Cabana::Distributor<TEST_MEMSPACE> distributor( MPI_COMM_WORLD,
+                                                    export_ranks );
+    Cabana::migrate( distributor, particles );
+    std::size_t num_stay = ( next_rank == comm_rank ) ? num_local : 0;
+    ids = Cabana::slice<0>( particles );
+    directory.update( TEST_EXECSPACE(), ids, num_stay, particles.size() );
+    checkOwners( directory, num_global, [=]( const int i )
+                 { return ( i / num_local + 1 ) % comm_size; } );
+
+    // Unregister the first half of the local particles.
+    directory.setOwner( TEST_EXECSPACE(), ids, 0, num_local / 2, -1 );
+    checkOwners( directory, num_global,
+                 [=]( const int i )
+                 {
+                     return ( i % num_local < num_local / 2 )
+                                ? -1
+                                : ( i / num_local + 1 ) % comm_size;
+                 } );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, particle_id_directory_test )
+{
+    testParticleIdDirectory();
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
@@ -0,0 +1,118 @@
+/****************************************************************************
+ * Copyright (c) 2018-2023 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
+#include <Cabana_LinkedCellList.hpp>
+#include <Cabana_ParticleIdIndex.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+// Look up the ids 0 to num_id - 1 and check the local index of each.
+template <class IndexType, class IdHostSlice>
+void checkIdIndex( const IndexType& index, const IdHostSlice& ids_host,
+                   const int num_id )
+{
+    Kokkos::View<int*, TEST_MEMSPACE> local( "local", num_id );
+    Kokkos::parallel_for(
+        "find", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_id ),
+        KOKKOS_LAMBDA( const int id ) { local( id ) = index.find( id ); } );
+    Kokkos::fence();
+    auto local_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), local );
+
+    std::vector<int> expected( num_id, -1 );
+    for ( std::size_t p = 0; p < ids_host.size(); ++p )
+        expected[ids_host( p )] = p;
+    for ( int id = 0; id < num_id; ++id )
+        EXPECT_EQ( local_host( id ), expected[id] );
+}
+
+//---------------------------------------------------------------------------//
+void testParticleIdIndex()
+{
+    // Create particles with ids in reverse order.
+    int num_p = 1000;
+    using data_types = Cabana::MemberTypes<double[3], long>;
+    Cabana::AoSoA<data_types, Kokkos::HostSpace> aosoa_host( "aosoa", num_p );
+    auto x_host = Cabana::slice<0>( aosoa_host );
+    auto id_host = Cabana::slice<1>( aosoa_host );
+    for ( int p = 0; p < num_p; ++p )
+    {
+        for ( int d = 0; d < 3; ++d )
+            x_host( p, d ) = ( ( p * 7 + d * 13 ) % 97 ) / 97.0;
+        id_host( p ) = num_p - 1 - p;
+    }
+    auto aosoa =
+        Cabana::create_mirror_view_and_copy( TEST_MEMSPACE(), aosoa_host );
+    auto x = Cabana::slice<0>( aosoa );
+    auto ids = Cabana::slice<1>( aosoa );
+
+    // Build the index.
+    Cabana::ParticleIdIndex<TEST_MEMSPACE> index;
+    index.build( TEST_EXECSPACE(), ids, num_p );
+    EXPECT_EQ( index.size(), static_cast<std::size_t>( num_p ) );
+    checkIdIndex( index, id_host, num_p );
+
+    // Permute the particles together with the index.
+    double grid_delta[3] = { 0.1, 0.1, 0.1 };
+    double grid_min[3] = { 0.0, 0.0, 0.0 };
+    double grid_max[3] = { 1.0, 1.0, 1.0 };
+    Cabana::LinkedCellList<TEST_MEMSPACE> cell_list( x, grid_delta, grid_min,
+                                                     grid_max );
+    Cabana::permute( TEST_EXECSPACE(), cell_list.binningData(), aosoa,
+                     index );
+    EXPECT_EQ( index.size(), static_cast<std::size_t>( num_p ) );
+    Cabana::deep_copy( aosoa_host, aosoa );
+    checkIdIndex( index, id_host, num_p );
+
+    // Remove the first 100 particles by moving the last 100 into the gap and
+    // update only the moved range.
+    int num_remove = 100;
+    for ( int p = 0; p < num_remove; ++p )
+        aosoa_host.setTuple( p, aosoa_host.getTuple( num_p - num_remove + p ) );
+    aosoa_host.resize( num_p - num_remove );
+    aosoa.resize( num_p - num_remove );
+    Cabana::deep_copy( aosoa, aosoa_host );
+    ids = Cabana::slice<1>( aosoa );
+    id_host = Cabana::slice<1>( aosoa_host );
+    index.update( TEST_EXECSPACE(), ids, 0, num_remove, num_p - num_remove );
+    checkIdIndex( index, id_host, num_p );
+
+    // Append new particles and insert them.
+    int num_add = 50;
+    aosoa_host.resize( num_p - num_remove + num_add );
+    id_host = Cabana::slice<1>( aosoa_host );
+    for ( int p = 0; p < num_add; ++p )
+        id_host( num_p - num_remove + p ) = num_p + p;
+    aosoa.resize( aosoa_host.size() );
+    Cabana::deep_copy( aosoa, aosoa_host );
+    ids = Cabana::slice<1>( aosoa );
+    index.insert( TEST_EXECSPACE(), ids, num_p - num_remove,
+                  num_p - num_remove + num_add );
+    checkIdIndex( index, id_host, num_p + num_add );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, particle_id_index_test ) { testParticleIdIndex(); }
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
@@ -0,0 +1,160 @@
+/****************************************************************************
+ * Copyright (c) 2018-2023 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
+#include <Cabana_Distributor.hpp>
+#include <Cabana_Halo.hpp>
+#include <Cabana_LinkedCellList.hpp>
+#include <Cabana_ParticleIdDirectory.hpp>
+#include <Cabana_ParticleIdIndex.hpp>
+#include <Cabana_ParticleTopology.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+// Check that every resolved member points to the particle with its id and
+// count the unresolved members.
+template <class TopologyType, class ParticleAoSoA>
+int checkTopology( const TopologyType& topology,
+                   const ParticleAoSoA& particles )
+{
+    auto entries = Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                        topology.entries() );
+    auto m_id = Cabana::slice<0>( entries );
+    auto m_local = Cabana::slice<1>( entries );
+    auto particles_host =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), particles );
+    auto p_id = Cabana::slice<0>( particles_host );
+
+    int num_unresolved = 0;
+    for ( std::size_t e = 0; e < topology.size(); ++e )
+        for ( int m = 0; m < TopologyType::num_member; ++m )
+        {
+            if ( m_local( e, m ) < 0 )
+                ++num_unresolved;
+            else
+                EXPECT_EQ( p_id( m_local( e, m ) ), m_id( e, m ) );
+        }
+    return num_unresolved;
+}
+
+//---------------------------------------------------------------------------//
+void testParticleTopology()
+{
+    int comm_rank;
+    int comm_size;
+    MPI_Comm_rank( MPI_COMM_WORLD, &comm_rank );
+    MPI_Comm_size( MPI_COMM_WORLD, &comm_size );
+
+    // Create a chain of particles along x with contiguous ids on each rank,
+    // stored in reverse order.
+    int num_local = 20;
+    int num_global = num_local * comm_size;
+    using data_types = Cabana::MemberTypes<long, double[3]>;
+    Cabana::AoSoA<data_types, TEST_MEMSPACE> particles( "particles",
+                                                        num_local );
+    auto ids = Cabana::slice<0>( particles );
+    auto x = Cabana::slice<1>( particles );
+    Kokkos::parallel_for(
+        "fill", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_local ),
+        KOKKOS_LAMBDA( const int p ) {
+            ids( p ) = comm_rank * num_local + num_local - 1 - p;
+            x( p, 0 ) = ids( p ) + 0.5;
+            x( p, 1 ) = 0.5;
+            x( p, 2 ) = 0.5;
+        } );
+    Kokkos::fence();
+
+    Cabana::ParticleIdIndex<TEST_MEMSPACE> index;
+    index.build( TEST_EXECSPACE(), ids, num_local );
+    Cabana::ParticleIdDirectory<TEST_MEMSPACE> directory( MPI_COMM_WORLD );
+    directory.build( TEST_EXECSPACE(), ids, num_local );
+
+    // Bond each particle to the next one in the chain.
+    int num_bond = ( comm_rank == comm_size - 1 ) ? num_local - 1 : num_local;
+    Cabana::ParticleTopology<TEST_MEMSPACE, 2> bonds( "bonds", num_bond );
+    auto bond_ids = bonds.memberIds();
+    Kokkos::parallel_for(
+        "fill_bonds", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_bond ),
+        KOKKOS_LAMBDA( const int b ) {
+            bond_ids( b, 0 ) = comm_rank * num_local + b;
+            bond_ids( b, 1 ) = comm_rank * num_local + b + 1;
+        } );
+    Kokkos::fence();
+    bonds.resolve( TEST_EXECSPACE(), index );
+    EXPECT_EQ( checkTopology( bonds, particles ),
+               ( comm_rank == comm_size - 1 ) ? 0 : 1 );
+
+    // Sort the particles along x and remap the bonds.
+    double grid_delta[3] = { 1.0, 1.0, 1.0 };
+    double grid_min[3] = { 0.0, 0.0, 0.0 };
+    double grid_max[3] = { 1.0 * num_global, 1.0, 1.0 };
+    Cabana::LinkedCellList<TEST_MEMSPACE> cell_list( x, grid_delta, grid_min,
+                                                     grid_max );
+    Cabana::permute( TEST_EXECSPACE(), cell_list.binningData(), particles,
+                     index );
+    bonds.permute( TEST_EXECSPACE(), cell_list );
+    EXPECT_EQ( checkTopology( bonds, particles ),
+               ( comm_rank == comm_size - 1 ) ? 0 : 1 );
+
+    // Send every particle and its bonds to the next rank.
+    int next_rank = ( comm_rank + 1 ) % comm_size;
+    Kokkos::View<int*, TEST_MEMSPACE> export_ranks( "export_ranks",
+                                                    num_local );
+    Kokkos::deep_copy( export_ranks, next_rank );
+    Cabana::Distributor<TEST_MEMSPACE> distributor( MPI_COMM_WORLD,
+                                                    export_ranks );
+    Cabana::migrate<0>( TEST_EXECSPACE(), distributor, particles, index );
+    bonds.migrate( TEST_EXECSPACE(), distributor, export_ranks );
+
+    // The bonds cannot migrate again until they are resolved.
+    EXPECT_THROW(
+        bonds.migrate( TEST_EXECSPACE(), distributor, export_ranks ),
+        std::runtime_error );
+
+    ids = Cabana::slice<0>( particles );
+    if ( next_rank != comm_rank )
+        directory.update( TEST_EXECSPACE(), ids, 0, num_local );
+    bonds.resolve( TEST_EXECSPACE(), index );
+    int prev_rank = ( comm_rank + comm_size - 1 ) % comm_size;
+    int prev_num_bond =
+        ( prev_rank == comm_size - 1 ) ? num_local - 1 : num_local;
+    EXPECT_EQ( bonds.size(), static_cast<std::size_t>( prev_num_bond ) );
+    int num_missing = ( prev_rank == comm_size - 1 ) ? 0 : 1;
+    EXPECT_EQ( checkTopology( bonds, particles ), num_missing );
+
+    // Gather the bonded ghosts and resolve every bond.
+    auto halo = Cabana::createTopologyHalo(
+        TEST_EXECSPACE(), MPI_COMM_WORLD, bonds, directory, index, num_local );
+    EXPECT_EQ( halo.numGhost(), static_cast<std::size_t>( num_missing ) );
+    particles.resize( halo.numLocal() + halo.numGhost() );
+    Cabana::gather( halo, particles );
+    ids = Cabana::slice<0>( particles );
+    index.insert( TEST_EXECSPACE(), ids, num_local, particles.size() );
+    bonds.resolve( TEST_EXECSPACE(), index );
+    EXPECT_EQ( checkTopology( bonds, particles ), 0 );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, particle_topology_test ) { testParticleTopology(); }
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
@@ -0,0 +1,97 @@
+/****************************************************************************
+ * Copyright (c) 2018-2023 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
+#include <Cabana_PartitionedPipeline.hpp>
+#include <Cabana_Sort.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+template <class AoSoA_t>
+void fillSpecies( const TEST_EXECSPACE& exec_space, AoSoA_t& aosoa,
+                  const int s )
+{
+    auto ids = Cabana::slice<0>( aosoa );
+    auto x = Cabana::slice<1>( aosoa );
+    int num_p = aosoa.size();
+    Kokkos::parallel_for(
+        "fill", Kokkos::RangePolicy<TEST_EXECSPACE>( exec_space, 0, num_p ),
+        KOKKOS_LAMBDA( const int p ) {
+            ids( p ) = num_p - p - 1;
+            for ( int d = 0; d < 3; ++d )
+                x( p, d ) = s + num_p - p - 1 + d;
+        } );
+}
+
+//---------------------------------------------------------------------------//
+void testPipeline()
+{
+    // Create species of very different sizes.
+    using DataTypes = Cabana::MemberTypes<int, double[3]>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes, TEST_MEMSPACE>;
+    std::vector<int> sizes = { 3, 1034, 57 };
+    std::vector<AoSoA_t> species;
+    for ( auto n : sizes )
+        species.push_back( AoSoA_t( "species", n ) );
+
+    auto pipeline =
+        Cabana::createPartitionedPipeline( TEST_EXECSPACE(), sizes.size() );
+    EXPECT_EQ( pipeline.numPipeline(), static_cast<int>( sizes.size() ) );
+
+    // Fill every species in reverse order.
+    pipeline.stage( "fill",
+                    [&]( const TEST_EXECSPACE& exec_space, const int s ) {
+                        fillSpecies( exec_space, species[s], s );
+                    } );
+    pipeline.fence();
+
+    // Sort every species on its own instance.
+    std::vector<Cabana::BinningData<TEST_MEMSPACE>> sort_data;
+    for ( auto& aosoa : species )
+        sort_data.push_back( Cabana::sortByKey( Cabana::slice<0>( aosoa ) ) );
+    pipeline.stage( "permute",
+                    [&]( const TEST_EXECSPACE& exec_space, const int s ) {
+                        Cabana::permute( exec_space, sort_data[s], species[s] );
+                    } );
+    pipeline.fence();
+
+    // Check.
+    for ( std::size_t s = 0; s < species.size(); ++s )
+    {
+        auto mirror = Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                           species[s] );
+        auto ids = Cabana::slice<0>( mirror );
+        auto x = Cabana::slice<1>( mirror );
+        for ( int p = 0; p < sizes[s]; ++p )
+        {
+            EXPECT_EQ( ids( p ), p );
+            for ( int d = 0; d < 3; ++d )
+                EXPECT_DOUBLE_EQ( x( p, d ), s + p + d );
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, pipeline_test ) { testPipeline(); }
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
@@ -352,6 +352,23 @@ void testSortBySliceDataOnly()
 
         EXPECT_EQ( bin_permute_mirror( p ), (unsigned)reverse_index );
     }
+
+    // Now permute a single slice on an execution space instance and check
+    // that only that slice was sorted.
+    TEST_EXECSPACE exec_space;
+    Cabana::permute( exec_space, binning_data, v2 );
+    mirror = Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), aosoa );
+    v1_mirror = Cabana::slice<1>( mirror );
+    v2_mirror = Cabana::slice<2>( mirror );
+    for ( std::size_t p = 0; p < aosoa.size(); ++p )
+    {
+        int reverse_index = aosoa.size() - p - 1;
+        EXPECT_EQ( v1_mirror( p ), reverse_index );
+        for ( int i = 0; i < dim_1; ++i )
+            for ( int j = 0; j < dim_2; ++j )
+                EXPECT_EQ( v2_mirror( p, i, j ),
+                           static_cast<int>( p ) + i + j );
+    }
 }
 
 //---------------------------------------------------------------------------//
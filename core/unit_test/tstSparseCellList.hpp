@@ -0,0 +1,145 @@
+/****************************************************************************
+ * Copyright (c) 2018-2023 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
+#include <Cabana_SparseCellList.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+void testSparseCellList()
+{
+    // Create a grid of 1000^3 cells with a few small clusters of particles.
+    double dx = 1.0;
+    double grid_delta[3] = { dx, dx, dx };
+    double grid_min[3] = { 0.0, 0.0, 0.0 };
+    double grid_max[3] = { 1000.0, 1000.0, 1000.0 };
+    int num_cluster = 4;
+    int cluster_size = 5;
+    int num_p = num_cluster * cluster_size * cluster_size * cluster_size;
+
+    using data_types = Cabana::MemberTypes<double[3], int>;
+    Cabana::AoSoA<data_types, Kokkos::HostSpace> aosoa_host( "aosoa", num_p );
+    auto x_host = Cabana::slice<0>( aosoa_host );
+    auto id_host = Cabana::slice<1>( aosoa_host );
+    double centers[4][3] = { { 900.0, 10.0, 500.0 },
+                             { 10.0, 900.0, 10.0 },
+                             { 500.0, 500.0, 500.0 },
+                             { 501.2, 500.0, 500.0 } };
+    int p = 0;
+    for ( int c = num_cluster - 1; c >= 0; --c )
+        for ( int i = 0; i < cluster_size; ++i )
+            for ( int j = 0; j < cluster_size; ++j )
+                for ( int k = 0; k < cluster_size; ++k, ++p )
+                {
+                    x_host( p, 0 ) = centers[c][0] + 0.4 * i;
+                    x_host( p, 1 ) = centers[c][1] + 0.4 * j;
+                    x_host( p, 2 ) = centers[c][2] + 0.4 * k;
+                    id_host( p ) = p;
+                }
+    auto aosoa =
+        Cabana::create_mirror_view_and_copy( TEST_MEMSPACE(), aosoa_host );
+    auto x = Cabana::slice<0>( aosoa );
+
+    Cabana::SparseCellList<TEST_MEMSPACE> cell_list( x, grid_delta, grid_min,
+                                                     grid_max );
+    EXPECT_EQ( cell_list.numBin( 0 ), 1000 );
+    EXPECT_LE( cell_list.numOccupiedBin(), num_p );
+
+    // Count the neighbors within a radius of each particle with the cell
+    // stencil and check the bin lookup of every particle.
+    double radius = 0.9;
+    double rsqr = radius * radius;
+    Kokkos::View<int*, TEST_MEMSPACE> counts( "counts", num_p );
+    Kokkos::View<int*, TEST_MEMSPACE> found( "found", num_p );
+    Kokkos::parallel_for(
+        "count", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_p ),
+        KOKKOS_LAMBDA( const int n ) {
+            int ic = x( n, 0 ) / dx;
+            int jc = x( n, 1 ) / dx;
+            int kc = x( n, 2 ) / dx;
+            int bin = cell_list.findBin( ic, jc, kc );
+            if ( bin >= 0 )
+            {
+                auto offset = cell_list.binOffset( ic, jc, kc );
+                for ( int b = 0; b < cell_list.binSize( ic, jc, kc ); ++b )
+                    if ( static_cast<int>( cell_list.permutation(
+                             offset + b ) ) == n )
+                        found( n ) = 1;
+            }
+            for ( int i = ic - 1; i <= ic + 1; ++i )
+                for ( int j = jc - 1; j <= jc + 1; ++j )
+                    for ( int k = kc - 1; k <= kc + 1; ++k )
+                    {
+                        auto offset = cell_list.binOffset( i, j, k );
+                        for ( int b = 0; b < cell_list.binSize( i, j, k );
+                              ++b )
+                        {
+                            int m = cell_list.permutation( offset + b );
+                            double r2 = 0.0;
+                            for ( int d = 0; d < 3; ++d )
+                                r2 += ( x( n, d ) - x( m, d ) ) *
+                                      ( x( n, d ) - x( m, d ) );
+                            if ( m != n && r2 <= rsqr )
+                                ++counts( n );
+                        }
+                    }
+        } );
+    Kokkos::fence();
+    auto counts_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), counts );
+    auto found_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), found );
+    for ( int n = 0; n < num_p; ++n )
+    {
+        int expected = 0;
+        for ( int m = 0; m < num_p; ++m )
+        {
+            double r2 = 0.0;
+            for ( int d = 0; d < 3; ++d )
+                r2 += ( x_host( n, d ) - x_host( m, d ) ) *
+                      ( x_host( n, d ) - x_host( m, d ) );
+            if ( m != n && r2 <= rsqr )
+                ++expected;
+        }
+        EXPECT_EQ( counts_host( n ), expected );
+        EXPECT_EQ( found_host( n ), 1 );
+    }
+
+    // Permute the particles and check they are ordered by cell key.
+    Cabana::permute( cell_list, aosoa );
+    Cabana::deep_copy( aosoa_host, aosoa );
+    auto key = [&]( const int n )
+    {
+        return ( static_cast<std::uint64_t>( x_host( n, 0 ) ) * 1000 +
+                 static_cast<std::uint64_t>( x_host( n, 1 ) ) ) *
+                   1000 +
+               static_cast<std::uint64_t>( x_host( n, 2 ) );
+    };
+    for ( int n = 1; n < num_p; ++n )
+        EXPECT_LE( key( n - 1 ), key( n ) );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, sparse_cell_list_test ) { testSparseCellList(); }
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
@@ -0,0 +1,133 @@
+/****************************************************************************
+ * Copyright (c) 2018-2023 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
+#include <Cabana_TreeCode.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+// Compare the tree code forces to a direct sum over all ranks.
+void treeCodeTest( const double theta, const double tolerance )
+{
+    int comm_rank;
+    int comm_size;
+    MPI_Comm_rank( MPI_COMM_WORLD, &comm_rank );
+    MPI_Comm_size( MPI_COMM_WORLD, &comm_size );
+
+    // Create particles in a slab owned by this rank. Use positive charges so
+    // the relative error of the field is well defined.
+    int num_local = 300;
+    using member_types = Cabana::MemberTypes<double[3], double, double[3]>;
+    Cabana::AoSoA<member_types, Kokkos::HostSpace> particles_host( "particles",
+                                                                   num_local );
+    auto x_host = Cabana::slice<0>( particles_host );
+    auto q_host = Cabana::slice<1>( particles_host );
+    auto f_host = Cabana::slice<2>( particles_host );
+    std::mt19937 gen( 1938 + comm_rank );
+    std::uniform_real_distribution<double> position( 0.0, 1.0 );
+    std::uniform_real_distribution<double> charge( 0.5, 1.5 );
+    for ( int p = 0; p < num_local; ++p )
+    {
+        x_host( p, 0 ) = comm_rank + position( gen );
+        for ( int d = 1; d < 3; ++d )
+            x_host( p, d ) = position( gen );
+        for ( int d = 0; d < 3; ++d )
+            f_host( p, d ) = 0.0;
+        q_host( p ) = charge( gen );
+    }
+    auto particles = Cabana::create_mirror_view_and_copy( TEST_MEMSPACE(),
+                                                          particles_host );
+
+    // Compute the tree forces.
+    auto x = Cabana::slice<0>( particles );
+    auto q = Cabana::slice<1>( particles );
+    auto f = Cabana::slice<2>( particles );
+    auto tree = Cabana::Experimental::createTreeCode<TEST_MEMSPACE>(
+        MPI_COMM_WORLD, theta, 4 );
+    tree->build( TEST_EXECSPACE(), x, q, num_local );
+    tree->computeForces( TEST_EXECSPACE(), f, 1.0 );
+    Kokkos::fence();
+    EXPECT_GT( tree->numNode(), 1 );
+    if ( comm_size > 1 )
+        EXPECT_GT( tree->numRemote(), 0 );
+
+    // Gather every particle.
+    std::vector<double> local_data( 4 * num_local );
+    for ( int p = 0; p < num_local; ++p )
+    {
+        for ( int d = 0; d < 3; ++d )
+            local_data[4 * p + d] = x_host( p, d );
+        local_data[4 * p + 3] = q_host( p );
+    }
+    std::vector<double> global_data( 4 * num_local * comm_size );
+    MPI_Allgather( local_data.data(), 4 * num_local, MPI_DOUBLE,
+                   global_data.data(), 4 * num_local, MPI_DOUBLE,
+                   MPI_COMM_WORLD );
+    int num_global = num_local * comm_size;
+
+    // Check against the direct sum.
+    Cabana::deep_copy( particles_host, particles );
+    double error_norm = 0.0;
+    double force_norm = 0.0;
+    for ( int p = 0; p < num_local; ++p )
+    {
+        double e[3] = { 0.0, 0.0, 0.0 };
+        for ( int j = 0; j < num_global; ++j )
+        {
+            if ( j == comm_rank * num_local + p )
+                continue;
+            double r[3];
+            double r2 = 0.0;
+            for ( int d = 0; d < 3; ++d )
+            {
+                r[d] = x_host( p, d ) - global_data[4 * j + d];
+                r2 += r[d] * r[d];
+            }
+            double s = global_data[4 * j + 3] / ( r2 * std::sqrt( r2 ) );
+            for ( int d = 0; d < 3; ++d )
+                e[d] += s * r[d];
+        }
+        for ( int d = 0; d < 3; ++d )
+        {
+            double diff = f_host( p, d ) - q_host( p ) * e[d];
+            error_norm += diff * diff;
+            force_norm += q_host( p ) * q_host( p ) * e[d] * e[d];
+        }
+    }
+    EXPECT_LE( std::sqrt( error_norm / force_norm ), tolerance );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, tree_code_direct_test ) { treeCodeTest( 0.0, 1.0e-10 ); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, tree_code_multipole_test )
+{
+    treeCodeTest( 0.5, 1.0e-2 );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test